@@ -58,7 +58,7 @@ namespace WPEFramework
             return realsize;
         }
 
-        DeviceDiagnosticsImplementation::DeviceDiagnosticsImplementation() : _adminLock() , _service(nullptr)
+        DeviceDiagnosticsImplementation::DeviceDiagnosticsImplementation() : _service(nullptr)
         {
             LOGINFO("Create DeviceDiagnosticsImplementation Instance");
 
@@ -101,21 +101,12 @@ namespace WPEFramework
         {
             ASSERT (nullptr != notification);
 
-            _adminLock.Lock();
-
             // Make sure we can't register the same notification callback multiple times
-            if (std::find(_deviceDiagnosticsNotification.begin(), _deviceDiagnosticsNotification.end(), notification) == _deviceDiagnosticsNotification.end())
-            {
-                _deviceDiagnosticsNotification.push_back(notification);
-                notification->AddRef();
-            }
-            else
+            if (!_deviceDiagnosticsNotification.Register(notification))
             {
                 LOGERR("same notification is registered already");
             }
 
-            _adminLock.Unlock();
-
             return Core::ERROR_NONE;
         }
 
@@ -125,14 +116,9 @@ namespace WPEFramework
 
             ASSERT (nullptr != notification);
 
-            _adminLock.Lock();
-
             // we just unregister one notification once
-            auto itr = std::find(_deviceDiagnosticsNotification.begin(), _deviceDiagnosticsNotification.end(), notification);
-            if (itr != _deviceDiagnosticsNotification.end())
+            if (_deviceDiagnosticsNotification.Unregister(notification))
             {
-                (*itr)->Release();
-                _deviceDiagnosticsNotification.erase(itr);
                 status = Core::ERROR_NONE;
             }
             else
@@ -140,8 +126,6 @@ namespace WPEFramework
                 LOGERR("notification not found");
             }
 
-            _adminLock.Unlock();
-
             return status;
         }
 
@@ -152,17 +136,14 @@ namespace WPEFramework
 
         void DeviceDiagnosticsImplementation::Dispatch(Event event, const JsonValue params)
         {
-            _adminLock.Lock();
-        
-            std::list<Exchange::IDeviceDiagnostics::INotification*>::const_iterator index(_deviceDiagnosticsNotification.begin());
-        
             switch(event)
             {
                 case ON_AVDECODER_STATUSCHANGED:
-                    while (index != _deviceDiagnosticsNotification.end()) 
                     {
-                        (*index)->OnAVDecoderStatusChanged(params.String());
-                        ++index;
+                        const string status = params.String();
+                        _deviceDiagnosticsNotification.Notify([&status](Exchange::IDeviceDiagnostics::INotification* notification) {
+                            notification->OnAVDecoderStatusChanged(status);
+                        });
                     }
                     break;
  
@@ -170,7 +151,6 @@ namespace WPEFramework
                     LOGWARN("Event[%u] not handled", event);
                     break;
             }
-            _adminLock.Unlock();
         }
     
         /* retrieves most active decoder status from ERM library,
@@ -37,6 +37,8 @@
 #include <com/com.h>
 #include <core/core.h>
 
+#include "UtilsNotificationRegistry.h"
+
 namespace WPEFramework
 {
     namespace Plugin
@@ -111,9 +113,8 @@ namespace WPEFramework
             Core::hresult GetAVDecoderStatus(AvDecoderStatusResult& AVDecoderStatus) override;
 
         private:
-            mutable Core::CriticalSection _adminLock;
             PluginHost::IShell* _service;
-            std::list<Exchange::IDeviceDiagnostics::INotification*> _deviceDiagnosticsNotification;
+            Utils::NotificationRegistry<Exchange::IDeviceDiagnostics::INotification> _deviceDiagnosticsNotification;
 
 #ifdef ENABLE_ERM
             std::thread m_AVPollThread;
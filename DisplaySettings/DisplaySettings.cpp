@@ -22,6 +22,7 @@
 
 #include "DisplaySettings.h"
 #include <algorithm>
+#include <atomic>
 #include "exception.hpp"
 #include "videoOutputPort.hpp"
 #include "videoOutputPortType.hpp"
@@ -81,8 +82,9 @@ using namespace std;
 static bool isCecEnabled = false;
 static bool isResCacheUpdated = false;
 static std::string currentResolutionCache;
-static bool isDisplayConnectedCacheUpdated = false;
-static bool isHdmiDisplayConnected = false;
+// atomic: isDisplayConnected() is reached from getters that run concurrently (shared api lock)
+static std::atomic<bool> isDisplayConnectedCacheUpdated(false);
+static std::atomic<bool> isHdmiDisplayConnected(false);
 int stbHDRcapabilitiesCache = 0;
 bool isStbHDRcapabilitiesCache = false;
 static int  hdmiArcPortId = -1;
@@ -155,6 +157,8 @@ namespace
 // TODO: remove this
 #define registerMethod(...) for (uint8_t i = 1; GetHandler(i); i++) GetHandler(i)->Register<JsonObject, JsonObject>(__VA_ARGS__)
 #define registerMethodLockedApi(...) for (uint8_t i = 1; GetHandler(i); i++) Utils::Synchro::RegisterLockedApiForHandler(GetHandler(i), __VA_ARGS__)
+// for getters that do not modify plugin state, they run in parallel with each other
+#define registerMethodSharedLockedApi(...) for (uint8_t i = 1; GetHandler(i); i++) Utils::Synchro::RegisterSharedLockedApiForHandler(GetHandler(i), __VA_ARGS__)
 
 namespace WPEFramework {
 
@@ -228,99 +232,102 @@ namespace WPEFramework {
 
             CreateHandler({ 2 });
 
-            registerMethodLockedApi("getConnectedVideoDisplays", &DisplaySettings::getConnectedVideoDisplays, this);
+            registerMethodSharedLockedApi("getConnectedVideoDisplays", &DisplaySettings::getConnectedVideoDisplays, this);
             registerMethodLockedApi("getConnectedAudioPorts", &DisplaySettings::getConnectedAudioPorts, this);
             registerMethodLockedApi("setEnableAudioPort", &DisplaySettings::setEnableAudioPort, this);
-            registerMethodLockedApi("getEnableAudioPort", &DisplaySettings::getEnableAudioPort, this);
-            registerMethodLockedApi("getSupportedResolutions", &DisplaySettings::getSupportedResolutions, this);
-            registerMethodLockedApi("getSupportedVideoDisplays", &DisplaySettings::getSupportedVideoDisplays, this);
-            registerMethodLockedApi("getSupportedTvResolutions", &DisplaySettings::getSupportedTvResolutions, this);
-            registerMethodLockedApi("getSupportedSettopResolutions", &DisplaySettings::getSupportedSettopResolutions, this);
-            registerMethodLockedApi("getSupportedAudioPorts", &DisplaySettings::getSupportedAudioPorts, this);
-            registerMethodLockedApi("getSupportedAudioModes", &DisplaySettings::getSupportedAudioModes, this);
-            registerMethodLockedApi("getAudioFormat", &DisplaySettings::getAudioFormat, this);
-            registerMethodLockedApi("getZoomSetting", &DisplaySettings::getZoomSetting, this);
+            registerMethodSharedLockedApi("getEnableAudioPort", &DisplaySettings::getEnableAudioPort, this);
+            registerMethodSharedLockedApi("getSupportedResolutions", &DisplaySettings::getSupportedResolutions, this);
+            registerMethodSharedLockedApi("getSupportedVideoDisplays", &DisplaySettings::getSupportedVideoDisplays, this);
+            registerMethodSharedLockedApi("getSupportedTvResolutions", &DisplaySettings::getSupportedTvResolutions, this);
+            registerMethodSharedLockedApi("getSupportedSettopResolutions", &DisplaySettings::getSupportedSettopResolutions, this);
+            registerMethodSharedLockedApi("getSupportedAudioPorts", &DisplaySettings::getSupportedAudioPorts, this);
+            registerMethodSharedLockedApi("getSupportedAudioModes", &DisplaySettings::getSupportedAudioModes, this);
+            registerMethodSharedLockedApi("getAudioFormat", &DisplaySettings::getAudioFormat, this);
+            registerMethodSharedLockedApi("getZoomSetting", &DisplaySettings::getZoomSetting, this);
             registerMethodLockedApi("setZoomSetting", &DisplaySettings::setZoomSetting, this);
             registerMethodLockedApi("getCurrentResolution", &DisplaySettings::getCurrentResolution, this);
             registerMethodLockedApi("setCurrentResolution", &DisplaySettings::setCurrentResolution, this);
-            registerMethodLockedApi("getSoundMode", &DisplaySettings::getSoundMode, this);
+            registerMethodSharedLockedApi("getSoundMode", &DisplaySettings::getSoundMode, this);
             registerMethodLockedApi("setSoundMode", &DisplaySettings::setSoundMode, this);
-            registerMethodLockedApi("readEDID", &DisplaySettings::readEDID, this);
-            registerMethodLockedApi("readHostEDID", &DisplaySettings::readHostEDID, this);
-            registerMethodLockedApi("getActiveInput", &DisplaySettings::getActiveInput, this);
-            registerMethodLockedApi("getTvHDRSupport", &DisplaySettings::getTvHDRSupport, this);
+            registerMethodSharedLockedApi("readEDID", &DisplaySettings::readEDID, this);
+            registerMethodSharedLockedApi("readHostEDID", &DisplaySettings::readHostEDID, this);
+            registerMethodSharedLockedApi("getActiveInput", &DisplaySettings::getActiveInput, this);
+            registerMethodSharedLockedApi("getTvHDRSupport", &DisplaySettings::getTvHDRSupport, this);
             registerMethodLockedApi("getSettopHDRSupport", &DisplaySettings::getSettopHDRSupport, this);
-            registerMethodLockedApi("getCurrentOutputSettings", &DisplaySettings::getCurrentOutputSettings, this);
+            registerMethodSharedLockedApi("getCurrentOutputSettings", &DisplaySettings::getCurrentOutputSettings, this);
 
-            Utils::Synchro::RegisterLockedApi("getVolumeLeveller", &DisplaySettings::getVolumeLeveller, this);
-            registerMethodLockedApi("getBassEnhancer", &DisplaySettings::getBassEnhancer, this);
-            registerMethodLockedApi("isSurroundDecoderEnabled", &DisplaySettings::isSurroundDecoderEnabled, this);
-            registerMethodLockedApi("getDRCMode", &DisplaySettings::getDRCMode, this);
-            Utils::Synchro::RegisterLockedApi("getSurroundVirtualizer", &DisplaySettings::getSurroundVirtualizer, this);
+            Utils::Synchro::RegisterSharedLockedApi("getVolumeLeveller", &DisplaySettings::getVolumeLeveller, this);
+            registerMethodSharedLockedApi("getBassEnhancer", &DisplaySettings::getBassEnhancer, this);
+            registerMethodSharedLockedApi("isSurroundDecoderEnabled", &DisplaySettings::isSurroundDecoderEnabled, this);
+            registerMethodSharedLockedApi("getDRCMode", &DisplaySettings::getDRCMode, this);
+            Utils::Synchro::RegisterSharedLockedApi("getSurroundVirtualizer", &DisplaySettings::getSurroundVirtualizer, this);
             Utils::Synchro::RegisterLockedApi("setVolumeLeveller", &DisplaySettings::setVolumeLeveller, this);
             registerMethodLockedApi("setBassEnhancer", &DisplaySettings::setBassEnhancer, this);
             registerMethodLockedApi("enableSurroundDecoder", &DisplaySettings::enableSurroundDecoder, this);
             Utils::Synchro::RegisterLockedApi("setSurroundVirtualizer", &DisplaySettings::setSurroundVirtualizer, this);
             registerMethodLockedApi("setMISteering", &DisplaySettings::setMISteering, this);
             registerMethodLockedApi("setGain", &DisplaySettings::setGain, this);
-            registerMethodLockedApi("getGain", &DisplaySettings::getGain, this);
+            registerMethodSharedLockedApi("getGain", &DisplaySettings::getGain, this);
             registerMethodLockedApi("setMuted", &DisplaySettings::setMuted, this);
-            registerMethodLockedApi("getMuted", &DisplaySettings::getMuted, this);
+            registerMethodSharedLockedApi("getMuted", &DisplaySettings::getMuted, this);
             registerMethodLockedApi("setVolumeLevel", &DisplaySettings::setVolumeLevel, this);
-            registerMethodLockedApi("getVolumeLevel", &DisplaySettings::getVolumeLevel, this);
+            registerMethodSharedLockedApi("getVolumeLevel", &DisplaySettings::getVolumeLevel, this);
             registerMethodLockedApi("setDRCMode", &DisplaySettings::setDRCMode, this);
-            registerMethodLockedApi("getMISteering", &DisplaySettings::getMISteering, this);
+            registerMethodSharedLockedApi("getMISteering", &DisplaySettings::getMISteering, this);
             registerMethodLockedApi("setMS12AudioCompression", &DisplaySettings::setMS12AudioCompression, this);
-            registerMethodLockedApi("getMS12AudioCompression", &DisplaySettings::getMS12AudioCompression, this);
+            registerMethodSharedLockedApi("getMS12AudioCompression", &DisplaySettings::getMS12AudioCompression, this);
             registerMethodLockedApi("setDolbyVolumeMode", &DisplaySettings::setDolbyVolumeMode, this);
-            registerMethodLockedApi("getDolbyVolumeMode", &DisplaySettings::getDolbyVolumeMode, this);
+            registerMethodSharedLockedApi("getDolbyVolumeMode", &DisplaySettings::getDolbyVolumeMode, this);
             registerMethodLockedApi("setDialogEnhancement", &DisplaySettings::setDialogEnhancement, this);
-            registerMethodLockedApi("getDialogEnhancement", &DisplaySettings::getDialogEnhancement, this);
+            registerMethodSharedLockedApi("getDialogEnhancement", &DisplaySettings::getDialogEnhancement, this);
             registerMethodLockedApi("setIntelligentEqualizerMode", &DisplaySettings::setIntelligentEqualizerMode, this);
-            registerMethodLockedApi("getIntelligentEqualizerMode", &DisplaySettings::getIntelligentEqualizerMode, this);
+            registerMethodSharedLockedApi("getIntelligentEqualizerMode", &DisplaySettings::getIntelligentEqualizerMode, this);
             registerMethodLockedApi("setGraphicEqualizerMode", &DisplaySettings::setGraphicEqualizerMode, this);
-            registerMethodLockedApi("getGraphicEqualizerMode", &DisplaySettings::getGraphicEqualizerMode, this);
+            registerMethodSharedLockedApi("getGraphicEqualizerMode", &DisplaySettings::getGraphicEqualizerMode, this);
             registerMethodLockedApi("setMS12AudioProfile", &DisplaySettings::setMS12AudioProfile, this);
-            registerMethodLockedApi("getMS12AudioProfile", &DisplaySettings::getMS12AudioProfile, this);
-            registerMethodLockedApi("getSupportedMS12AudioProfiles", &DisplaySettings::getSupportedMS12AudioProfiles, this);
+            registerMethodSharedLockedApi("getMS12AudioProfile", &DisplaySettings::getMS12AudioProfile, this);
+            registerMethodSharedLockedApi("getSupportedMS12AudioProfiles", &DisplaySettings::getSupportedMS12AudioProfiles, this);
             registerMethodLockedApi("resetDialogEnhancement", &DisplaySettings::resetDialogEnhancement, this);
             registerMethodLockedApi("resetBassEnhancer", &DisplaySettings::resetBassEnhancer, this);
             registerMethodLockedApi("resetSurroundVirtualizer", &DisplaySettings::resetSurroundVirtualizer, this);
             registerMethodLockedApi("resetVolumeLeveller", &DisplaySettings::resetVolumeLeveller, this);
 
             registerMethodLockedApi("setAssociatedAudioMixing", &DisplaySettings::setAssociatedAudioMixing, this);
-            registerMethodLockedApi("getAssociatedAudioMixing", &DisplaySettings::getAssociatedAudioMixing, this);
+            registerMethodSharedLockedApi("getAssociatedAudioMixing", &DisplaySettings::getAssociatedAudioMixing, this);
             registerMethodLockedApi("setFaderControl", &DisplaySettings::setFaderControl, this);
-            registerMethodLockedApi("getFaderControl", &DisplaySettings::getFaderControl, this);
+            registerMethodSharedLockedApi("getFaderControl", &DisplaySettings::getFaderControl, this);
             registerMethodLockedApi("setPrimaryLanguage", &DisplaySettings::setPrimaryLanguage, this);
-            registerMethodLockedApi("getPrimaryLanguage", &DisplaySettings::getPrimaryLanguage, this);
+            registerMethodSharedLockedApi("getPrimaryLanguage", &DisplaySettings::getPrimaryLanguage, this);
             registerMethodLockedApi("setSecondaryLanguage", &DisplaySettings::setSecondaryLanguage, this);
-            registerMethodLockedApi("getSecondaryLanguage", &DisplaySettings::getSecondaryLanguage, this);
+            registerMethodSharedLockedApi("getSecondaryLanguage", &DisplaySettings::getSecondaryLanguage, this);
 
-            registerMethodLockedApi("getAudioDelay", &DisplaySettings::getAudioDelay, this);
+            registerMethodSharedLockedApi("getAudioDelay", &DisplaySettings::getAudioDelay, this);
             registerMethodLockedApi("setAudioDelay", &DisplaySettings::setAudioDelay, this);
-            registerMethodLockedApi("getSinkAtmosCapability", &DisplaySettings::getSinkAtmosCapability, this);
+            registerMethodSharedLockedApi("getSinkAtmosCapability", &DisplaySettings::getSinkAtmosCapability, this);
             registerMethodLockedApi("setAudioAtmosOutputMode", &DisplaySettings::setAudioAtmosOutputMode, this);
             registerMethodLockedApi("setForceHDRMode", &DisplaySettings::setForceHDRMode, this);
-            registerMethodLockedApi("getTVHDRCapabilities", &DisplaySettings::getTVHDRCapabilities, this);
-            registerMethodLockedApi("isConnectedDeviceRepeater", &DisplaySettings::isConnectedDeviceRepeater, this);
-            registerMethodLockedApi("getDefaultResolution", &DisplaySettings::getDefaultResolution, this);
+            registerMethodSharedLockedApi("getTVHDRCapabilities", &DisplaySettings::getTVHDRCapabilities, this);
+            registerMethodSharedLockedApi("isConnectedDeviceRepeater", &DisplaySettings::isConnectedDeviceRepeater, this);
+            registerMethodSharedLockedApi("getDefaultResolution", &DisplaySettings::getDefaultResolution, this);
             registerMethodLockedApi("setScartParameter", &DisplaySettings::setScartParameter, this);
-            registerMethodLockedApi("getSettopMS12Capabilities", &DisplaySettings::getSettopMS12Capabilities, this);
-            registerMethodLockedApi("getSettopAudioCapabilities", &DisplaySettings::getSettopAudioCapabilities, this);
+            registerMethodSharedLockedApi("getSettopMS12Capabilities", &DisplaySettings::getSettopMS12Capabilities, this);
+            registerMethodSharedLockedApi("getSettopAudioCapabilities", &DisplaySettings::getSettopAudioCapabilities, this);
             registerMethodLockedApi("setMS12ProfileSettingsOverride", &DisplaySettings::setMS12ProfileSettingsOverride,this);
 
-            Utils::Synchro::RegisterLockedApiForHandler(GetHandler(2), "getVolumeLeveller", &DisplaySettings::getVolumeLeveller2, this);
+            Utils::Synchro::RegisterSharedLockedApiForHandler(GetHandler(2), "getVolumeLeveller", &DisplaySettings::getVolumeLeveller2, this);
             Utils::Synchro::RegisterLockedApiForHandler(GetHandler(2), "setVolumeLeveller", &DisplaySettings::setVolumeLeveller2, this);
-            Utils::Synchro::RegisterLockedApiForHandler(GetHandler(2), "getSurroundVirtualizer", &DisplaySettings::getSurroundVirtualizer2, this);
+            Utils::Synchro::RegisterSharedLockedApiForHandler(GetHandler(2), "getSurroundVirtualizer", &DisplaySettings::getSurroundVirtualizer2, this);
             Utils::Synchro::RegisterLockedApiForHandler(GetHandler(2), "setSurroundVirtualizer", &DisplaySettings::setSurroundVirtualizer2, this);
 
-            registerMethodLockedApi("getVideoFormat", &DisplaySettings::getVideoFormat, this);
+            registerMethodSharedLockedApi("getVideoFormat", &DisplaySettings::getVideoFormat, this);
 
             registerMethodLockedApi("setPreferredColorDepth", &DisplaySettings::setPreferredColorDepth, this);
-            registerMethodLockedApi("getPreferredColorDepth", &DisplaySettings::getPreferredColorDepth, this);
-            registerMethodLockedApi("getColorDepthCapabilities", &DisplaySettings::getColorDepthCapabilities, this);
-	    registerMethodLockedApi("getSupportedMS12Config", &DisplaySettings::getSupportedMS12Config, this);
+            registerMethodSharedLockedApi("getPreferredColorDepth", &DisplaySettings::getPreferredColorDepth, this);
+            registerMethodSharedLockedApi("getColorDepthCapabilities", &DisplaySettings::getColorDepthCapabilities, this);
+	    registerMethodSharedLockedApi("getSupportedMS12Config", &DisplaySettings::getSupportedMS12Config, this);
+
+            // getApiLockStats/resetApiLockStats: per-method api lock wait and execution times
+            for (uint8_t i = 1; GetHandler(i); i++) Utils::Synchro::RegisterApiLockStatsForHandler(GetHandler(i), this);
            
 
 	    m_subscribed = false; //HdmiCecSink event subscription
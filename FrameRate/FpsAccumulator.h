@@ -0,0 +1,315 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#include "FpsHistogram.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+    /**
+     * Lock-free min/max/sum/count/histogram accumulator for FPS samples.
+     *
+     * Producers (UpdateFps callers) record into one of FPS_ACCUMULATOR_SHARDS
+     * per-thread shards of the active epoch bank, each with its own histogram,
+     * so they never contend on a mutex and rarely share a cache line. The single consumer (the report
+     * timer) flips the epoch, waits for in-flight producers to leave the old
+     * bank and then drains it into a Snapshot. Consumers must be serialized
+     * by the caller.
+     *
+     * Samples below the jank threshold are additionally counted as jank frames.
+     */
+    class FpsAccumulator {
+    public:
+        static constexpr uint32_t FPS_ACCUMULATOR_SHARDS = 8;
+
+        struct Snapshot {
+            Snapshot()
+                : total(0)
+                , count(0)
+                , jank(0)
+                , min(INT_MAX)
+                , max(INT_MIN)
+                , histogram()
+            {
+            }
+
+            // Folds another window into this one.
+            void Merge(const Snapshot& other)
+            {
+                total += other.total;
+                count += other.count;
+                jank += other.jank;
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+                histogram.Merge(other.histogram);
+            }
+
+            void Add(int value, int jankThreshold)
+            {
+                total += value;
+                count++;
+                jank += (value < jankThreshold) ? 1 : 0;
+                min = std::min(min, value);
+                max = std::max(max, value);
+                histogram.Add(value);
+            }
+
+            // Lowers the minimum without counting a sample.
+            void Floor(int value)
+            {
+                min = std::min(min, value);
+            }
+
+            int64_t total;
+            uint64_t count;
+            uint64_t jank;
+            int min;
+            int max;
+            FpsHistogram histogram;
+        };
+
+    private:
+        struct Shard {
+            std::atomic<uint32_t> writers;
+            std::atomic<int64_t> total;
+            std::atomic<uint64_t> count;
+            std::atomic<uint64_t> jank;
+            std::atomic<int> min;
+            std::atomic<int> max;
+            // keep every shard on its own cache line
+            char padding[64 - (2 * sizeof(std::atomic<int64_t>)) - (2 * sizeof(std::atomic<uint64_t>))
+                - (2 * sizeof(std::atomic<int>))];
+        };
+        static_assert(sizeof(Shard) == 64, "FpsAccumulator::Shard must fill one cache line");
+
+        // producers at a steady frame rate all hit the same bucket, so every shard counts into its own
+        struct ShardHistogram {
+            std::atomic<uint64_t> counts[FpsHistogram::FPS_HISTOGRAM_BUCKETS];
+        };
+        static_assert((sizeof(ShardHistogram) % 64) == 0, "FpsAccumulator::ShardHistogram must fill whole cache lines");
+
+    public:
+        FpsAccumulator(int jankThreshold)
+            : _epoch(0)
+            , _jankThreshold(jankThreshold)
+        {
+            for (uint32_t bank = 0; bank < 2; bank++) {
+                for (uint32_t index = 0; index < FPS_ACCUMULATOR_SHARDS; index++) {
+                    _banks[bank][index].writers = 0;
+                    Clear(_banks[bank][index]);
+                    for (uint32_t bucket = 0; bucket < FpsHistogram::FPS_HISTOGRAM_BUCKETS; bucket++) {
+                        _histograms[bank][index].counts[bucket] = 0;
+                    }
+                }
+            }
+        }
+
+        FpsAccumulator(const FpsAccumulator&) = delete;
+        FpsAccumulator& operator=(const FpsAccumulator&) = delete;
+
+        // Producer side, safe to call from any number of threads.
+        void Add(int value)
+        {
+            uint32_t bank = 0;
+            uint32_t index = 0;
+            Shard& shard = Enter(bank, index);
+            shard.total.fetch_add(value, std::memory_order_relaxed);
+            shard.count.fetch_add(1, std::memory_order_relaxed);
+            if (value < _jankThreshold.load(std::memory_order_relaxed)) {
+                shard.jank.fetch_add(1, std::memory_order_relaxed);
+            }
+            StoreMin(shard.min, value);
+            StoreMax(shard.max, value);
+            _histograms[bank][index].counts[FpsHistogram::Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            shard.writers.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Producer side: records `count` samples with a single epoch entry, the
+        // window totals are identical to calling Add() for every sample.
+        template <typename SAMPLE, typename PROJECTION>
+        void Add(const SAMPLE samples[], uint32_t count, PROJECTION valueOf)
+        {
+            if (count == 0) {
+                return;
+            }
+
+            const int jankThreshold = _jankThreshold.load(std::memory_order_relaxed);
+            int64_t total = 0;
+            uint64_t jank = 0;
+            int min = INT_MAX;
+            int max = INT_MIN;
+            uint32_t bank = 0;
+            uint32_t shardIndex = 0;
+            Shard& shard = Enter(bank, shardIndex);
+            std::atomic<uint64_t>* histogram = _histograms[bank][shardIndex].counts;
+            // a batch at a steady frame rate is mostly one bucket, publish each run once
+            uint32_t runBucket = FpsHistogram::FPS_HISTOGRAM_BUCKETS;
+            uint64_t runLength = 0;
+
+            for (uint32_t index = 0; index < count; index++) {
+                const int value = valueOf(samples[index]);
+                total += value;
+                jank += (value < jankThreshold) ? 1 : 0;
+                min = std::min(min, value);
+                max = std::max(max, value);
+                const uint32_t bucket = FpsHistogram::Bucket(value);
+                if (bucket != runBucket) {
+                    if (runLength != 0) {
+                        histogram[runBucket].fetch_add(runLength, std::memory_order_relaxed);
+                    }
+                    runBucket = bucket;
+                    runLength = 0;
+                }
+                runLength++;
+            }
+            histogram[runBucket].fetch_add(runLength, std::memory_order_relaxed);
+
+            shard.total.fetch_add(total, std::memory_order_relaxed);
+            shard.count.fetch_add(count, std::memory_order_relaxed);
+            if (jank != 0) {
+                shard.jank.fetch_add(jank, std::memory_order_relaxed);
+            }
+            StoreMin(shard.min, min);
+            StoreMax(shard.max, max);
+            shard.writers.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Lowers the minimum of the current window without counting a sample.
+        void Floor(int value)
+        {
+            uint32_t bank = 0;
+            uint32_t index = 0;
+            Shard& shard = Enter(bank, index);
+            StoreMin(shard.min, value);
+            shard.writers.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Consumer side: closes the current window and returns its totals.
+        Snapshot Swap()
+        {
+            const uint32_t epoch = _epoch.fetch_add(1);
+            Shard* bank = _banks[epoch & 1];
+            ShardHistogram* histograms = _histograms[epoch & 1];
+            Snapshot result;
+
+            for (uint32_t index = 0; index < FPS_ACCUMULATOR_SHARDS; index++) {
+                Shard& shard = bank[index];
+                while (shard.writers.load() != 0) {
+                    std::this_thread::yield();
+                }
+                result.total += shard.total.load(std::memory_order_relaxed);
+                result.count += shard.count.load(std::memory_order_relaxed);
+                result.jank += shard.jank.load(std::memory_order_relaxed);
+                result.min = std::min(result.min, shard.min.load(std::memory_order_relaxed));
+                result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+                Clear(shard);
+            }
+            for (uint32_t bucket = 0; bucket < FpsHistogram::FPS_HISTOGRAM_BUCKETS; bucket++) {
+                uint64_t count = 0;
+                for (uint32_t index = 0; index < FPS_ACCUMULATOR_SHARDS; index++) {
+                    count += histograms[index].counts[bucket].exchange(0, std::memory_order_relaxed);
+                }
+                if (count != 0) {
+                    result.histogram.AddToBucket(bucket, count);
+                }
+            }
+            return result;
+        }
+
+        // Consumer side: drops whatever has been collected so far.
+        void Reset()
+        {
+            Swap();
+        }
+
+        // Samples strictly below this FPS value are counted as jank frames.
+        void JankThreshold(int value)
+        {
+            _jankThreshold.store(value, std::memory_order_relaxed);
+        }
+
+        int JankThreshold() const
+        {
+            return _jankThreshold.load(std::memory_order_relaxed);
+        }
+
+    private:
+        Shard& Enter(uint32_t& bank, uint32_t& index)
+        {
+            index = ShardIndex();
+            while (true) {
+                const uint32_t epoch = _epoch.load();
+                Shard& shard = _banks[epoch & 1][index];
+                shard.writers.fetch_add(1);
+                // the consumer may have flipped the epoch in between, retry on the new bank
+                if (_epoch.load() == epoch) {
+                    bank = epoch & 1;
+                    return shard;
+                }
+                shard.writers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        static uint32_t ShardIndex()
+        {
+            static std::atomic<uint32_t> nextIndex(0);
+            static thread_local uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % FPS_ACCUMULATOR_SHARDS;
+            return index;
+        }
+
+        static void Clear(Shard& shard)
+        {
+            shard.total.store(0, std::memory_order_relaxed);
+            shard.count.store(0, std::memory_order_relaxed);
+            shard.jank.store(0, std::memory_order_relaxed);
+            shard.min.store(INT_MAX, std::memory_order_relaxed);
+            shard.max.store(INT_MIN, std::memory_order_relaxed);
+        }
+
+        static void StoreMin(std::atomic<int>& target, int value)
+        {
+            int current = target.load(std::memory_order_relaxed);
+            while ((value < current) && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        static void StoreMax(std::atomic<int>& target, int value)
+        {
+            int current = target.load(std::memory_order_relaxed);
+            while ((value > current) && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+    private:
+        std::atomic<uint32_t> _epoch;
+        std::atomic<int> _jankThreshold;
+        Shard _banks[2][FPS_ACCUMULATOR_SHARDS];
+        ShardHistogram _histograms[2][FPS_ACCUMULATOR_SHARDS];
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
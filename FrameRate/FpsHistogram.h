@@ -0,0 +1,135 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    /**
+     * Fixed-memory histogram of FPS samples.
+     *
+     * Values below FPS_HISTOGRAM_LINEAR_BUCKETS get an exact bucket each, larger
+     * values are bucketed per power of two with FPS_HISTOGRAM_SUB_BUCKETS
+     * sub-buckets (12.5% resolution). Add() is O(1), Percentile() is
+     * O(FPS_HISTOGRAM_BUCKETS).
+     */
+    class FpsHistogram {
+    public:
+        static constexpr uint32_t FPS_HISTOGRAM_LINEAR_BUCKETS = 128;
+        static constexpr uint32_t FPS_HISTOGRAM_SUB_BUCKETS = 8;
+        // 128 (2^7) .. INT_MAX (2^31 - 1) spans 24 octaves
+        static constexpr uint32_t FPS_HISTOGRAM_BUCKETS = FPS_HISTOGRAM_LINEAR_BUCKETS + (24 * FPS_HISTOGRAM_SUB_BUCKETS);
+
+        FpsHistogram()
+        {
+            Clear();
+        }
+
+        void Clear()
+        {
+            ::memset(_counts, 0, sizeof(_counts));
+            _total = 0;
+        }
+
+        void Add(int value)
+        {
+            AddToBucket(Bucket(value), 1);
+        }
+
+        void AddToBucket(uint32_t bucket, uint64_t count)
+        {
+            _counts[bucket] += count;
+            _total += count;
+        }
+
+        void Merge(const FpsHistogram& other)
+        {
+            for (uint32_t index = 0; index < FPS_HISTOGRAM_BUCKETS; index++) {
+                _counts[index] += other._counts[index];
+            }
+            _total += other._total;
+        }
+
+        uint64_t Count() const
+        {
+            return _total;
+        }
+
+        /**
+         * @brief Returns the value below or at which `percent` of the samples fall,
+         *        rounded down to the lower bound of its bucket.
+         * @param percent - Percentile in the range [0, 100].
+         * @return The percentile value, -1 if the histogram is empty.
+         */
+        int Percentile(double percent) const
+        {
+            if (_total == 0) {
+                return -1;
+            }
+
+            uint64_t rank = static_cast<uint64_t>(std::ceil((percent / 100.0) * static_cast<double>(_total)));
+            if (rank < 1) {
+                rank = 1;
+            } else if (rank > _total) {
+                rank = _total;
+            }
+
+            uint64_t cumulative = 0;
+            for (uint32_t index = 0; index < FPS_HISTOGRAM_BUCKETS; index++) {
+                cumulative += _counts[index];
+                if (cumulative >= rank) {
+                    return LowerBound(index);
+                }
+            }
+            return LowerBound(FPS_HISTOGRAM_BUCKETS - 1);
+        }
+
+        static uint32_t Bucket(int value)
+        {
+            if (value < static_cast<int>(FPS_HISTOGRAM_LINEAR_BUCKETS)) {
+                return (value < 0) ? 0 : static_cast<uint32_t>(value);
+            }
+            const uint32_t msb = 31 - __builtin_clz(static_cast<uint32_t>(value));
+            const uint32_t octave = msb - 7;
+            const uint32_t sub = (static_cast<uint32_t>(value) >> (msb - 3)) & (FPS_HISTOGRAM_SUB_BUCKETS - 1);
+            return FPS_HISTOGRAM_LINEAR_BUCKETS + (octave * FPS_HISTOGRAM_SUB_BUCKETS) + sub;
+        }
+
+        static int LowerBound(uint32_t bucket)
+        {
+            if (bucket < FPS_HISTOGRAM_LINEAR_BUCKETS) {
+                return static_cast<int>(bucket);
+            }
+            const uint32_t octave = (bucket - FPS_HISTOGRAM_LINEAR_BUCKETS) / FPS_HISTOGRAM_SUB_BUCKETS;
+            const uint32_t sub = (bucket - FPS_HISTOGRAM_LINEAR_BUCKETS) % FPS_HISTOGRAM_SUB_BUCKETS;
+            return static_cast<int>((FPS_HISTOGRAM_SUB_BUCKETS + sub) << (octave + 4));
+        }
+
+    private:
+        uint64_t _counts[FPS_HISTOGRAM_BUCKETS];
+        uint64_t _total;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
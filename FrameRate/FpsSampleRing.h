@@ -0,0 +1,244 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    /**
+     * Single-producer/single-consumer ring of frame-present timestamps in POSIX
+     * shared memory (/dev/shm/<name>).
+     *
+     * FrameRateImplementation creates the ring and is its only consumer, the
+     * compositor opens it and is its only producer. Neither side takes a lock
+     * or makes a system call per sample; when the ring is full the sample is
+     * dropped and counted. The layout is versioned so a producer built against
+     * a different layout refuses to attach.
+     */
+    class FpsSampleRing {
+    public:
+        static constexpr uint32_t FPS_SAMPLE_RING_MAGIC = 0x52535046; // "FPSR"
+        static constexpr uint32_t FPS_SAMPLE_RING_VERSION = 1;
+        static constexpr uint32_t FPS_SAMPLE_RING_MAX_CAPACITY = (1 << 20);
+
+    private:
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t capacity;
+            uint32_t reserved;
+            char padding0[64 - (4 * sizeof(uint32_t))];
+            std::atomic<uint64_t> head; // written by the producer only
+            char padding1[64 - sizeof(std::atomic<uint64_t>)];
+            std::atomic<uint64_t> tail; // written by the consumer only
+            char padding2[64 - sizeof(std::atomic<uint64_t>)];
+            std::atomic<uint64_t> dropped;
+            char padding3[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+    public:
+        FpsSampleRing()
+            : _name()
+            , _header(nullptr)
+            , _slots(nullptr)
+            , _mask(0)
+            , _size(0)
+            , _owner(false)
+        {
+        }
+        ~FpsSampleRing()
+        {
+            Close();
+        }
+
+        FpsSampleRing(const FpsSampleRing&) = delete;
+        FpsSampleRing& operator=(const FpsSampleRing&) = delete;
+
+        /**
+         * @brief Consumer side: creates (or recreates) the ring, it is unlinked again on Close().
+         * @param name - Shared memory object name, e.g. "/framerate-samples".
+         * @param capacity - Number of slots, rounded up to a power of two.
+         * @return true on success.
+         */
+        bool Create(const std::string& name, uint32_t capacity)
+        {
+            Close();
+            if ((capacity == 0) || (capacity > FPS_SAMPLE_RING_MAX_CAPACITY)) {
+                return false;
+            }
+            uint32_t slots = 1;
+            while (slots < capacity) {
+                slots <<= 1;
+            }
+
+            // a stale object from a previous run would carry stale indexes
+            ::shm_unlink(name.c_str());
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+            if (fd < 0) {
+                return false;
+            }
+            const size_t size = sizeof(Header) + (slots * sizeof(uint64_t));
+            bool result = (::ftruncate(fd, size) == 0) && Map(fd, size);
+            ::close(fd);
+
+            if (result == true) {
+                _name = name;
+                _owner = true;
+                _header->capacity = slots;
+                _header->version = FPS_SAMPLE_RING_VERSION;
+                _header->head.store(0, std::memory_order_relaxed);
+                _header->tail.store(0, std::memory_order_relaxed);
+                _header->dropped.store(0, std::memory_order_relaxed);
+                _mask = slots - 1;
+                std::atomic_thread_fence(std::memory_order_release);
+                _header->magic = FPS_SAMPLE_RING_MAGIC;
+            } else {
+                ::shm_unlink(name.c_str());
+            }
+            return result;
+        }
+
+        /**
+         * @brief Producer side: attaches to a ring created by the consumer.
+         * @param name - Shared memory object name used with Create().
+         * @return true on success.
+         */
+        bool Open(const std::string& name)
+        {
+            Close();
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                return false;
+            }
+            struct stat info;
+            bool result = (::fstat(fd, &info) == 0) && (static_cast<size_t>(info.st_size) > sizeof(Header))
+                && Map(fd, static_cast<size_t>(info.st_size));
+            ::close(fd);
+
+            if (result == true) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const uint32_t capacity = _header->capacity;
+                if ((_header->magic != FPS_SAMPLE_RING_MAGIC) || (_header->version != FPS_SAMPLE_RING_VERSION)
+                    || (capacity == 0) || ((capacity & (capacity - 1)) != 0)
+                    || (_size != (sizeof(Header) + (capacity * sizeof(uint64_t))))) {
+                    Close();
+                    result = false;
+                } else {
+                    _name = name;
+                    _mask = capacity - 1;
+                }
+            }
+            return result;
+        }
+
+        void Close()
+        {
+            if (_header != nullptr) {
+                ::munmap(_header, _size);
+                _header = nullptr;
+                _slots = nullptr;
+            }
+            if ((_owner == true) && (_name.empty() == false)) {
+                ::shm_unlink(_name.c_str());
+            }
+            _name.clear();
+            _mask = 0;
+            _size = 0;
+            _owner = false;
+        }
+
+        bool IsOpen() const
+        {
+            return (_header != nullptr);
+        }
+
+        uint32_t Capacity() const
+        {
+            return (_header != nullptr) ? (_mask + 1) : 0;
+        }
+
+        uint64_t Dropped() const
+        {
+            return (_header != nullptr) ? _header->dropped.load(std::memory_order_relaxed) : 0;
+        }
+
+        // Producer side: appends a sample, false (and counted as dropped) if the ring is full.
+        bool Push(uint64_t timestamp)
+        {
+            const uint64_t head = _header->head.load(std::memory_order_relaxed);
+            if ((head - _header->tail.load(std::memory_order_acquire)) > _mask) {
+                _header->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            _slots[head & _mask] = timestamp;
+            _header->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side: moves up to `maximum` samples into buffer, returns how many.
+        uint32_t Pop(uint64_t buffer[], uint32_t maximum)
+        {
+            const uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+            uint64_t available = _header->head.load(std::memory_order_acquire) - tail;
+            // head is written by another process, never trust it for more than one ring
+            if (available > (static_cast<uint64_t>(_mask) + 1)) {
+                available = static_cast<uint64_t>(_mask) + 1;
+            }
+            const uint32_t count = static_cast<uint32_t>((available < maximum) ? available : maximum);
+            for (uint32_t index = 0; index < count; index++) {
+                buffer[index] = _slots[(tail + index) & _mask];
+            }
+            _header->tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        bool Map(int fd, size_t size)
+        {
+            void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (memory == MAP_FAILED) {
+                return false;
+            }
+            _header = static_cast<Header*>(memory);
+            _slots = reinterpret_cast<uint64_t*>(static_cast<char*>(memory) + sizeof(Header));
+            _size = size;
+            return true;
+        }
+
+    private:
+        std::string _name;
+        Header* _header;
+        uint64_t* _slots;
+        uint32_t _mask;
+        size_t _size;
+        bool _owner;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
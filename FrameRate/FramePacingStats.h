@@ -0,0 +1,198 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    /**
+     * Frame-interval (pacing) statistics of one collection window, built from
+     * frame-present timestamps. Not thread safe, the owner serializes access.
+     */
+    class FramePacingStats {
+    public:
+        struct Summary {
+            Summary()
+                : intervals(0)
+                , meanUs(0)
+                , varianceUs2(0)
+                , maxGapUs(0)
+                , over150Percent(0)
+                , over200Percent(0)
+            {
+            }
+
+            uint64_t intervals;
+            uint32_t meanUs;
+            uint64_t varianceUs2;
+            uint32_t maxGapUs;
+            // intervals exceeding 1.5x / 2x the display refresh period
+            uint32_t over150Percent;
+            uint32_t over200Percent;
+        };
+
+        // Raw sums of one or more windows, Merge() combines them exactly.
+        struct Totals {
+            Totals()
+                : intervals(0)
+                , sumUs(0)
+                , sumSquaresUs2(0)
+                , maxGapUs(0)
+                , over150Percent(0)
+                , over200Percent(0)
+            {
+            }
+
+            void Merge(const Totals& other)
+            {
+                intervals += other.intervals;
+                sumUs += other.sumUs;
+                sumSquaresUs2 += other.sumSquaresUs2;
+                maxGapUs = std::max(maxGapUs, other.maxGapUs);
+                over150Percent += other.over150Percent;
+                over200Percent += other.over200Percent;
+            }
+
+            Summary Summarize() const
+            {
+                Summary result;
+                if (intervals > 0) {
+                    const double mean = static_cast<double>(sumUs) / static_cast<double>(intervals);
+                    const double variance = (sumSquaresUs2 / static_cast<double>(intervals)) - (mean * mean);
+                    result.intervals = intervals;
+                    result.meanUs = static_cast<uint32_t>(mean + 0.5);
+                    result.varianceUs2 = (variance > 0) ? static_cast<uint64_t>(variance + 0.5) : 0;
+                    result.maxGapUs = static_cast<uint32_t>(std::min<uint64_t>(maxGapUs, UINT32_MAX));
+                    result.over150Percent = over150Percent;
+                    result.over200Percent = over200Percent;
+                }
+                return result;
+            }
+
+            uint64_t intervals;
+            uint64_t sumUs;
+            double sumSquaresUs2;
+            uint64_t maxGapUs;
+            uint32_t over150Percent;
+            uint32_t over200Percent;
+        };
+
+        FramePacingStats()
+            : _refreshPeriodUs(0)
+            , _previousUs(0)
+            , _totals()
+        {
+        }
+
+        // Display refresh period, 0 if unknown (gap counters stay 0).
+        void RefreshPeriod(uint32_t periodUs)
+        {
+            _refreshPeriodUs = periodUs;
+        }
+
+        uint32_t RefreshPeriod() const
+        {
+            return _refreshPeriodUs;
+        }
+
+        // Starts a new sequence, the next timestamp does not produce an interval.
+        void Restart()
+        {
+            _previousUs = 0;
+            Clear();
+        }
+
+        /**
+         * @brief Records a frame-present timestamp.
+         * @param timestampUs - Monotonic presentation time, must be increasing.
+         * @param intervalUs - Receives the interval to the previous frame.
+         * @return true if an interval was recorded, false for the first frame of a sequence.
+         */
+        bool Add(uint64_t timestampUs, uint64_t& intervalUs)
+        {
+            const uint64_t previousUs = _previousUs;
+            _previousUs = timestampUs;
+            if (previousUs == 0) {
+                return false;
+            }
+
+            intervalUs = timestampUs - previousUs;
+            _totals.intervals++;
+            _totals.sumUs += intervalUs;
+            _totals.sumSquaresUs2 += static_cast<double>(intervalUs) * static_cast<double>(intervalUs);
+            _totals.maxGapUs = std::max(_totals.maxGapUs, intervalUs);
+            if (_refreshPeriodUs != 0) {
+                if ((2 * intervalUs) > (3 * static_cast<uint64_t>(_refreshPeriodUs))) {
+                    _totals.over150Percent++;
+                }
+                if (intervalUs > (2 * static_cast<uint64_t>(_refreshPeriodUs))) {
+                    _totals.over200Percent++;
+                }
+            }
+            return true;
+        }
+
+        uint64_t PreviousTimestamp() const
+        {
+            return _previousUs;
+        }
+
+        // Closes the window, the sequence continues from the last timestamp.
+        Totals Drain()
+        {
+            Totals result(_totals);
+            Clear();
+            return result;
+        }
+
+        /**
+         * @brief Derives the refresh period from a DS display framerate string.
+         * @param framerate - "WIDTHxHEIGHTxFPS", e.g. "1920x1080x60" or "3840x2160px59.94".
+         * @return The refresh period in microseconds, 0 if it cannot be parsed.
+         */
+        static uint32_t PeriodFromFramerate(const std::string& framerate)
+        {
+            const size_t position = framerate.find_last_of("xp");
+            if ((position == std::string::npos) || ((position + 1) >= framerate.size())) {
+                return 0;
+            }
+            const double fps = ::strtod(framerate.c_str() + position + 1, nullptr);
+            return (fps > 0) ? static_cast<uint32_t>((1000000.0 / fps) + 0.5) : 0;
+        }
+
+    private:
+        void Clear()
+        {
+            _totals = Totals();
+        }
+
+    private:
+        uint32_t _refreshPeriodUs;
+        uint64_t _previousUs;
+        Totals _totals;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
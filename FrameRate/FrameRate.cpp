@@ -18,6 +18,8 @@
  **/
 
 #include <exception>
+#include <limits>
+#include <vector>
 #include "FrameRate.h"
 #include "manager.hpp"
 #include "UtilsJsonRpc.h"
@@ -90,10 +92,27 @@ namespace WPEFramework
 
             if (nullptr != _FrameRate)
             {
+                Exchange::IConfiguration* configuration = _FrameRate->QueryInterface<Exchange::IConfiguration>();
+                if (nullptr != configuration)
+                {
+                    configuration->Configure(service);
+                    configuration->Release();
+                }
+
                 // Register for notifications
                 _FrameRate->Register(&_FrameRateNotification);
                 // Invoking Plugin API register to wpeframework
                 Exchange::JFrameRate::Register(*this, _FrameRate);
+
+                _statistics = _FrameRate->QueryInterface<Exchange::IFrameRateStatistics>();
+                if (nullptr != _statistics)
+                {
+                    RegisterStatistics();
+                }
+                else
+                {
+                    LOGERR("FrameRateImplementation does not provide IFrameRateStatistics");
+                }
             }
             else
             {
@@ -117,6 +136,13 @@ namespace WPEFramework
             {
                 _FrameRate->Unregister(&_FrameRateNotification);
                 Exchange::JFrameRate::Unregister(*this);
+                if (nullptr != _statistics)
+                {
+                    UnregisterStatistics();
+                    stopFpsSessions();
+                    _statistics->Release();
+                    _statistics = nullptr;
+                }
 
                 // Stop processing:
                 RPC::IRemoteConnection* connection = service->RemoteConnection(_connectionId);
@@ -172,6 +198,289 @@ namespace WPEFramework
             return "Plugin which exposes FrameRate related methods and notifications.";
         }
 
+        void FrameRate::RegisterStatistics()
+        {
+            Register("updateFpsBatch", &FrameRate::updateFpsBatch, this);
+            Register("getFpsPercentiles", &FrameRate::getFpsPercentiles, this);
+            Register("setJankThreshold", &FrameRate::setJankThreshold, this);
+            Register("updateFramePresentTimes", &FrameRate::updateFramePresentTimes, this);
+            Register("getFramePacing", &FrameRate::getFramePacing, this);
+            Register("getFpsHistory", &FrameRate::getFpsHistory, this);
+            Register("startFpsSession", &FrameRate::startFpsSession, this);
+            Register("stopFpsSession", &FrameRate::stopFpsSession, this);
+            Register("setFpsReportPolicy", &FrameRate::setFpsReportPolicy, this);
+        }
+
+        void FrameRate::UnregisterStatistics()
+        {
+            Unregister("updateFpsBatch");
+            Unregister("getFpsPercentiles");
+            Unregister("setJankThreshold");
+            Unregister("updateFramePresentTimes");
+            Unregister("getFramePacing");
+            Unregister("getFpsHistory");
+            Unregister("startFpsSession");
+            Unregister("stopFpsSession");
+            Unregister("setFpsReportPolicy");
+        }
+
+        uint32_t FrameRate::updateFpsBatch(const JsonObject& parameters, JsonObject& response)
+        {
+            returnIfParamNotFound(parameters, "samples");
+            const JsonArray samples = parameters["samples"].Array();
+            if (samples.Length() > std::numeric_limits<uint16_t>::max())
+            {
+                LOGERR("Too many FPS samples in one batch: %d", samples.Length());
+                response["success"] = false;
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            std::vector<uint64_t> timestamps(samples.Length());
+            std::vector<int> fps(samples.Length());
+            for (int index = 0; index < samples.Length(); index++)
+            {
+                const JsonObject sample = samples[index].Object();
+                if (!sample.HasLabel("timestamp") || !sample.HasLabel("fps"))
+                {
+                    LOGERR("FPS sample %d lacks 'timestamp' or 'fps'", index);
+                    response["success"] = false;
+                    return Core::ERROR_INVALID_PARAMETER;
+                }
+                timestamps[index] = static_cast<uint64_t>(sample["timestamp"].Number());
+                fps[index] = static_cast<int>(sample["fps"].Number());
+            }
+
+            bool success = false;
+            uint32_t result = _statistics->UpdateFpsBatch(static_cast<uint16_t>(fps.size()), timestamps.data(), fps.data(), success);
+            response["success"] = success;
+            return result;
+        }
+
+        uint32_t FrameRate::getFpsPercentiles(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            int p1 = -1, p5 = -1, p50 = -1, p95 = -1, p99 = -1;
+            uint64_t jankFrames = 0;
+            bool success = false;
+
+            uint32_t result = _statistics->GetFpsPercentiles(p1, p5, p50, p95, p99, jankFrames, success);
+            if (Core::ERROR_NONE == result)
+            {
+                response["p1"] = p1;
+                response["p5"] = p5;
+                response["p50"] = p50;
+                response["p95"] = p95;
+                response["p99"] = p99;
+                response["jankFrames"] = jankFrames;
+            }
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::setJankThreshold(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            returnIfNumberParamNotFound(parameters, "threshold");
+            bool success = false;
+
+            uint32_t result = _statistics->SetJankThreshold(static_cast<int>(parameters["threshold"].Number()), success);
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::updateFramePresentTimes(const JsonObject& parameters, JsonObject& response)
+        {
+            returnIfParamNotFound(parameters, "timestamps");
+            const JsonArray timestamps = parameters["timestamps"].Array();
+            if (timestamps.Length() > std::numeric_limits<uint16_t>::max())
+            {
+                LOGERR("Too many frame present times in one batch: %d", timestamps.Length());
+                response["success"] = false;
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            std::vector<uint64_t> batch(timestamps.Length());
+            for (int index = 0; index < timestamps.Length(); index++)
+            {
+                batch[index] = static_cast<uint64_t>(timestamps[index].Number());
+            }
+
+            bool success = false;
+            uint32_t result = _statistics->UpdateFramePresentTimes(static_cast<uint16_t>(batch.size()), batch.data(), success);
+            response["success"] = success;
+            return result;
+        }
+
+        uint32_t FrameRate::getFramePacing(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            uint32_t meanIntervalUs = 0, maxGapUs = 0, over150Percent = 0, over200Percent = 0;
+            uint64_t intervalVarianceUs2 = 0;
+            bool success = false;
+
+            uint32_t result = _statistics->GetFramePacing(meanIntervalUs, intervalVarianceUs2, maxGapUs, over150Percent, over200Percent, success);
+            if (Core::ERROR_NONE == result)
+            {
+                response["meanIntervalUs"] = meanIntervalUs;
+                response["intervalVarianceUs2"] = intervalVarianceUs2;
+                response["maxGapUs"] = maxGapUs;
+                response["over150Percent"] = over150Percent;
+                response["over200Percent"] = over200Percent;
+            }
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::getFpsHistory(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            uint64_t since = 0;
+            if (parameters.HasLabel("since"))
+            {
+                since = static_cast<uint64_t>(parameters["since"].Number());
+            }
+            Exchange::IFrameRateStatistics::IFpsWindowIterator* history = nullptr;
+            bool success = false;
+
+            uint32_t result = _statistics->GetFpsHistory(since, history, success);
+            if ((Core::ERROR_NONE == result) && (nullptr != history))
+            {
+                JsonArray windows;
+                Exchange::IFrameRateStatistics::FpsWindowStats stats;
+                while (history->Next(stats))
+                {
+                    JsonObject window;
+                    window["session"] = stats.session;
+                    window["timestamp"] = stats.timestamp;
+                    window["average"] = stats.average;
+                    window["min"] = stats.min;
+                    window["max"] = stats.max;
+                    window["p1"] = stats.p1;
+                    window["p5"] = stats.p5;
+                    window["p50"] = stats.p50;
+                    window["p95"] = stats.p95;
+                    window["p99"] = stats.p99;
+                    window["frames"] = stats.frames;
+                    window["jankFrames"] = stats.jankFrames;
+                    window["meanIntervalUs"] = stats.meanIntervalUs;
+                    window["intervalVarianceUs2"] = stats.intervalVarianceUs2;
+                    window["maxGapUs"] = stats.maxGapUs;
+                    window["over150Percent"] = stats.over150Percent;
+                    window["over200Percent"] = stats.over200Percent;
+                    window["notified"] = stats.notified;
+                    windows.Add(window);
+                }
+                history->Release();
+                response["history"] = windows;
+            }
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::startFpsSession(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            returnIfNumberParamNotFound(parameters, "frequency");
+            SessionNotification* notification = Core::Service<SessionNotification>::Create<SessionNotification>(this);
+            uint32_t sessionId = 0;
+            bool success = false;
+
+            uint32_t result = _statistics->StartFpsSession(notification, static_cast<int>(parameters["frequency"].Number()), sessionId, success);
+            if (Core::ERROR_NONE == result)
+            {
+                notification->SessionId(sessionId);
+                _adminLock.Lock();
+                _fpsSessions[sessionId] = notification;
+                _adminLock.Unlock();
+                response["sessionId"] = sessionId;
+            }
+            else
+            {
+                notification->Release();
+            }
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::stopFpsSession(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            returnIfNumberParamNotFound(parameters, "sessionId");
+            const uint32_t sessionId = static_cast<uint32_t>(parameters["sessionId"].Number());
+            SessionNotification* notification = nullptr;
+
+            // only sessions started over JSON-RPC, StopFpsSession also accepts those of other clients
+            _adminLock.Lock();
+            auto session = _fpsSessions.find(sessionId);
+            if (session != _fpsSessions.end())
+            {
+                notification = session->second;
+                _fpsSessions.erase(session);
+            }
+            _adminLock.Unlock();
+
+            if (nullptr == notification)
+            {
+                LOGERR("Unknown FPS session %u", sessionId);
+                response["success"] = false;
+                return Core::ERROR_UNKNOWN_KEY;
+            }
+
+            bool success = false;
+            uint32_t result = _statistics->StopFpsSession(sessionId, success);
+            notification->Release();
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        uint32_t FrameRate::setFpsReportPolicy(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            returnIfNumberParamNotFound(parameters, "delta");
+            int heartbeat = 0;
+            if (parameters.HasLabel("heartbeat"))
+            {
+                heartbeat = static_cast<int>(parameters["heartbeat"].Number());
+            }
+            bool success = false;
+
+            uint32_t result = _statistics->SetFpsReportPolicy(static_cast<int>(parameters["delta"].Number()), heartbeat, success);
+            response["success"] = success;
+            LOGTRACEMETHODFIN();
+            return result;
+        }
+
+        void FrameRate::notifyFpsSessionEvent(uint32_t sessionId, int average, int min, int max)
+        {
+            JsonObject params;
+            params["sessionId"] = sessionId;
+            params["average"] = average;
+            params["min"] = min;
+            params["max"] = max;
+            sendNotify("onFpsSessionEvent", params);
+        }
+
+        void FrameRate::stopFpsSessions()
+        {
+            _adminLock.Lock();
+            std::map<uint32_t, SessionNotification*> sessions;
+            sessions.swap(_fpsSessions);
+            _adminLock.Unlock();
+
+            for (auto& session : sessions)
+            {
+                bool success = false;
+                _statistics->StopFpsSession(session.first, success);
+                session.second->Release();
+            }
+        }
+
         void FrameRate::Deactivated(RPC::IRemoteConnection* connection)
         {
             if (connection->Id() == _connectionId) {
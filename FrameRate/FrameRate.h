@@ -22,9 +22,15 @@
 #include "Module.h"
 
 #include <interfaces/IFrameRate.h>
+#include <interfaces/IConfiguration.h>
 #include <interfaces/json/JFrameRate.h>
 #include <interfaces/json/JsonData_FrameRate.h>
 
+#include <atomic>
+#include <map>
+
+#include "interfaces/IFrameRateStatistics.h"
+
 namespace WPEFramework
 {
     namespace Plugin
@@ -82,6 +88,57 @@ namespace WPEFramework
                     FrameRate& _parent;
             };
 
+            // Receives the windows of one startFpsSession client and sends them as 'onFpsSessionEvent'.
+            class SessionNotification : public Exchange::IFrameRate::INotification
+            {
+                private:
+                    SessionNotification() = delete;
+                    SessionNotification(const SessionNotification&) = delete;
+                    SessionNotification& operator=(const SessionNotification&) = delete;
+                public:
+                    explicit SessionNotification(FrameRate* parent)
+                        : _parent(*parent)
+                        , _sessionId(0)
+                    {
+                        ASSERT(parent != nullptr);
+                    }
+
+                    ~SessionNotification() override
+                    {
+                    }
+
+                    BEGIN_INTERFACE_MAP(SessionNotification)
+                        INTERFACE_ENTRY(Exchange::IFrameRate::INotification)
+                    END_INTERFACE_MAP
+
+                    void SessionId(uint32_t sessionId)
+                    {
+                        _sessionId = sessionId;
+                    }
+
+                    void OnFpsEvent(int average, int min, int max) override
+                    {
+                        // the first window closes at least 100ms after StartFpsSession returned the id
+                        uint32_t sessionId = _sessionId;
+                        if (sessionId != 0)
+                        {
+                            _parent.notifyFpsSessionEvent(sessionId, average, min, max);
+                        }
+                    }
+
+                    void OnDisplayFrameRateChanging(const string&) override
+                    {
+                    }
+
+                    void OnDisplayFrameRateChanged(const string&) override
+                    {
+                    }
+
+                private:
+                    FrameRate& _parent;
+                    std::atomic<uint32_t> _sessionId;
+            };
+
             public:
                 FrameRate(const FrameRate&) = delete;
                 FrameRate& operator=(const FrameRate&) = delete;
@@ -104,11 +161,29 @@ namespace WPEFramework
             private:
                 void Deactivated(RPC::IRemoteConnection* connection);
 
+                // JSON-RPC methods of IFrameRateStatistics
+                void RegisterStatistics();
+                void UnregisterStatistics();
+                uint32_t updateFpsBatch(const JsonObject& parameters, JsonObject& response);
+                uint32_t getFpsPercentiles(const JsonObject& parameters, JsonObject& response);
+                uint32_t setJankThreshold(const JsonObject& parameters, JsonObject& response);
+                uint32_t updateFramePresentTimes(const JsonObject& parameters, JsonObject& response);
+                uint32_t getFramePacing(const JsonObject& parameters, JsonObject& response);
+                uint32_t getFpsHistory(const JsonObject& parameters, JsonObject& response);
+                uint32_t startFpsSession(const JsonObject& parameters, JsonObject& response);
+                uint32_t stopFpsSession(const JsonObject& parameters, JsonObject& response);
+                uint32_t setFpsReportPolicy(const JsonObject& parameters, JsonObject& response);
+                void notifyFpsSessionEvent(uint32_t sessionId, int average, int min, int max);
+                void stopFpsSessions();
+
             private:
                 PluginHost::IShell* _service{};
                 uint32_t _connectionId{};
                 Exchange::IFrameRate* _FrameRate{};
+                Exchange::IFrameRateStatistics* _statistics{};
                 Core::Sink<Notification> _FrameRateNotification;
+                Core::CriticalSection _adminLock;
+                std::map<uint32_t, SessionNotification*> _fpsSessions; // started over JSON-RPC, stopped on Deinitialize
         };
     } // namespace Plugin
 } // namespace WPEFramework
@@ -23,6 +23,9 @@
 #include <iomanip>
 #include <sys/prctl.h>
 #include <mutex>
+#include <list>
+#include <vector>
+#include <time.h>
 
 #include "FrameRateImplementation.h"
 #include "host.hpp"
@@ -37,6 +40,15 @@
 #define MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS 100
 #define DEFAULT_MIN_FPS_VALUE 60
 #define DEFAULT_MAX_FPS_VALUE -1
+#define DEFAULT_JANK_FPS_THRESHOLD 30
+#define DEFAULT_FPS_SAMPLE_RING_CAPACITY 4096
+#define FPS_SAMPLE_RING_DRAIN_CHUNK 256
+#define DEFAULT_FPS_HISTORY_SIZE 60
+#define MAXIMUM_FPS_HISTORY_SIZE 1024
+#define DEFAULT_FPS_SESSION 0
+#define MAXIMUM_FPS_SESSIONS 16 // client sessions, the StartFpsCollection window is not counted
+#define DEFAULT_FPS_REPORT_DELTA -1
+#define DEFAULT_FPS_REPORT_HEARTBEAT_IN_MILLISECONDS 0
 
 #ifdef ENABLE_DEBUG
 #define DBGINFO(fmt, ...) LOGINFO(fmt, ##__VA_ARGS__)
@@ -51,20 +63,50 @@ namespace WPEFramework
         SERVICE_REGISTRATION(FrameRateImplementation, 1, 0);
         FrameRateImplementation* FrameRateImplementation::_instance = nullptr;
 
+        /**
+         * @brief Returns a monotonic clock reading used to time the session windows.
+         * @return Milliseconds since an arbitrary fixed point.
+         */
+        static uint64_t monotonicMilliseconds()
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return (static_cast<uint64_t>(now.tv_sec) * 1000) + (now.tv_nsec / 1000000);
+        }
+
+        static int greatestCommonDivisor(int a, int b)
+        {
+            while (b != 0)
+            {
+                int remainder = a % b;
+                a = b;
+                b = remainder;
+            }
+            return a;
+        }
+
         FrameRateImplementation::FrameRateImplementation()
-            : _adminLock()
+            : _framerateNotification()
               , m_fpsCollectionFrequencyInMs(DEFAULT_FPS_COLLECTION_TIME_IN_MILLISECONDS)
-              , m_minFpsValue(DEFAULT_MIN_FPS_VALUE)
-              , m_maxFpsValue(DEFAULT_MAX_FPS_VALUE)
-              , m_totalFpsValues(0)
-              , m_numberOfFpsUpdates(0)
-              , m_fpsCollectionInProgress(false)
+              , m_fpsAccumulator(DEFAULT_JANK_FPS_THRESHOLD)
+              , m_fpsSessions()
+              , m_nextFpsSessionId(DEFAULT_FPS_SESSION + 1)
+              , m_reportFpsTimerPeriodInMs(0)
+              , m_fpsReportDelta(DEFAULT_FPS_REPORT_DELTA)
+              , m_fpsReportHeartbeatInMs(DEFAULT_FPS_REPORT_HEARTBEAT_IN_MILLISECONDS)
+              , m_suppressedFpsEvents(0)
               , m_lastFpsValue(0)
+              , m_lastFpsWindow()
+              , m_fpsHistory(DEFAULT_FPS_HISTORY_SIZE)
+              , m_fpsHistoryNext(0)
+              , m_fpsHistoryCount(0)
+              , m_sampleRingDropped(0)
         {
             FrameRateImplementation::_instance = this;
+            m_fpsSessions[DEFAULT_FPS_SESSION].window.Floor(DEFAULT_MIN_FPS_VALUE);
             device::Host::getInstance().Register(this, "WPE::FrameRate");
             // Connect the timer callback handle for triggering FrameRate notifications.
-            m_reportFpsTimer.connect(std::bind(&FrameRateImplementation::onReportFpsTimer, this));
+            m_reportFpsTimer.connect(std::bind(&FrameRateImplementation::onFpsTimerTick, this));
         }
 
         FrameRateImplementation::~FrameRateImplementation()
@@ -75,6 +117,76 @@ namespace WPEFramework
             {
                 m_reportFpsTimer.stop();
             }
+            for (auto& session : m_fpsSessions)
+            {
+                if (session.second.notification != nullptr)
+                {
+                    session.second.notification->Release();
+                }
+            }
+            m_fpsSessions.clear();
+        }
+
+        /**
+         * @brief Applies the plugin configuration. When "samplering" names a shared memory object,
+         *        a frame-present timestamp ring is created under /dev/shm for zero-copy delivery.
+         * @param service - The plugin shell.
+         * @return Core::ERROR_NONE on success.
+         */
+        uint32_t FrameRateImplementation::Configure(PluginHost::IShell* service)
+        {
+            ASSERT(nullptr != service);
+            Config config;
+            config.FromString(service->ConfigLine());
+
+            {
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                try
+                {
+                    if (primaryVideoDevice() == nullptr)
+                    {
+                        LOGWARN("No video device yet, resolving on first use");
+                    }
+                }
+                catch (const device::Exception& err)
+                {
+                    LOG_DEVICE_EXCEPTION0();
+                    invalidateVideoDevice();
+                }
+            }
+
+            if (config.HistorySize.IsSet())
+            {
+                uint32_t historySize = std::min(std::max(config.HistorySize.Value(), 1u), static_cast<uint32_t>(MAXIMUM_FPS_HISTORY_SIZE));
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                m_fpsHistory.assign(historySize, FpsWindowStats());
+                m_fpsHistoryNext = 0;
+                m_fpsHistoryCount = 0;
+            }
+
+            if (config.ReportDelta.IsSet())
+            {
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                m_fpsReportDelta = static_cast<int>(std::min(config.ReportDelta.Value(), static_cast<uint32_t>(INT_MAX)));
+                m_fpsReportHeartbeatInMs = config.ReportHeartbeat.IsSet()
+                    ? static_cast<int>(std::min(config.ReportHeartbeat.Value(), static_cast<uint32_t>(INT_MAX))) : DEFAULT_FPS_REPORT_HEARTBEAT_IN_MILLISECONDS;
+                LOGINFO("FPS events only on a change of more than %d FPS, heartbeat %d ms", m_fpsReportDelta, m_fpsReportHeartbeatInMs);
+            }
+
+            if (config.SampleRing.IsSet() && !config.SampleRing.Value().empty())
+            {
+                uint32_t capacity = config.SampleRingCapacity.IsSet() ? config.SampleRingCapacity.Value() : DEFAULT_FPS_SAMPLE_RING_CAPACITY;
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                if (m_sampleRing.Create(config.SampleRing.Value(), capacity))
+                {
+                    LOGINFO("FPS sample ring '%s' created with %u slots", config.SampleRing.Value().c_str(), m_sampleRing.Capacity());
+                }
+                else
+                {
+                    LOGERR("Failed to create FPS sample ring '%s', errno %d", config.SampleRing.Value().c_str(), errno);
+                }
+            }
+            return Core::ERROR_NONE;
         }
 
         /******************************************* Notifications ****************************************/
@@ -88,12 +200,9 @@ namespace WPEFramework
          */
         void FrameRateImplementation::dispatchOnFpsEvent(int average, int min, int max)
         {
-            std::list<Exchange::IFrameRate::INotification*>::const_iterator index(_framerateNotification.begin());
-            while (index != _framerateNotification.end())
-            {
-                (*index)->OnFpsEvent(average, min, max);
-                ++index;
-            }
+            _framerateNotification.Notify([average, min, max](Exchange::IFrameRate::INotification* notification) {
+                notification->OnFpsEvent(average, min, max);
+            });
             DBGINFO("average = %d, min = %d, max = %d.", average, min, max);
         }
 
@@ -104,12 +213,9 @@ namespace WPEFramework
          */
         void FrameRateImplementation::dispatchOnDisplayFrameRateChangingEvent(const string& displayFrameRate)
         {
-            std::list<Exchange::IFrameRate::INotification*>::const_iterator index(_framerateNotification.begin());
-            while (index != _framerateNotification.end())
-            {
-                (*index)->OnDisplayFrameRateChanging(displayFrameRate);
-                ++index;
-            }
+            _framerateNotification.Notify([&displayFrameRate](Exchange::IFrameRate::INotification* notification) {
+                notification->OnDisplayFrameRateChanging(displayFrameRate);
+            });
             DBGINFO("displayFrameRate: '%s'", displayFrameRate.c_str());
         }
 
@@ -120,12 +226,9 @@ namespace WPEFramework
          */
         void FrameRateImplementation::dispatchOnDisplayFrameRateChangedEvent(const string& displayFrameRate)
         {
-            std::list<Exchange::IFrameRate::INotification*>::const_iterator index(_framerateNotification.begin());
-            while (index != _framerateNotification.end())
-            {
-                (*index)->OnDisplayFrameRateChanged(displayFrameRate);
-                ++index;
-            }
+            _framerateNotification.Notify([&displayFrameRate](Exchange::IFrameRate::INotification* notification) {
+                notification->OnDisplayFrameRateChanged(displayFrameRate);
+            });
             DBGINFO("displayFrameRate: '%s'", displayFrameRate.c_str());
         }
 
@@ -137,7 +240,6 @@ namespace WPEFramework
          */
         void FrameRateImplementation::DispatchDSMGRDisplayFramerateChangeEvent(Event event, const JsonValue params)
         {
-            _adminLock.Lock();
             switch (event)
             {
                 case  DSMGR_EVENT_DISPLAY_FRAMRATE_PRECHANGE:
@@ -148,26 +250,20 @@ namespace WPEFramework
                     dispatchOnDisplayFrameRateChangedEvent(params.String());
                     break;
             }
-            _adminLock.Unlock();
         }
 
         Core::hresult FrameRateImplementation::Register(Exchange::IFrameRate::INotification *notification)
         {
             Core::hresult status = Core::ERROR_NONE;
             ASSERT(nullptr != notification);
-            _adminLock.Lock();
 
             // Check if the notification is already registered
-            if (std::find(_framerateNotification.begin(), _framerateNotification.end(), notification) != _framerateNotification.end())
+            if (!_framerateNotification.Register(notification))
             {
                 LOGERR("Same notification is registered already");
                 status = Core::ERROR_ALREADY_CONNECTED;
             }
 
-            _framerateNotification.push_back(notification);
-            notification->AddRef();
-
-            _adminLock.Unlock();
             return status;
         }
 
@@ -175,19 +271,36 @@ namespace WPEFramework
         {
             Core::hresult status = Core::ERROR_GENERAL;
             ASSERT(nullptr != notification);
-            _adminLock.Lock();
+
+            {
+                // A client going away ends the FPS sessions it did not stop itself.
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                for (auto session = m_fpsSessions.begin(); session != m_fpsSessions.end();)
+                {
+                    if (session->second.notification == notification)
+                    {
+                        LOGWARN("Ending FPS session %u of unregistered notification %p", session->first, notification);
+                        notification->Release();
+                        session = m_fpsSessions.erase(session);
+                    }
+                    else
+                    {
+                        ++session;
+                    }
+                }
+                updateReportTimer();
+            }
 
             // Just unregister one notification once
-            auto itr = std::find(_framerateNotification.begin(), _framerateNotification.end(), notification);
-            if (itr != _framerateNotification.end())
+            if (_framerateNotification.Unregister(notification))
             {
-                (*itr)->Release();
-                _framerateNotification.erase(itr);
                 status = Core::ERROR_NONE;
             }
-            LOGERR("Notification %p not found in _framerateNotification", notification);
+            else
+            {
+                LOGERR("Notification %p not found in _framerateNotification", notification);
+            }
 
-            _adminLock.Unlock();
             return status;
         }
 
@@ -204,22 +317,32 @@ namespace WPEFramework
             DBGINFO();
             success = false;
 
+            {
+                std::lock_guard<std::mutex> displayGuard(m_displayFrameRateMutex);
+                if (!m_displayFrameRate.empty())
+                {
+                    framerate = m_displayFrameRate;
+                    success = true;
+                    return Core::ERROR_NONE;
+                }
+            }
+
             std::lock_guard<std::mutex> guard(m_callMutex);
 
             try
             {
-                device::List<device::VideoDevice> videoDevices = device::Host::getInstance().getVideoDevices();
-                if (videoDevices.size() == 0)
+                char sFramerate[32] = {0};
+                bool available = true;
+                bool called = callVideoDevice([&sFramerate](device::VideoDevice& device) { return device.getCurrentDisframerate(sFramerate); }, available);
+                if (!available)
                 {
                     LOGERR("No video devices available.");
                     return Core::ERROR_NOT_SUPPORTED;
                 }
-
-                char sFramerate[32] = {0};
-                device::VideoDevice& device = videoDevices.at(0);
-                if (!device.getCurrentDisframerate(sFramerate) && sFramerate[0] != '\0')
+                if (called && sFramerate[0] != '\0')
                 {
                     framerate = sFramerate;
+                    cacheDisplayFrameRate(framerate);
                     success = true;
                     return Core::ERROR_NONE;
                 }
@@ -229,6 +352,7 @@ namespace WPEFramework
             catch (const device::Exception& err)
             {
                 LOG_DEVICE_EXCEPTION0();
+                invalidateVideoDevice();
             }
             catch(const std::exception& err)
             {
@@ -258,14 +382,14 @@ namespace WPEFramework
             success = false;
             try
             {
-                device::List<device::VideoDevice> videoDevices = device::Host::getInstance().getVideoDevices();
-                if (videoDevices.size() == 0)
+                bool available = true;
+                bool called = callVideoDevice([&autoFRMMode](device::VideoDevice& device) { return device.getFRFMode(&autoFRMMode); }, available);
+                if (!available)
                 {
                     LOGERR("No video devices available.");
                     return Core::ERROR_NOT_SUPPORTED;
                 }
-                device::VideoDevice& device = videoDevices.at(0);
-                if (!device.getFRFMode(&autoFRMMode))
+                if (called)
                 {
                     DBGINFO("Frame Mode: %d", autoFRMMode);
                     success = true;
@@ -276,6 +400,7 @@ namespace WPEFramework
             catch(const device::Exception& err)
             {
                 LOG_DEVICE_EXCEPTION0();
+                invalidateVideoDevice();
             }
             catch(const std::exception& err)
             {
@@ -344,15 +469,17 @@ namespace WPEFramework
 
             try
             {
-                device::List<device::VideoDevice> videoDevices = device::Host::getInstance().getVideoDevices();
-                if (videoDevices.size() == 0)
+                bool available = true;
+                bool called = callVideoDevice([&sFramerate](device::VideoDevice& device) { return device.setDisplayframerate(sFramerate.c_str()); }, available);
+                if (!available)
                 {
                     LOGERR("No video devices available.");
                     return Core::ERROR_NOT_SUPPORTED;
                 }
-                device::VideoDevice& device = videoDevices.at(0);
-                if (!device.setDisplayframerate(sFramerate.c_str()))
+                if (called)
                 {
+                    // the HAL may adjust the request, OnDisplayFrameratePostChange brings the applied value
+                    cacheDisplayFrameRate(string());
                     success = true;
                     return Core::ERROR_NONE;
                 }
@@ -361,6 +488,7 @@ namespace WPEFramework
             catch (const device::Exception& err)
             {
                 LOG_DEVICE_EXCEPTION0();
+                invalidateVideoDevice();
             }
             catch(const std::exception& err)
             {
@@ -394,14 +522,14 @@ namespace WPEFramework
 
             try
             {
-                device::List<device::VideoDevice> videoDevices = device::Host::getInstance().getVideoDevices();
-                if (videoDevices.size() == 0)
+                bool available = true;
+                bool called = callVideoDevice([frmmode](device::VideoDevice& device) { return device.setFRFMode(frmmode); }, available);
+                if (!available)
                 {
                     LOGERR("No video devices available.");
                     return Core::ERROR_NOT_SUPPORTED;
                 }
-                device::VideoDevice& device = videoDevices.at(0);
-                if (!device.setFRFMode(frmmode))
+                if (called)
                 {
                     success = true;
                     return Core::ERROR_NONE;
@@ -411,6 +539,7 @@ namespace WPEFramework
             catch (const device::Exception& err)
             {
                 LOG_DEVICE_EXCEPTION0();
+                invalidateVideoDevice();
             }
             catch(const std::exception& err)
             {
@@ -435,29 +564,60 @@ namespace WPEFramework
             DBGINFO();
             std::lock_guard<std::mutex> guard(m_callMutex);
 
-            if (m_fpsCollectionInProgress)
+            FpsSession& session = m_fpsSessions[DEFAULT_FPS_SESSION];
+            if (session.active)
             {
                 DBGINFO("FPS collection is already in progress.");
             }
-            if (m_reportFpsTimer.isActive())
+
+            // Hand the samples collected so far to the running client sessions before the restart.
+            collectFpsSamples();
+            if (!fpsSessionsActive(DEFAULT_FPS_SESSION))
             {
-                m_reportFpsTimer.stop();
+                restartFramePacing();
+            }
+            string displayFrameRate;
+            {
+                std::lock_guard<std::mutex> displayGuard(m_displayFrameRateMutex);
+                displayFrameRate = m_displayFrameRate;
+            }
+            try
+            {
+                char sFramerate[32] = {0};
+                bool available = true;
+                if (displayFrameRate.empty()
+                    && callVideoDevice([&sFramerate](device::VideoDevice& device) { return device.getCurrentDisframerate(sFramerate); }, available)
+                    && (sFramerate[0] != '\0'))
+                {
+                    displayFrameRate = sFramerate;
+                    cacheDisplayFrameRate(displayFrameRate);
+                }
+            }
+            catch (const device::Exception& err)
+            {
+                LOG_DEVICE_EXCEPTION0();
+                invalidateVideoDevice();
+            }
+            if (!displayFrameRate.empty())
+            {
+                updateRefreshPeriod(displayFrameRate);
             }
 
-            m_minFpsValue = DEFAULT_MIN_FPS_VALUE;
-            m_maxFpsValue = DEFAULT_MAX_FPS_VALUE;
-            m_totalFpsValues = 0;
-            m_numberOfFpsUpdates = 0;
-            m_fpsCollectionInProgress = true;
             int fpsCollectionFrequency = m_fpsCollectionFrequencyInMs;
-
             if (fpsCollectionFrequency < MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS)
             {
                 fpsCollectionFrequency = MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS;
             }
-            m_lastFpsValue = -1;
-            m_reportFpsTimer.start(fpsCollectionFrequency);
-            DBGINFO("FPS collection timer started with frequency %d milliseconds.", fpsCollectionFrequency);
+            session.active = true;
+            session.frequencyInMs = fpsCollectionFrequency;
+            session.windowStartInMs = monotonicMilliseconds();
+            session.window = FpsAccumulator::Snapshot();
+            session.window.Floor(DEFAULT_MIN_FPS_VALUE);
+            session.pacing = FramePacingStats::Totals();
+            session.lastFpsValue = -1;
+            session.reported = false;
+            updateReportTimer();
+            DBGINFO("FPS collection started with frequency %d milliseconds.", fpsCollectionFrequency);
             success = true;
             return Core::ERROR_NONE;
         }
@@ -472,30 +632,150 @@ namespace WPEFramework
             DBGINFO();
             std::lock_guard<std::mutex> guard(m_callMutex);
 
-            if (m_reportFpsTimer.isActive())
+            FpsSession& session = m_fpsSessions[DEFAULT_FPS_SESSION];
+            if (session.active)
             {
-                m_reportFpsTimer.stop();
-            }
-            if (m_fpsCollectionInProgress)
-            {
-                m_fpsCollectionInProgress = false;
-                int averageFps = -1;
-                int minFps = -1;
-                int maxFps = -1;
-                if (m_numberOfFpsUpdates > 0)
+                session.active = false;
+                collectFpsSamples();
+                if (session.window.count > 0)
                 {
-                    averageFps = (m_totalFpsValues / m_numberOfFpsUpdates);
-                    minFps = m_minFpsValue;
-                    maxFps = m_maxFpsValue;
-                    dispatchOnFpsEvent(averageFps, minFps, maxFps);
+                    int averageFps = static_cast<int>(session.window.total / static_cast<int64_t>(session.window.count));
+                    int minFps = session.window.min;
+                    int maxFps = std::max(session.window.max, DEFAULT_MAX_FPS_VALUE);
+                    reportFpsWindow(DEFAULT_FPS_SESSION, session, averageFps, minFps, maxFps, true);
                 }
+                session.window = FpsAccumulator::Snapshot();
+                session.pacing = FramePacingStats::Totals();
+            }
+            updateReportTimer();
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Starts an FPS collection session with its own window length. Sessions run next to
+         *        each other and next to StartFpsCollection without resetting one another; all of them
+         *        share the samples and a single report timer.
+         * @param notification - The client that receives the session's 'onFpsEvent', nullptr for every registered client.
+         * @param frequency - The window length in milliseconds, min is 100ms.
+         * @param sessionId - Receives the session handle for StopFpsSession.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_INVALID_PARAMETER on an invalid frequency,
+         *         Core::ERROR_UNAVAILABLE if too many sessions are running.
+         */
+        Core::hresult FrameRateImplementation::StartFpsSession(Exchange::IFrameRate::INotification* notification, const int frequency, uint32_t& sessionId, bool& success)
+        {
+            DBGINFO();
+            success = false;
+            if (frequency < MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS)
+            {
+                LOGERR("Invalid frequency, minimum is %d ms.", MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS);
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            std::lock_guard<std::mutex> guard(m_callMutex);
+            // the StartFpsCollection window (session 0) always exists
+            if ((m_fpsSessions.size() - 1) >= MAXIMUM_FPS_SESSIONS)
+            {
+                LOGERR("Too many FPS sessions, maximum is %d.", MAXIMUM_FPS_SESSIONS);
+                return Core::ERROR_UNAVAILABLE;
+            }
+
+            // Samples collected so far belong to the windows that were already open.
+            collectFpsSamples();
+
+            sessionId = m_nextFpsSessionId++;
+            if (m_nextFpsSessionId == DEFAULT_FPS_SESSION)
+            {
+                m_nextFpsSessionId++;
+            }
+            if (!fpsSessionsActive(sessionId))
+            {
+                restartFramePacing();
+            }
+            FpsSession& session = m_fpsSessions[sessionId];
+            session.notification = notification;
+            if (notification != nullptr)
+            {
+                notification->AddRef();
+            }
+            session.frequencyInMs = frequency;
+            session.active = true;
+            session.windowStartInMs = monotonicMilliseconds();
+            session.window.Floor(DEFAULT_MIN_FPS_VALUE);
+            updateReportTimer();
+            LOGINFO("FPS session %u started with frequency %d milliseconds.", sessionId, frequency);
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Stops an FPS collection session, its partial window is reported if it has samples.
+         * @param sessionId - The handle returned by StartFpsSession.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_UNKNOWN_KEY if there is no such session.
+         */
+        Core::hresult FrameRateImplementation::StopFpsSession(const uint32_t sessionId, bool& success)
+        {
+            DBGINFO();
+            success = false;
+            std::lock_guard<std::mutex> guard(m_callMutex);
+
+            auto session = m_fpsSessions.find(sessionId);
+            if ((sessionId == DEFAULT_FPS_SESSION) || (session == m_fpsSessions.end()))
+            {
+                LOGERR("Unknown FPS session %u", sessionId);
+                return Core::ERROR_UNKNOWN_KEY;
+            }
+
+            collectFpsSamples();
+            if (session->second.window.count > 0)
+            {
+                const FpsAccumulator::Snapshot& window = session->second.window;
+                int averageFps = static_cast<int>(window.total / static_cast<int64_t>(window.count));
+                reportFpsWindow(sessionId, session->second, averageFps, window.min, std::max(window.max, DEFAULT_MAX_FPS_VALUE), true);
+            }
+            if (session->second.notification != nullptr)
+            {
+                session->second.notification->Release();
+            }
+            m_fpsSessions.erase(session);
+            updateReportTimer();
+            LOGINFO("FPS session %u stopped.", sessionId);
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Sets when a collection window is worth an 'onFpsEvent'. Windows that are not reported
+         *        are still stored in the history and the last window statistics.
+         * @param delta - Report only when average, min or max moved by more than this many FPS since the
+         *                last reported window, -1 to report every window (default).
+         * @param heartbeatInMs - With a delta, still report after this many milliseconds without an event, 0 for never.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_INVALID_PARAMETER on invalid input.
+         */
+        Core::hresult FrameRateImplementation::SetFpsReportPolicy(const int delta, const int heartbeatInMs, bool& success)
+        {
+            DBGINFO();
+            success = false;
+            if ((delta < -1) || (heartbeatInMs < 0))
+            {
+                LOGERR("Invalid FPS report policy: delta %d, heartbeat %d ms", delta, heartbeatInMs);
+                return Core::ERROR_INVALID_PARAMETER;
             }
+
+            std::lock_guard<std::mutex> guard(m_callMutex);
+            m_fpsReportDelta = delta;
+            m_fpsReportHeartbeatInMs = heartbeatInMs;
+            DBGINFO("FPS report delta %d, heartbeat %d ms.", delta, heartbeatInMs);
             success = true;
             return Core::ERROR_NONE;
         }
 
         /**
-         * @brief Updates the FPS value.
+         * @brief Updates the FPS value. Does not take m_callMutex, samples go to the
+         *        lock-free accumulator so slow notification sinks never stall the producer.
          * @param newFpsValue - The new FPS value.
          * @param success - Indicates whether the operation was successful.
          * @return Core::ERROR_NONE on success, Core::ERROR_GENERAL on failure.
@@ -509,16 +789,210 @@ namespace WPEFramework
                 success = false;
                 return Core::ERROR_INVALID_PARAMETER;
             }
+            m_fpsAccumulator.Add(newFpsValue);
+            m_lastFpsValue.store(newFpsValue, std::memory_order_relaxed);
+            DBGINFO("newFpsValue = %d", newFpsValue);
+
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Returns the FPS percentiles and jank frame count of the last completed collection window.
+         * @param p1 - The 1st percentile FPS (-1 if the window had no samples).
+         * @param p5 - The 5th percentile FPS.
+         * @param p50 - The median FPS.
+         * @param p95 - The 95th percentile FPS.
+         * @param p99 - The 99th percentile FPS.
+         * @param jankFrames - Number of samples below the jank threshold.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success.
+         */
+        Core::hresult FrameRateImplementation::GetFpsPercentiles(int& p1, int& p5, int& p50, int& p95, int& p99, uint64_t& jankFrames, bool& success)
+        {
+            DBGINFO();
             std::lock_guard<std::mutex> guard(m_callMutex);
 
-            m_maxFpsValue = std::max(m_maxFpsValue, newFpsValue);
-            m_minFpsValue = std::min(m_minFpsValue, newFpsValue);
-            m_totalFpsValues += newFpsValue;
-            m_numberOfFpsUpdates++;
-            m_lastFpsValue = newFpsValue;
-            DBGINFO("m_maxFpsValue = %d, m_minFpsValue = %d, m_totalFpsValues = %d, m_numberOfFpsUpdates = %d",
-                    m_maxFpsValue, m_minFpsValue, m_totalFpsValues, m_numberOfFpsUpdates);
+            if (m_lastFpsWindow.frames == 0)
+            {
+                p1 = p5 = p50 = p95 = p99 = -1;
+                jankFrames = 0;
+            }
+            else
+            {
+                p1 = m_lastFpsWindow.p1;
+                p5 = m_lastFpsWindow.p5;
+                p50 = m_lastFpsWindow.p50;
+                p95 = m_lastFpsWindow.p95;
+                p99 = m_lastFpsWindow.p99;
+                jankFrames = m_lastFpsWindow.jankFrames;
+            }
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Returns the retained collection window summaries newer than sinceTimestamp, oldest first.
+         *        At most "historysize" (default 60) windows are kept.
+         * @param sinceTimestamp - Only windows that ended after this time (milliseconds since epoch) are returned, 0 for all.
+         * @param history - Receives an iterator over the window summaries.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success.
+         */
+        Core::hresult FrameRateImplementation::GetFpsHistory(const uint64_t sinceTimestamp, IFpsWindowIterator*& history, bool& success)
+        {
+            DBGINFO();
+            std::list<FpsWindowStats> windows;
+            {
+                std::lock_guard<std::mutex> guard(m_callMutex);
+
+                size_t index = (m_fpsHistoryNext + m_fpsHistory.size() - m_fpsHistoryCount) % m_fpsHistory.size();
+                for (size_t count = 0; count < m_fpsHistoryCount; count++)
+                {
+                    if (m_fpsHistory[index].timestamp > sinceTimestamp)
+                    {
+                        windows.push_back(m_fpsHistory[index]);
+                    }
+                    index = (index + 1) % m_fpsHistory.size();
+                }
+            }
+            history = Core::Service<RPC::IteratorType<IFpsWindowIterator>>::Create<IFpsWindowIterator>(windows);
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Sets the FPS value below which a sample is counted as a jank frame.
+         * @param threshold - The jank threshold in frames per second. Default is 30.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_INVALID_PARAMETER on a negative threshold.
+         */
+        Core::hresult FrameRateImplementation::SetJankThreshold(const int threshold, bool& success)
+        {
+            DBGINFO();
+            success = false;
+            if (threshold < 0)
+            {
+                LOGERR("Invalid jank threshold: %d", threshold);
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            m_fpsAccumulator.JankThreshold(threshold);
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Updates the FPS value with a batch of timestamped samples in one call.
+         *        The window statistics are identical to calling UpdateFps for every sample,
+         *        the sample with the latest timestamp becomes the last known FPS value.
+         *        The batch is rejected as a whole if any sample is invalid.
+         * @param length - Number of samples.
+         * @param timestamps - Presentation time of every sample in monotonic microseconds.
+         * @param fps - The FPS value of every sample, collected since the previous flush.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_INVALID_PARAMETER on invalid input.
+         */
+        Core::hresult FrameRateImplementation::UpdateFpsBatch(const uint16_t length, const uint64_t timestamps[], const int fps[], bool& success)
+        {
+            DBGINFO();
+            success = false;
+            if ((length > 0) && ((timestamps == nullptr) || (fps == nullptr)))
+            {
+                LOGERR("Invalid FPS sample batch");
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            uint16_t latest = 0;
+            for (uint16_t index = 0; index < length; index++)
+            {
+                if (fps[index] < 0)
+                {
+                    LOGERR("Invalid FPS value: %d at index %u", fps[index], index);
+                    return Core::ERROR_INVALID_PARAMETER;
+                }
+                if (timestamps[index] >= timestamps[latest])
+                {
+                    latest = index;
+                }
+            }
+
+            if (length > 0)
+            {
+                m_fpsAccumulator.Add(fps, length, [](int value) { return value; });
+                m_lastFpsValue.store(fps[latest], std::memory_order_relaxed);
+            }
+            DBGINFO("length = %u", length);
+
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Frame pacing mode: records frame-present timestamps. Every interval between two
+         *        consecutive frames feeds the frame-interval statistics and, as 1s / interval,
+         *        the FPS window statistics reported through 'onFpsEvent'.
+         * @param length - Number of entries in timestamps.
+         * @param timestamps - Frame-present times in monotonic microseconds, strictly increasing.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success, Core::ERROR_INVALID_PARAMETER on invalid input.
+         */
+        Core::hresult FrameRateImplementation::UpdateFramePresentTimes(const uint16_t length, const uint64_t timestamps[], bool& success)
+        {
+            DBGINFO();
+            success = false;
+            if ((length > 0) && (timestamps == nullptr))
+            {
+                LOGERR("Invalid frame-present timestamps");
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            std::vector<int> fpsValues;
+            fpsValues.reserve(length);
+            {
+                std::lock_guard<std::mutex> pacingGuard(m_pacingMutex);
+
+                uint64_t previous = m_framePacing.PreviousTimestamp();
+                for (uint16_t index = 0; index < length; index++)
+                {
+                    if ((timestamps[index] == 0) || (timestamps[index] <= previous))
+                    {
+                        LOGERR("Frame-present timestamp %llu at index %u is not increasing",
+                                static_cast<unsigned long long>(timestamps[index]), index);
+                        return Core::ERROR_INVALID_PARAMETER;
+                    }
+                    previous = timestamps[index];
+                }
+
+                recordFramePresentTimes(timestamps, length, fpsValues);
+            }
+            addFpsValues(fpsValues);
+
+            success = true;
+            return Core::ERROR_NONE;
+        }
+
+        /**
+         * @brief Returns the frame-interval statistics of the last completed collection window.
+         * @param meanIntervalUs - Mean frame interval in microseconds (0 if no intervals were recorded).
+         * @param intervalVarianceUs2 - Frame interval variance in square microseconds.
+         * @param maxGapUs - Longest frame interval in microseconds.
+         * @param over150Percent - Intervals exceeding 1.5x the display refresh period.
+         * @param over200Percent - Intervals exceeding 2x the display refresh period.
+         * @param success - Indicates whether the operation was successful.
+         * @return Core::ERROR_NONE on success.
+         */
+        Core::hresult FrameRateImplementation::GetFramePacing(uint32_t& meanIntervalUs, uint64_t& intervalVarianceUs2, uint32_t& maxGapUs,
+                uint32_t& over150Percent, uint32_t& over200Percent, bool& success)
+        {
+            DBGINFO();
+            std::lock_guard<std::mutex> guard(m_callMutex);
 
+            meanIntervalUs = m_lastFpsWindow.meanIntervalUs;
+            intervalVarianceUs2 = m_lastFpsWindow.intervalVarianceUs2;
+            maxGapUs = m_lastFpsWindow.maxGapUs;
+            over150Percent = m_lastFpsWindow.over150Percent;
+            over200Percent = m_lastFpsWindow.over200Percent;
             success = true;
             return Core::ERROR_NONE;
         }
@@ -526,32 +1000,421 @@ namespace WPEFramework
         /************************************** Implementation specific ****************************************/
 
         /**
-         * @brief This function is used to handle the timer event for reporting FPS.
+         * @brief Feeds frame-present timestamps into the pacing statistics, timestamps that do not
+         *        increase are skipped. Must be called with m_pacingMutex held.
+         * @param timestamps - Frame-present times in monotonic microseconds.
+         * @param length - Number of entries in timestamps.
+         * @param fpsValues - Receives 1s / interval for every recorded interval.
+         * @return void
+         */
+        void FrameRateImplementation::recordFramePresentTimes(const uint64_t timestamps[], uint32_t length, std::vector<int>& fpsValues)
+        {
+            for (uint32_t index = 0; index < length; index++)
+            {
+                uint64_t intervalUs = 0;
+                if ((timestamps[index] > m_framePacing.PreviousTimestamp()) && m_framePacing.Add(timestamps[index], intervalUs))
+                {
+                    fpsValues.push_back(static_cast<int>((1000000 + (intervalUs / 2)) / intervalUs));
+                }
+            }
+        }
+
+        /**
+         * @brief Feeds FPS values derived from frame intervals into the window accumulator.
+         * @param fpsValues - The FPS values, in presentation order.
+         * @return void
+         */
+        void FrameRateImplementation::addFpsValues(const std::vector<int>& fpsValues)
+        {
+            if (!fpsValues.empty())
+            {
+                m_fpsAccumulator.Add(fpsValues.data(), static_cast<uint32_t>(fpsValues.size()), [](int value) { return value; });
+                m_lastFpsValue.store(fpsValues.back(), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Drains the shared-memory sample ring into the current collection window.
+         * @return void
+         */
+        void FrameRateImplementation::drainSampleRing()
+        {
+            if (!m_sampleRing.IsOpen())
+            {
+                return;
+            }
+
+            uint64_t timestamps[FPS_SAMPLE_RING_DRAIN_CHUNK];
+            std::vector<int> fpsValues;
+            {
+                std::lock_guard<std::mutex> pacingGuard(m_pacingMutex);
+                // at most one ring per tick, a producer outrunning the drain (or a corrupt head) must not hold the timer thread
+                uint32_t remaining = m_sampleRing.Capacity();
+                uint32_t count = 0;
+                while ((remaining > 0) && ((count = m_sampleRing.Pop(timestamps, std::min<uint32_t>(remaining, FPS_SAMPLE_RING_DRAIN_CHUNK))) > 0))
+                {
+                    recordFramePresentTimes(timestamps, count, fpsValues);
+                    remaining -= count;
+                }
+            }
+            addFpsValues(fpsValues);
+
+            uint64_t dropped = m_sampleRing.Dropped();
+            if (dropped != m_sampleRingDropped)
+            {
+                LOGWARN("FPS sample ring dropped %llu samples", static_cast<unsigned long long>(dropped - m_sampleRingDropped));
+                m_sampleRingDropped = dropped;
+            }
+        }
+
+        /**
+         * @brief Returns the cached primary video device, resolving it over DS IPC only when nothing
+         *        is cached yet. Must be called with m_callMutex held, may throw device::Exception.
+         * @return The video device, nullptr if the platform has none.
+         */
+        device::VideoDevice* FrameRateImplementation::primaryVideoDevice()
+        {
+            if (m_videoDevices.size() == 0)
+            {
+                m_videoDevices = device::Host::getInstance().getVideoDevices();
+            }
+            return (m_videoDevices.size() > 0) ? &m_videoDevices.at(0) : nullptr;
+        }
+
+        /**
+         * @brief Runs a DS call on the primary video device. After the device manager restarted, the
+         *        first call over the reconnected IPC fails on the handles of the previous connection,
+         *        so a failing call drops the cache and is retried once on a freshly resolved device.
+         *        Must be called with m_callMutex held, may throw device::Exception.
+         * @param call - Runs the DS call on the device, returns the DS result (0 on success).
+         * @param available - Set to false if the platform has no video device.
+         * @return true if the call succeeded.
+         */
+        template <typename CALL>
+        bool FrameRateImplementation::callVideoDevice(CALL call, bool& available)
+        {
+            for (int attempt = 0; attempt < 2; attempt++)
+            {
+                device::VideoDevice* device = primaryVideoDevice();
+                available = (device != nullptr);
+                if (!available)
+                {
+                    return false;
+                }
+                if (call(*device) == 0)
+                {
+                    return true;
+                }
+                invalidateVideoDevice();
+            }
+            return false;
+        }
+
+        /**
+         * @brief Drops the cached video device and display framerate. A DS exception means the
+         *        device manager went away or was reinitialized, the handles are resolved again on next use.
+         *        Must be called with m_callMutex held.
+         * @return void
+         */
+        void FrameRateImplementation::invalidateVideoDevice()
+        {
+            m_videoDevices = device::List<device::VideoDevice>();
+            cacheDisplayFrameRate(string());
+        }
+
+        /**
+         * @brief Stores the current display framerate served by GetDisplayFrameRate, empty to query the HAL again.
+         * @param framerate - The display frame rate in the format "WIDTHxHEIGHTxFPS".
+         * @return void
+         */
+        void FrameRateImplementation::cacheDisplayFrameRate(const string& framerate)
+        {
+            std::lock_guard<std::mutex> displayGuard(m_displayFrameRateMutex);
+            m_displayFrameRate = framerate;
+        }
+
+        /**
+         * @brief Updates the display refresh period used to classify frame-interval gaps.
+         * @param framerate - The display frame rate in the format "WIDTHxHEIGHTxFPS".
+         * @return void
+         */
+        void FrameRateImplementation::updateRefreshPeriod(const string& framerate)
+        {
+            uint32_t periodUs = FramePacingStats::PeriodFromFramerate(framerate);
+            std::lock_guard<std::mutex> pacingGuard(m_pacingMutex);
+            m_framePacing.RefreshPeriod(periodUs);
+            DBGINFO("Display refresh period %u us for '%s'", periodUs, framerate.c_str());
+        }
+
+        /**
+         * @brief Moves the samples collected since the previous call into the window of every session.
+         *        Must be called with m_callMutex held.
+         * @return void
+         */
+        void FrameRateImplementation::collectFpsSamples()
+        {
+            drainSampleRing();
+
+            // Producers continue on the next epoch bank while this one is merged.
+            FpsAccumulator::Snapshot samples = m_fpsAccumulator.Swap();
+            FramePacingStats::Totals pacing;
+            {
+                std::lock_guard<std::mutex> pacingGuard(m_pacingMutex);
+                pacing = m_framePacing.Drain();
+            }
+            const int lastFpsValue = m_lastFpsValue.load(std::memory_order_relaxed);
+            for (auto& session : m_fpsSessions)
+            {
+                session.second.window.Merge(samples);
+                session.second.pacing.Merge(pacing);
+                if (samples.count > 0)
+                {
+                    session.second.lastFpsValue = lastFpsValue;
+                }
+            }
+        }
+
+        /**
+         * @brief Reports the window of a session and opens the next one. Must be called with m_callMutex held.
+         * @param sessionId - The session handle.
+         * @param session - The session.
+         * @return void
+         */
+        void FrameRateImplementation::closeFpsWindow(uint32_t sessionId, FpsSession& session)
+        {
+            const FpsAccumulator::Snapshot& window = session.window;
+            int averageFps = (window.count > 0) ? static_cast<int>(window.total / static_cast<int64_t>(window.count)) : -1;
+            int minFps = (window.count > 0) ? window.min : DEFAULT_MIN_FPS_VALUE;
+            int maxFps = (window.count > 0) ? std::max(window.max, DEFAULT_MAX_FPS_VALUE) : DEFAULT_MAX_FPS_VALUE;
+
+            reportFpsWindow(sessionId, session, averageFps, minFps, maxFps, false);
+
+            session.window = FpsAccumulator::Snapshot();
+            session.pacing = FramePacingStats::Totals();
+            session.windowStartInMs = monotonicMilliseconds();
+            if (session.lastFpsValue >= 0)
+            {
+                // store the last fps value just in case there are no updates
+                session.window.Add(session.lastFpsValue, m_fpsAccumulator.JankThreshold());
+            }
+            else
+            {
+                session.window.Floor(DEFAULT_MIN_FPS_VALUE);
+            }
+        }
+
+        /**
+         * @brief Returns whether a session other than the given one is collecting.
+         *        Must be called with m_callMutex held.
+         * @param sessionId - The session to leave out.
+         * @return true if another session is active.
+         */
+        bool FrameRateImplementation::fpsSessionsActive(uint32_t sessionId) const
+        {
+            for (const auto& session : m_fpsSessions)
+            {
+                if ((session.first != sessionId) && session.second.active)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Starts a new frame-present sequence and discards queued ring samples, used when
+         *        collection starts after a pause. Must be called with m_callMutex held.
+         * @return void
+         */
+        void FrameRateImplementation::restartFramePacing()
+        {
+            std::lock_guard<std::mutex> pacingGuard(m_pacingMutex);
+            m_framePacing.Restart();
+            if (m_sampleRing.IsOpen())
+            {
+                // samples queued while collection was stopped belong to no window, at most one ring of them
+                uint64_t timestamps[FPS_SAMPLE_RING_DRAIN_CHUNK];
+                uint32_t remaining = m_sampleRing.Capacity();
+                uint32_t count = 0;
+                while ((remaining > 0) && ((count = m_sampleRing.Pop(timestamps, std::min<uint32_t>(remaining, FPS_SAMPLE_RING_DRAIN_CHUNK))) > 0))
+                {
+                    remaining -= count;
+                }
+            }
+        }
+
+        /**
+         * @brief (Re)starts the shared report timer at the GCD of the active session frequencies,
+         *        or stops it when no session is active. Must be called with m_callMutex held.
+         *        The period is at least the minimum window length, co-prime frequencies would
+         *        otherwise tick every millisecond; windows then close within half a tick.
+         * @return void
+         */
+        void FrameRateImplementation::updateReportTimer()
+        {
+            int periodInMs = 0;
+            for (const auto& session : m_fpsSessions)
+            {
+                if (session.second.active)
+                {
+                    periodInMs = greatestCommonDivisor(periodInMs, session.second.frequencyInMs);
+                }
+            }
+            if (periodInMs > 0)
+            {
+                periodInMs = std::max(periodInMs, MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS);
+            }
+
+            if ((periodInMs == m_reportFpsTimerPeriodInMs) && ((periodInMs == 0) == !m_reportFpsTimer.isActive()))
+            {
+                return;
+            }
+            if (m_reportFpsTimer.isActive())
+            {
+                m_reportFpsTimer.stop();
+            }
+            m_reportFpsTimerPeriodInMs = periodInMs;
+            if (periodInMs > 0)
+            {
+                m_reportFpsTimer.start(periodInMs);
+                DBGINFO("FPS report timer started with period %d milliseconds.", periodInMs);
+            }
+        }
+
+        /**
+         * @brief Shared report timer tick: collects the samples and closes the window of every
+         *        active session whose frequency has elapsed.
+         * @return void
+         */
+        void FrameRateImplementation::onFpsTimerTick()
+        {
+            std::lock_guard<std::mutex> guard(m_callMutex);
+
+            collectFpsSamples();
+
+            const uint64_t now = monotonicMilliseconds();
+            // half a tick of slack absorbs timer jitter without skipping a whole period
+            const uint64_t slack = static_cast<uint64_t>(m_reportFpsTimerPeriodInMs / 2);
+            for (auto& session : m_fpsSessions)
+            {
+                if (session.second.active && ((now - session.second.windowStartInMs + slack) >= static_cast<uint64_t>(session.second.frequencyInMs)))
+                {
+                    closeFpsWindow(session.first, session.second);
+                }
+            }
+        }
+
+        /**
+         * @brief This function is used to handle the timer event for reporting FPS,
+         *        it closes the StartFpsCollection window regardless of the elapsed time.
          * @return void
          */
         void FrameRateImplementation::onReportFpsTimer()
         {
             std::lock_guard<std::mutex> guard(m_callMutex);
-            int averageFps = (m_numberOfFpsUpdates > 0) ? (m_totalFpsValues / m_numberOfFpsUpdates) : -1;
-            int minFps = (m_numberOfFpsUpdates > 0) ? m_minFpsValue : DEFAULT_MIN_FPS_VALUE;
-            int maxFps = (m_numberOfFpsUpdates > 0) ? m_maxFpsValue : DEFAULT_MAX_FPS_VALUE;
 
-            dispatchOnFpsEvent(averageFps, minFps, maxFps);
+            collectFpsSamples();
+            closeFpsWindow(DEFAULT_FPS_SESSION, m_fpsSessions[DEFAULT_FPS_SESSION]);
+        }
 
-            if (m_lastFpsValue >= 0)
+        /**
+         * @brief Applies the report policy to a closed window. Must be called with m_callMutex held.
+         * @param session - The session the window belongs to.
+         * @param average - The average frame rate.
+         * @param min - The minimum frame rate.
+         * @param max - The maximum frame rate.
+         * @param now - Monotonic time in milliseconds.
+         * @return true if 'onFpsEvent' should be sent.
+         */
+        bool FrameRateImplementation::fpsReportDue(const FpsSession& session, int average, int min, int max, uint64_t now) const
+        {
+            if ((m_fpsReportDelta < 0) || !session.reported)
             {
-                // store the last fps value just in case there are no updates
-                m_minFpsValue = m_lastFpsValue;
-                m_maxFpsValue = m_lastFpsValue;
-                m_totalFpsValues = m_lastFpsValue;
-                m_numberOfFpsUpdates = 1;
+                return true;
+            }
+            if ((abs(average - session.reportedAverage) > m_fpsReportDelta)
+                || (abs(min - session.reportedMin) > m_fpsReportDelta)
+                || (abs(max - session.reportedMax) > m_fpsReportDelta))
+            {
+                return true;
+            }
+            return (m_fpsReportHeartbeatInMs > 0) && ((now - session.reportedAtInMs) >= static_cast<uint64_t>(m_fpsReportHeartbeatInMs));
+        }
+
+        /**
+         * @brief Stores the statistics of a closed collection window and dispatches 'onFpsEvent'
+         *        to the session's client, or to every registered client, if the report policy allows.
+         *        Must be called with m_callMutex held.
+         * @param sessionId - The session handle.
+         * @param session - The session with the closed window.
+         * @param average - The average frame rate.
+         * @param min - The minimum frame rate.
+         * @param max - The maximum frame rate.
+         * @param force - Report regardless of the policy, e.g. for the last window of a session.
+         * @return void
+         */
+        void FrameRateImplementation::reportFpsWindow(uint32_t sessionId, FpsSession& session, int average, int min, int max, bool force)
+        {
+            const uint64_t now = monotonicMilliseconds();
+            const FpsAccumulator::Snapshot& window = session.window;
+            const FramePacingStats::Summary pacing = session.pacing.Summarize();
+            FpsWindowStats stats;
+            stats.session = sessionId;
+            stats.timestamp = Core::Time::Now().Ticks() / Core::Time::TicksPerMillisecond;
+            stats.average = average;
+            stats.min = min;
+            stats.max = max;
+            stats.p1 = window.histogram.Percentile(1);
+            stats.p5 = window.histogram.Percentile(5);
+            stats.p50 = window.histogram.Percentile(50);
+            stats.p95 = window.histogram.Percentile(95);
+            stats.p99 = window.histogram.Percentile(99);
+            stats.frames = window.count;
+            stats.jankFrames = window.jank;
+            stats.meanIntervalUs = pacing.meanUs;
+            stats.intervalVarianceUs2 = pacing.varianceUs2;
+            stats.maxGapUs = pacing.maxGapUs;
+            stats.over150Percent = pacing.over150Percent;
+            stats.over200Percent = pacing.over200Percent;
+            stats.notified = force || fpsReportDue(session, average, min, max, now);
+            DBGINFO("session = %u, p1 = %d, p5 = %d, p50 = %d, p95 = %d, p99 = %d, jank = %llu.", sessionId, stats.p1, stats.p5,
+                    stats.p50, stats.p95, stats.p99, static_cast<unsigned long long>(window.jank));
+            if (pacing.intervals > 0)
+            {
+                DBGINFO("interval mean = %u us, variance = %llu us^2, max gap = %u us, >1.5x = %u, >2x = %u.",
+                        pacing.meanUs, static_cast<unsigned long long>(pacing.varianceUs2),
+                        pacing.maxGapUs, pacing.over150Percent, pacing.over200Percent);
+            }
+
+            if (sessionId == DEFAULT_FPS_SESSION)
+            {
+                m_lastFpsWindow = stats;
+            }
+            m_fpsHistory[m_fpsHistoryNext] = stats;
+            m_fpsHistoryNext = (m_fpsHistoryNext + 1) % m_fpsHistory.size();
+            m_fpsHistoryCount = std::min(m_fpsHistoryCount + 1, m_fpsHistory.size());
+
+            if (!stats.notified)
+            {
+                m_suppressedFpsEvents++;
+                DBGINFO("session = %u, unchanged window not reported (%llu suppressed).", sessionId,
+                        static_cast<unsigned long long>(m_suppressedFpsEvents));
+                return;
+            }
+            session.reported = true;
+            session.reportedAverage = average;
+            session.reportedMin = min;
+            session.reportedMax = max;
+            session.reportedAtInMs = now;
+
+            if (session.notification != nullptr)
+            {
+                session.notification->OnFpsEvent(average, min, max);
+                DBGINFO("session = %u, average = %d, min = %d, max = %d.", sessionId, average, min, max);
             }
             else
             {
-                m_minFpsValue = DEFAULT_MIN_FPS_VALUE;
-                m_maxFpsValue = DEFAULT_MAX_FPS_VALUE;
-                m_totalFpsValues = 0;
-                m_numberOfFpsUpdates = 0;
+                dispatchOnFpsEvent(average, min, max);
             }
         }
 
@@ -566,6 +1429,8 @@ namespace WPEFramework
         void FrameRateImplementation::OnDisplayFrameratePostChange(const std::string& frameRate)
         {
             LOGINFO("Received OnDisplayFrameratePostChange callback");
+            cacheDisplayFrameRate(frameRate);
+            updateRefreshPeriod(frameRate);
             Core::IWorkerPool::Instance().Submit(FrameRateImplementation::Job::Create(FrameRateImplementation::_instance,
                                     FrameRateImplementation::DSMGR_EVENT_DISPLAY_FRAMRATE_POSTCHANGE,
                                     frameRate));
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #include "Module.h"
 
@@ -28,10 +31,16 @@
 #include <plugins/plugins.h>
 #include <interfaces/Ids.h>
 #include <interfaces/IFrameRate.h>
+#include <interfaces/IConfiguration.h>
 #include "tracing/Logging.h"
 
 #include "tptimer.h"
+#include "UtilsNotificationRegistry.h"
 #include "libIARM.h"
+#include "FpsAccumulator.h"
+#include "FramePacingStats.h"
+#include "FpsSampleRing.h"
+#include "interfaces/IFrameRateStatistics.h"
 
 /* Display Events from libds Library */
 #include "dsTypes.h"
@@ -39,7 +48,7 @@
 
 namespace WPEFramework {
     namespace Plugin {
-        class FrameRateImplementation : public Exchange::IFrameRate, public device::Host::IVideoDeviceEvents {
+        class FrameRateImplementation : public Exchange::IFrameRate, public Exchange::IConfiguration, public Exchange::IFrameRateStatistics, public device::Host::IVideoDeviceEvents {
 
             public:
                 // We do not allow this plugin to be copied !!
@@ -54,6 +63,8 @@ namespace WPEFramework {
 
                 BEGIN_INTERFACE_MAP(FrameRateImplementation)
                     INTERFACE_ENTRY(Exchange::IFrameRate)
+                    INTERFACE_ENTRY(Exchange::IConfiguration)
+                    INTERFACE_ENTRY(Exchange::IFrameRateStatistics)
                 END_INTERFACE_MAP
 
             public:
@@ -102,7 +113,38 @@ namespace WPEFramework {
                         JsonValue _params;
                 };
 
+            private:
+                class Config : public Core::JSON::Container {
+                    public:
+                        Config(const Config&) = delete;
+                        Config& operator=(const Config&) = delete;
+
+                        Config()
+                            : Core::JSON::Container()
+                              , SampleRing()
+                              , SampleRingCapacity()
+                              , HistorySize()
+                              , ReportDelta()
+                              , ReportHeartbeat()
+                        {
+                            Add(_T("samplering"), &SampleRing);
+                            Add(_T("sampleringcapacity"), &SampleRingCapacity);
+                            Add(_T("historysize"), &HistorySize);
+                            Add(_T("reportdelta"), &ReportDelta);
+                            Add(_T("reportheartbeat"), &ReportHeartbeat);
+                        }
+
+                        Core::JSON::String SampleRing;
+                        Core::JSON::DecUInt32 SampleRingCapacity;
+                        Core::JSON::DecUInt32 HistorySize;
+                        Core::JSON::DecUInt32 ReportDelta;
+                        Core::JSON::DecUInt32 ReportHeartbeat;
+                };
+
             public:
+                // IConfiguration interface
+                uint32_t Configure(PluginHost::IShell* service) override;
+
                 virtual Core::hresult Register(Exchange::IFrameRate::INotification *notification) override;
                 virtual Core::hresult Unregister(Exchange::IFrameRate::INotification *notification) override;
 
@@ -117,17 +159,32 @@ namespace WPEFramework {
                 Core::hresult UpdateFps(int newFpsValue, bool& success) override;
                 //End methods
 
+                //Begin FPS statistics methods
+                Core::hresult UpdateFpsBatch(const uint16_t length, const uint64_t timestamps[], const int fps[], bool& success) override;
+                Core::hresult GetFpsPercentiles(int& p1, int& p5, int& p50, int& p95, int& p99, uint64_t& jankFrames, bool& success) override;
+                Core::hresult SetJankThreshold(const int threshold, bool& success) override;
+                Core::hresult UpdateFramePresentTimes(const uint16_t length, const uint64_t timestamps[], bool& success) override;
+                Core::hresult GetFramePacing(uint32_t& meanIntervalUs, uint64_t& intervalVarianceUs2, uint32_t& maxGapUs,
+                        uint32_t& over150Percent, uint32_t& over200Percent, bool& success) override;
+                Core::hresult GetFpsHistory(const uint64_t sinceTimestamp, IFpsWindowIterator*& history, bool& success) override;
+                //End FPS statistics methods
+
+                //Begin FPS session methods
+                Core::hresult StartFpsSession(Exchange::IFrameRate::INotification* notification, const int frequency, uint32_t& sessionId, bool& success) override;
+                Core::hresult StopFpsSession(const uint32_t sessionId, bool& success) override;
+                Core::hresult SetFpsReportPolicy(const int delta, const int heartbeatInMs, bool& success) override;
+                //End FPS session methods
+
                 void onReportFpsTimer();
 
                 static FrameRateImplementation* _instance;
 
             private:
                 std::shared_ptr<WPEFramework::JSONRPC::LinkType<WPEFramework::Core::JSON::IElement>> m_systemServiceConnection;
-                mutable Core::CriticalSection _adminLock;
                 Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> _engine;
                 Core::ProxyType<RPC::CommunicatorClient> _communicatorClient;
                 PluginHost::IShell* _service;
-                std::list<Exchange::IFrameRate::INotification*> _framerateNotification;
+                Utils::NotificationRegistry<Exchange::IFrameRate::INotification> _framerateNotification;
 
                 //Begin Notifications
                 void dispatchOnFpsEvent(int average, int min, int max);
@@ -137,16 +194,81 @@ namespace WPEFramework {
 
                 void DispatchDSMGRDisplayFramerateChangeEvent(Event event, const JsonValue params);
 
+            private:
+                // One collection window owner: the StartFpsCollection window (session 0) or a client session.
+                struct FpsSession {
+                    FpsSession()
+                        : notification(nullptr)
+                        , frequencyInMs(0)
+                        , active(false)
+                        , windowStartInMs(0)
+                        , window()
+                        , pacing()
+                        , lastFpsValue(-1)
+                        , reported(false)
+                        , reportedAverage(0)
+                        , reportedMin(0)
+                        , reportedMax(0)
+                        , reportedAtInMs(0)
+                    {
+                    }
+
+                    Exchange::IFrameRate::INotification* notification; // nullptr reports to every registered client
+                    int frequencyInMs;
+                    bool active;
+                    uint64_t windowStartInMs;
+                    FpsAccumulator::Snapshot window;
+                    FramePacingStats::Totals pacing;
+                    int lastFpsValue; // carried into the next window, -1 before the session got a sample
+                    // last 'onFpsEvent' sent, for the report policy
+                    bool reported;
+                    int reportedAverage;
+                    int reportedMin;
+                    int reportedMax;
+                    uint64_t reportedAtInMs;
+                };
+
+                void onFpsTimerTick();
+                void collectFpsSamples();
+                void closeFpsWindow(uint32_t sessionId, FpsSession& session);
+                void updateReportTimer();
+                bool fpsSessionsActive(uint32_t sessionId) const;
+                void restartFramePacing();
+                bool fpsReportDue(const FpsSession& session, int average, int min, int max, uint64_t now) const;
+                void reportFpsWindow(uint32_t sessionId, FpsSession& session, int average, int min, int max, bool force);
+                void updateRefreshPeriod(const string& framerate);
+                device::VideoDevice* primaryVideoDevice();
+                template <typename CALL>
+                bool callVideoDevice(CALL call, bool& available);
+                void invalidateVideoDevice();
+                void cacheDisplayFrameRate(const string& framerate);
+                void recordFramePresentTimes(const uint64_t timestamps[], uint32_t length, std::vector<int>& fpsValues);
+                void addFpsValues(const std::vector<int>& fpsValues);
+                void drainSampleRing();
+
             private:
                 int m_fpsCollectionFrequencyInMs;
-                int m_minFpsValue;
-                int m_maxFpsValue;
-                int m_totalFpsValues;
-                int m_numberOfFpsUpdates;
-                bool m_fpsCollectionInProgress;
+                FpsAccumulator m_fpsAccumulator;
+                std::map<uint32_t, FpsSession> m_fpsSessions;
+                uint32_t m_nextFpsSessionId;
                 TpTimer m_reportFpsTimer;
-                int m_lastFpsValue;
+                int m_reportFpsTimerPeriodInMs;
+                int m_fpsReportDelta;
+                int m_fpsReportHeartbeatInMs;
+                uint64_t m_suppressedFpsEvents;
+                std::atomic<int> m_lastFpsValue;
+                FpsWindowStats m_lastFpsWindow;
+                std::vector<FpsWindowStats> m_fpsHistory;
+                size_t m_fpsHistoryNext;
+                size_t m_fpsHistoryCount;
+                FramePacingStats m_framePacing;
+                std::mutex m_pacingMutex;
+                FpsSampleRing m_sampleRing;
+                uint64_t m_sampleRingDropped;
                 std::mutex m_callMutex;
+                device::List<device::VideoDevice> m_videoDevices;
+                string m_displayFrameRate;
+                std::mutex m_displayFrameRateMutex;
                 friend class Job;
 
             public:
@@ -0,0 +1,114 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2019 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#pragma once
+
+#include "Module.h"
+
+// @stubgen:include <interfaces/IFrameRate.h>
+#include <interfaces/Ids.h>
+#include <interfaces/IFrameRate.h>
+
+namespace WPEFramework {
+namespace Exchange {
+
+    // Next free ids of the FrameRate block of <interfaces/Ids.h>, they move there with the interface.
+    enum IDS_FRAMERATE_STATISTICS : uint32_t {
+        ID_FRAMERATE_STATISTICS = ID_FRAMERATE + 2,
+        ID_FRAMERATE_STATISTICS_WINDOW_ITERATOR = ID_FRAMERATE + 3
+    };
+
+    // FPS statistics of the FrameRate plugin, marshalled by the FrameRate proxy/stubs.
+    struct EXTERNAL IFrameRateStatistics : virtual public Core::IUnknown {
+        enum { ID = ID_FRAMERATE_STATISTICS };
+
+        ~IFrameRateStatistics() override = default;
+
+        struct FpsWindowStats {
+            uint32_t session; // 0 for the StartFpsCollection window
+            uint64_t timestamp; // end of the window, milliseconds since epoch
+            int average;
+            int min;
+            int max;
+            int p1;
+            int p5;
+            int p50;
+            int p95;
+            int p99;
+            uint64_t frames;
+            uint64_t jankFrames;
+            uint32_t meanIntervalUs;
+            uint64_t intervalVarianceUs2;
+            uint32_t maxGapUs;
+            uint32_t over150Percent;
+            uint32_t over200Percent;
+            bool notified; // false if the report policy suppressed 'onFpsEvent'
+        };
+
+        using IFpsWindowIterator = RPC::IIteratorType<FpsWindowStats, ID_FRAMERATE_STATISTICS_WINDOW_ITERATOR>;
+
+        // @brief Updates the FPS value with a batch of timestamped samples in one call
+        // @param timestamps: Presentation time of every sample in monotonic microseconds
+        // @param fps: The FPS value of every sample
+        virtual Core::hresult UpdateFpsBatch(const uint16_t length, const uint64_t timestamps[] /* @in @length:length */,
+            const int fps[] /* @in @length:length */, bool& success /* @out */) = 0;
+
+        // @brief Returns the FPS percentiles and jank frame count of the last completed collection window
+        // @param p1: The 1st percentile FPS, -1 if the window had no samples
+        // @param jankFrames: Number of samples below the jank threshold
+        virtual Core::hresult GetFpsPercentiles(int& p1 /* @out */, int& p5 /* @out */, int& p50 /* @out */, int& p95 /* @out */, int& p99 /* @out */,
+            uint64_t& jankFrames /* @out */, bool& success /* @out */) = 0;
+
+        // @brief Sets the FPS value below which a sample is counted as a jank frame
+        // @param threshold: The jank threshold in frames per second, default is 30
+        virtual Core::hresult SetJankThreshold(const int threshold, bool& success /* @out */) = 0;
+
+        // @brief Frame pacing mode: records frame-present timestamps
+        // @param timestamps: Frame-present times in monotonic microseconds, strictly increasing
+        virtual Core::hresult UpdateFramePresentTimes(const uint16_t length, const uint64_t timestamps[] /* @in @length:length */,
+            bool& success /* @out */) = 0;
+
+        // @brief Returns the frame-interval statistics of the last completed collection window
+        // @param meanIntervalUs: Mean frame interval in microseconds, 0 if no intervals were recorded
+        // @param over150Percent: Intervals exceeding 1.5x the display refresh period
+        // @param over200Percent: Intervals exceeding 2x the display refresh period
+        virtual Core::hresult GetFramePacing(uint32_t& meanIntervalUs /* @out */, uint64_t& intervalVarianceUs2 /* @out */, uint32_t& maxGapUs /* @out */,
+            uint32_t& over150Percent /* @out */, uint32_t& over200Percent /* @out */, bool& success /* @out */) = 0;
+
+        // @brief Returns the retained collection window summaries newer than sinceTimestamp, oldest first
+        // @param sinceTimestamp: Only windows that ended after this time (milliseconds since epoch) are returned, 0 for all
+        virtual Core::hresult GetFpsHistory(const uint64_t sinceTimestamp, IFpsWindowIterator*& history /* @out */, bool& success /* @out */) = 0;
+
+        // @brief Starts an FPS collection session with its own window length
+        // @param notification: The client that receives the session's 'onFpsEvent', nullptr for every registered client
+        // @param frequency: The window length in milliseconds, min is 100ms
+        // @param sessionId: The session handle for StopFpsSession
+        virtual Core::hresult StartFpsSession(IFrameRate::INotification* notification, const int frequency, uint32_t& sessionId /* @out */,
+            bool& success /* @out */) = 0;
+
+        // @brief Stops an FPS collection session, its partial window is reported if it has samples
+        virtual Core::hresult StopFpsSession(const uint32_t sessionId, bool& success /* @out */) = 0;
+
+        // @brief Sets when a collection window is worth an 'onFpsEvent'
+        // @param delta: Report only when average, min or max moved by more than this many FPS since the last reported window, -1 to report every window
+        // @param heartbeatInMs: With a delta, still report after this many milliseconds without an event, 0 for never
+        virtual Core::hresult SetFpsReportPolicy(const int delta, const int heartbeatInMs, bool& success /* @out */) = 0;
+    };
+
+} // namespace Exchange
+} // namespace WPEFramework
@@ -18,9 +18,12 @@
  */
 
 #pragma once
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include <core/Portability.h>
 #include <core/Timer.h>
@@ -40,7 +43,9 @@
  *        - Scheduled without any clients awaiting.
  *
  * IMPORTANT: This class is not thread-safe. It expects thread safety
- *            from the instantiating class.
+ *            from the instantiating class. Only the bookkeeping of who
+ *            responded (FirstResponse, Unacknowledged, LastAcknowledged) may
+ *            be read from the completion handler on the timer thread.
  */
 class AckController : public std::enable_shared_from_this<AckController> {
     using PowerState = WPEFramework::Exchange::IPowerManager::PowerState;
@@ -57,6 +62,8 @@ public:
         , _timeout(WPEFramework::Core::Time::Now())
         , _handler(nullptr)
         , _running(false)
+        , _started(std::chrono::steady_clock::now())
+        , _lastAcknowledged(0)
     {
     }
 
@@ -89,6 +96,7 @@ public:
      */
     void AckAwait(const uint32_t clientId)
     {
+        std::lock_guard<std::mutex> lock(_lock);
         _pending.insert(clientId);
         LOGINFO("Append clientId: %u, transactionId: %d, pending %d", clientId, _transactionId, int(_pending.size()));
     }
@@ -104,8 +112,11 @@ public:
     uint32_t Ack(const uint32_t clientId, const int transactionId)
     {
         uint32_t status = WPEFramework::Core::ERROR_NONE;
+        bool complete   = false;
+        size_t pending  = 0;
 
         do {
+            std::lock_guard<std::mutex> lock(_lock);
 
             if (transactionId != _transactionId) {
                 LOGERR("Invalid transactionId: %d", transactionId);
@@ -121,18 +132,69 @@ public:
             }
 
             _pending.erase(clientId);
+            _lastAcknowledged = clientId;
+            pending           = _pending.size();
 
             if (_pending.empty() && _running) {
                 _running = false;
-                runHandler(false);
+                complete = true;
             }
         } while (false);
 
+        // the handler may read the bookkeeping, run it without _lock
+        if (complete) {
+            runHandler(false);
+        }
+
         LOGINFO("AckController::Ack: clientId: %u, transactionId: %d, status: %d, pending %d",
-            clientId, transactionId, status, int(_pending.size()));
+            clientId, transactionId, status, int(pending));
         return status;
     }
 
+    /**
+     * @brief Marks the first response (acknowledgement or delay request) of an awaited client.
+     * @param clientId The ID of the client.
+     * @param transactionId The transaction ID associated with the client.
+     * @param elapsedMs Time since this transition started.
+     * @return true on the first response of an awaited client to this transaction, otherwise false.
+     */
+    bool FirstResponse(const uint32_t clientId, const int transactionId, uint32_t& elapsedMs)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if ((transactionId != _transactionId) || (_pending.find(clientId) == _pending.cend())
+            || (false == _responded.insert(clientId).second)) {
+            return false;
+        }
+        elapsedMs = ElapsedMs();
+        return true;
+    }
+
+    /**
+     * @brief Time since this transition started (the controller was created).
+     */
+    uint32_t ElapsedMs() const
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _started).count());
+    }
+
+    /**
+     * @brief Gets the clients that have not acknowledged (yet).
+     */
+    std::vector<uint32_t> Unacknowledged() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return std::vector<uint32_t>(_pending.cbegin(), _pending.cend());
+    }
+
+    /**
+     * @brief Gets the client that acknowledged last, 0 if none.
+     */
+    uint32_t LastAcknowledged() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _lastAcknowledged;
+    }
+
     /**
      * @brief Removes the expectation to await an acknowledgement from the given client.
      * @param clientId The ID of the client.
@@ -329,6 +391,10 @@ private:
     TimerJob _timerJob;                           // job scheduler to timeout
     std::function<void(bool, bool)> _handler;     // Completion handler to be called on timeout or all acknowledgements.
     std::atomic<bool> _running;                   // Flag to synchronize timer timeout callback and Ack* APIs.
+    const std::chrono::steady_clock::time_point _started; // Transition start, for response latencies.
+    mutable std::mutex _lock;                     // Guards _pending, _responded and _lastAcknowledged.
+    std::unordered_set<uint32_t> _responded;      // Clients that acked or asked for a delay.
+    uint32_t _lastAcknowledged;                   // Client that acked last.
 
     static int _nextTransactionId; // static counter for unique transaction ID generation.
 };
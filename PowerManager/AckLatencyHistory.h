@@ -0,0 +1,145 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// latest responses remembered per client
+#define ACK_HISTORY_SIZE 32
+// responses needed before a client's own p99 is trusted, until then it gets the maximum timeout
+#define ACK_HISTORY_MIN_SAMPLES 5
+
+/**
+ * @class AckLatencyHistory
+ * @brief Per-client history of how long pre-change clients took to respond
+ *        (PowerModePreChangeComplete or DelayPowerModeChangeBy), and the
+ *        transition timeout derived from it:
+ *        max over the awaited clients of (p99 + margin), clamped to [minimum, maximum].
+ *
+ *        Thread safe.
+ */
+class AckLatencyHistory {
+public:
+    AckLatencyHistory(const uint32_t minimumMs, const uint32_t maximumMs, const uint32_t marginMs)
+        : _lock()
+        , _clients()
+        , _minimumMs(std::min(minimumMs, maximumMs))
+        , _maximumMs(maximumMs)
+        , _marginMs(marginMs)
+    {
+    }
+
+    AckLatencyHistory(const AckLatencyHistory&)            = delete;
+    AckLatencyHistory& operator=(const AckLatencyHistory&) = delete;
+
+    /**
+     * @brief Records how long a client took to respond; a client that did not respond
+     *        at all is recorded with the time it was waited for.
+     */
+    void Record(const uint32_t clientId, const uint32_t latencyMs)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        Samples& samples = _clients[clientId];
+        if (samples.values.size() < ACK_HISTORY_SIZE) {
+            samples.values.push_back(latencyMs);
+        } else {
+            samples.values[samples.next] = latencyMs;
+        }
+        samples.next = (samples.next + 1) % ACK_HISTORY_SIZE;
+    }
+
+    void Remove(const uint32_t clientId)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _clients.erase(clientId);
+    }
+
+    /**
+     * @brief 99th percentile response time of a client.
+     * @return false if there are fewer than ACK_HISTORY_MIN_SAMPLES responses of the client.
+     */
+    bool P99(const uint32_t clientId, uint32_t& p99Ms) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return P99Locked(clientId, p99Ms);
+    }
+
+    /**
+     * @brief Timeout for a transition awaiting the given clients.
+     * @param culprit the client that determined the timeout (0 if none)
+     */
+    uint32_t Timeout(const std::unordered_set<uint32_t>& clients, uint32_t& culprit) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        uint32_t timeoutMs = 0;
+        culprit            = 0;
+
+        for (const uint32_t clientId : clients) {
+            uint32_t p99Ms  = 0;
+            uint32_t needed = _maximumMs;
+            if (P99Locked(clientId, p99Ms)) {
+                needed = std::min(p99Ms + _marginMs, _maximumMs);
+            }
+            if ((culprit == 0) || (needed > timeoutMs)) {
+                timeoutMs = needed;
+                culprit   = clientId;
+            }
+        }
+        return std::max(timeoutMs, _minimumMs);
+    }
+
+private:
+    struct Samples {
+        Samples()
+            : values()
+            , next(0)
+        {
+        }
+
+        std::vector<uint32_t> values; // ring of the latest ACK_HISTORY_SIZE
+        size_t next;
+    };
+
+    bool P99Locked(const uint32_t clientId, uint32_t& p99Ms) const
+    {
+        const auto samples = _clients.find(clientId);
+        if ((samples == _clients.end()) || (samples->second.values.size() < ACK_HISTORY_MIN_SAMPLES)) {
+            return false;
+        }
+        std::vector<uint32_t> sorted(samples->second.values);
+        // nearest rank
+        const size_t rank = ((sorted.size() * 99) + 99) / 100;
+        std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+        p99Ms = sorted[rank - 1];
+        return true;
+    }
+
+private:
+    mutable std::mutex _lock;
+    std::unordered_map<uint32_t, Samples> _clients;
+    const uint32_t _minimumMs;
+    const uint32_t _maximumMs;
+    const uint32_t _marginMs;
+};
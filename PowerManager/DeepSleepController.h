@@ -70,8 +70,6 @@ public:
     {
         _isDeepSleepTimeoutSet = true;
         _settings.SetDeepSleepTimeout(timeout);
-
-        _settings.Save();
     }
 
     uint32_t timeout() const
@@ -44,11 +44,12 @@ PowerController::PowerController(DeepSleepController& deepSleep, std::unique_ptr
     , _powerStateBeforeReboot(PowerState::POWER_STATE_UNKNOWN)
     , _lastKnownPowerState(PowerState::POWER_STATE_ON)
     , _settings(Settings::Load(m_settingsFile))
+    , _settingsWriter(new SettingsWriter(m_settingsFile))
     , _deepSleepWakeupSettings(_settings)
     , _workerPool(WPEFramework::Core::WorkerPool::Instance())
     , _deepSleep(deepSleep)
 #ifdef OFFLINE_MAINT_REBOOT
-    , _rebootController(_settings)
+    , _rebootController(_settings, *_settingsWriter)
 #endif
 {
     ASSERT(nullptr != _platform);
@@ -99,7 +100,7 @@ void PowerController::init()
             util::str(currentState));
 
         _settings.SetPowerState(currentState);
-        _settings.Save(m_settingsFile);
+        _settingsWriter->Schedule(_settings);
     } while (false);
 }
 
@@ -120,7 +121,7 @@ uint32_t PowerController::SetPowerState(const int keyCode, const PowerState powe
         LOGERR("Failed to set power state: %u", errCode);
     } else {
         _settings.SetPowerState(powerState);
-        _settings.Save(m_settingsFile);
+        _settingsWriter->Schedule(_settings);
         _lastKnownPowerState = curState;
     }
 
@@ -129,6 +130,8 @@ uint32_t PowerController::SetPowerState(const int keyCode, const PowerState powe
 
 uint32_t PowerController::ActivateDeepSleep()
 {
+    // the device may not come back from deep sleep
+    _settingsWriter->Flush();
     return _deepSleep.Activate(_deepSleepWakeupSettings.timeout(), _settings.nwStandbyMode());
 }
 
@@ -150,7 +153,8 @@ uint32_t PowerController::SetNetworkStandbyMode(const bool standbyMode)
 
         _settings.SetNwStandbyMode(standbyMode);
 
-        bool ok = _settings.Save(m_settingsFile);
+        _settingsWriter->Schedule(_settings);
+        bool ok = _settingsWriter->Flush();
 
         if (!ok) {
             LOGERR("Failed to save settings");
@@ -217,11 +221,14 @@ uint32_t PowerController::GetWakeupSourceConfig(std::list<WPEFramework::Exchange
 
 uint32_t PowerController::Reboot(const string& requestor, const string& reasonCustom, const string& reasonOther)
 {
+    _settingsWriter->Flush();
+
     _workerPool.Submit(LambdaJob::Create([requestor, reasonCustom, reasonOther]() {
         v_secure_system("echo 0 > /opt/.rebootFlag");
 
         LOGINFO("------------FINAL REBOOT NOTICE----------\n\tRebooting device requestor: %s, reasonCustom: %s, reasonOther: %s",
             requestor.c_str(), reasonCustom.c_str(), reasonOther.c_str());
+        Utils::Logging::Flush();
         if (0 == access("/rebootNow.sh", F_OK)) {
             v_secure_system("/rebootNow.sh -s '%s' -r '%s' -o '%s'", requestor.c_str(), reasonCustom.c_str(), reasonOther.c_str());
         } else {
@@ -235,6 +242,6 @@ uint32_t PowerController::Reboot(const string& requestor, const string& reasonCu
 uint32_t PowerController::SetDeepSleepTimer(const int timeOut)
 {
     _deepSleepWakeupSettings.SetTimeout(timeOut);
-    _settings.Save(m_settingsFile);
+    _settingsWriter->Schedule(_settings);
     return WPEFramework::Core::ERROR_NONE;
 }
@@ -31,7 +31,7 @@
 
 #include "DeepSleepController.h" // for DeepSleepController (ptr only)
 #include "RebootController.h"    // for RebootController
-#include "Settings.h"            // for Settings
+#include "Settings.h"            // for Settings, SettingsWriter
 #include "hal/PowerImpl.h"       // for IPlatform, PowerImpl
 
 namespace WPEFramework {
@@ -109,6 +109,7 @@ private:
     PowerState _powerStateBeforeReboot;
     PowerState _lastKnownPowerState;
     Settings _settings;
+    std::unique_ptr<SettingsWriter> _settingsWriter; // saves _settings off the transition path
     DeepSleepWakeupSettings _deepSleepWakeupSettings;
     WPEFramework::Core::IWorkerPool& _workerPool;
 
@@ -17,14 +17,17 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 
 #include "PowerManagerImplementation.h"
 
+#include "LambdaJob.h"
 #include "PowerUtils.h"
 #include "UtilsIarm.h"
 #include "UtilsLogging.h"
+#include "UtilsTelemetry.h"
 
 #include <core/Portability.h>
 #include <interfaces/IPowerManager.h>
@@ -43,6 +46,28 @@ uint32_t WPEFramework::Plugin::PowerManagerImplementation::_nextClientId
 #define POWER_MODE_PRECHANGE_TIMEOUT_SEC 1
 #endif
 
+// The pre-change timeout is the p99 response time of the slowest awaited client plus a margin, clamped to
+// [MIN, MAX]; clients with too little history get MAX. Clients are told it rounded up to whole seconds.
+#ifndef POWER_MODE_PRECHANGE_TIMEOUT_MIN_MS
+#define POWER_MODE_PRECHANGE_TIMEOUT_MIN_MS 200
+#endif
+#ifndef POWER_MODE_PRECHANGE_TIMEOUT_MAX_MS
+#define POWER_MODE_PRECHANGE_TIMEOUT_MAX_MS (POWER_MODE_PRECHANGE_TIMEOUT_SEC * 1000)
+#endif
+#ifndef POWER_MODE_PRECHANGE_TIMEOUT_MARGIN_MS
+#define POWER_MODE_PRECHANGE_TIMEOUT_MARGIN_MS 100
+#endif
+
+// how long a dispatch waits for each (not degraded) client to process an event
+#ifndef POWER_NOTIFICATION_DEADLINE_MS
+#define POWER_NOTIFICATION_DEADLINE_MS 500
+#endif
+
+// how often the notification latencies of the clients are logged, 0 to log them only on shutdown
+#ifndef POWER_NOTIFICATION_LATENCY_REPORT_SEC
+#define POWER_NOTIFICATION_LATENCY_REPORT_SEC 3600
+#endif
+
 // Device is considered to be in transient deep sleep state if
 // 1. As per PowerManager PowerState is DEEP_SLEEP, but then SoC is not in deepsleep
 // 2. SoC woke-up from deep sleep even before schedule timeout
@@ -62,127 +87,139 @@ namespace Plugin {
         , m_networkStandbyModeValid(false)
         , m_powerStateBeforeRebootValid(false)
         , _modeChangeController(nullptr)
+        , _ackLatencies(POWER_MODE_PRECHANGE_TIMEOUT_MIN_MS, POWER_MODE_PRECHANGE_TIMEOUT_MAX_MS, POWER_MODE_PRECHANGE_TIMEOUT_MARGIN_MS)
+        , _snapshot(std::make_shared<PowerSnapshot>())
+        , _snapshotLock()
+        , _latencyReportJob()
         , _deepSleepController(DeepSleepController::Create(*this))
         , _powerController(PowerController::Create(_deepSleepController))
         , _thermalController(ThermalController::Create(*this))
     {
         PowerManagerImplementation::_instance = this;
         Utils::IARM::init();
+        Utils::Telemetry::init();
+        publishSnapshot([this](PowerSnapshot& snapshot) {
+            _powerController.GetPowerState(snapshot.powerState, snapshot.prevPowerState);
+            _powerController.GetNetworkStandbyMode(snapshot.nwStandbyMode);
+        });
+        if (POWER_NOTIFICATION_LATENCY_REPORT_SEC > 0) {
+            _latencyReportJob = LambdaJob::Create([this]() {
+                logNotificationLatencies();
+                scheduleLatencyReport();
+            });
+            scheduleLatencyReport();
+        }
         LOGINFO(">> CTOR <<");
     }
 
     PowerManagerImplementation::~PowerManagerImplementation()
     {
         LOGINFO(">> DTOR <<");
+        if (_latencyReportJob.IsValid()) {
+            Core::WorkerPool::Instance().Revoke(_latencyReportJob);
+            _latencyReportJob.Release();
+        }
+        logNotificationLatencies();
     }
 
+    void PowerManagerImplementation::scheduleLatencyReport()
+    {
+        Core::WorkerPool::Instance().Schedule(Core::Time::Now().Add(POWER_NOTIFICATION_LATENCY_REPORT_SEC * 1000), _latencyReportJob);
+    }
+
+    // Clients are called concurrently, each on its own worker pool job, and the dispatch waits up to
+    // POWER_NOTIFICATION_DEADLINE_MS for them; the events are captured by value as a job may outlive it.
+    // DEEP_SLEEP is the exception: the device suspends right after, so every client, degraded ones
+    // included, is waited for without a deadline.
     void PowerManagerImplementation::dispatchPowerModeChangedEvent(const PowerState& prevState, const PowerState& newState)
     {
         LOGINFO(">>");
-        _callbackLock.Lock();
-        for (auto& notification : _modeChangedNotifications) {
-            auto start = std::chrono::steady_clock::now();
-            notification->OnPowerModeChanged(prevState, newState);
-            auto elapsed = std::chrono::steady_clock::now() - start;
-            LOGINFO("client %p took %" PRId64 "ms to process IModeChanged event", notification, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        }
-        _callbackLock.Unlock();
+        const PowerState previous = prevState;
+        const PowerState current  = newState;
+        const uint32_t deadline = (PowerState::POWER_STATE_STANDBY_DEEP_SLEEP == newState) ? Core::infinite : POWER_NOTIFICATION_DEADLINE_MS;
+        _modeChangedNotifications.NotifyParallel([previous, current](Exchange::IPowerManager::IModeChangedNotification* notification) {
+            notification->OnPowerModeChanged(previous, current);
+        }, deadline, "IModeChanged");
         LOGINFO("<<");
     }
 
     void PowerManagerImplementation::dispatchDeepSleepTimeoutEvent(const uint32_t& timeout)
     {
         LOGINFO(">>");
-        _callbackLock.Lock();
-        for (auto& notification : _deepSleepTimeoutNotifications) {
-            auto start = std::chrono::steady_clock::now();
-            notification->OnDeepSleepTimeout(timeout);
-            auto elapsed = std::chrono::steady_clock::now() - start;
-            LOGINFO("client %p took %" PRId64 "ms to process IDeepSleepTimeout event", notification, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        }
-        _callbackLock.Unlock();
+        const uint32_t wakeupTimeout = timeout;
+        _deepSleepTimeoutNotifications.NotifyParallel([wakeupTimeout](Exchange::IPowerManager::IDeepSleepTimeoutNotification* notification) {
+            notification->OnDeepSleepTimeout(wakeupTimeout);
+        }, POWER_NOTIFICATION_DEADLINE_MS, "IDeepSleepTimeout");
         LOGINFO("<<");
     }
 
     void PowerManagerImplementation::dispatchRebootBeginEvent(const string& rebootRequestor, const std::string& rebootReasonCustom, const string& rebootReasonOther)
     {
         LOGINFO(">>");
-        _callbackLock.Lock();
-        for (auto& notification : _rebootNotifications) {
-            auto start = std::chrono::steady_clock::now();
+        _rebootNotifications.NotifyParallel([rebootReasonCustom, rebootReasonOther, rebootRequestor](Exchange::IPowerManager::IRebootNotification* notification) {
             notification->OnRebootBegin(rebootReasonCustom, rebootReasonOther, rebootRequestor);
-            auto elapsed = std::chrono::steady_clock::now() - start;
-            LOGINFO("client %p took %" PRId64 "ms to process IReboot event", notification, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        }
-        _callbackLock.Unlock();
+        }, POWER_NOTIFICATION_DEADLINE_MS, "IReboot");
         LOGINFO("<<");
     }
 
     void PowerManagerImplementation::dispatchThermalModeChangedEvent(const ThermalTemperature& currentThermalLevel, const ThermalTemperature& newThermalLevel, const float& currentTemperature)
     {
         LOGINFO(">>");
-        _callbackLock.Lock();
-        for (auto& notification : _thermalModeChangedNotifications) {
-            auto start = std::chrono::steady_clock::now();
-            notification->OnThermalModeChanged(currentThermalLevel, newThermalLevel, currentTemperature);
-            auto elapsed = std::chrono::steady_clock::now() - start;
-            LOGINFO("client %p took %" PRId64 "ms to process IThermalModeChanged event", notification, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        }
-        _callbackLock.Unlock();
+        const ThermalTemperature currentLevel = currentThermalLevel;
+        const ThermalTemperature newLevel     = newThermalLevel;
+        const float temperature               = currentTemperature;
+        _thermalModeChangedNotifications.NotifyParallel([currentLevel, newLevel, temperature](Exchange::IPowerManager::IThermalModeChangedNotification* notification) {
+            notification->OnThermalModeChanged(currentLevel, newLevel, temperature);
+        }, POWER_NOTIFICATION_DEADLINE_MS, "IThermalModeChanged");
         LOGINFO("<<");
     }
 
     void PowerManagerImplementation::dispatchNetworkStandbyModeChangedEvent(const bool& enabled)
     {
         LOGINFO(">>");
-        _callbackLock.Lock();
-        for (auto& notification : _networkStandbyModeChangedNotifications) {
-            auto start = std::chrono::steady_clock::now();
-            notification->OnNetworkStandbyModeChanged(enabled);
-            auto elapsed = std::chrono::steady_clock::now() - start;
-            LOGINFO("client %p took %" PRId64 "ms to process INetworkStandbyModeChanged event", notification, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        }
-        _callbackLock.Unlock();
+        const bool standbyMode = enabled;
+        _networkStandbyModeChangedNotifications.NotifyParallel([standbyMode](Exchange::IPowerManager::INetworkStandbyModeChangedNotification* notification) {
+            notification->OnNetworkStandbyModeChanged(standbyMode);
+        }, POWER_NOTIFICATION_DEADLINE_MS, "INetworkStandbyModeChanged");
         LOGINFO("<<");
     }
 
+    void PowerManagerImplementation::logNotificationLatencies() const
+    {
+        logLatencies(_modeChangedNotifications, "IModeChanged");
+        logLatencies(_preModeChangeNotifications, "IModePreChange");
+        logLatencies(_deepSleepTimeoutNotifications, "IDeepSleepTimeout");
+        logLatencies(_rebootNotifications, "IReboot");
+        logLatencies(_thermalModeChangedNotifications, "IThermalModeChanged");
+        logLatencies(_networkStandbyModeChangedNotifications, "INetworkStandbyModeChanged");
+    }
+
     template <typename T>
-    Core::hresult PowerManagerImplementation::Register(std::list<T*>& list, T* notification)
+    void PowerManagerImplementation::logLatencies(const Utils::NotificationRegistry<T>& registry, const char* event)
     {
-        uint32_t status = Core::ERROR_GENERAL;
+        for (const auto& latency : registry.Latencies()) {
+            LOGINFO("%s client %p: calls %" PRIu64 ", late %" PRIu64 ", avg %" PRIu64 "us, max %" PRIu64 "us, delivery avg %" PRIu64 "us, max %" PRIu64 "us, queued %u, missed %" PRIu64 "%s",
+                event, latency.sink, latency.calls, latency.late, latency.averageUs, latency.maxUs, latency.averageDeliveryUs, latency.maxDeliveryUs,
+                latency.queued, latency.missed, latency.degraded ? ", degraded" : "");
+        }
+    }
 
+    template <typename T>
+    Core::hresult PowerManagerImplementation::Register(Utils::NotificationRegistry<T>& registry, T* notification)
+    {
         ASSERT(nullptr != notification);
-        _callbackLock.Lock();
 
         // Make sure we can't register the same notification callback multiple times
-        if (std::find(list.begin(), list.end(), notification) == list.end()) {
-            list.push_back(notification);
-            notification->AddRef();
-            status = Core::ERROR_NONE;
-        }
-
-        _callbackLock.Unlock();
-        return status;
+        return (registry.Register(notification) ? Core::ERROR_NONE : Core::ERROR_GENERAL);
     }
 
     template <typename T>
-    Core::hresult PowerManagerImplementation::Unregister(std::list<T*>& list, const T* notification)
+    Core::hresult PowerManagerImplementation::Unregister(Utils::NotificationRegistry<T>& registry, const T* notification)
     {
-        uint32_t status = Core::ERROR_GENERAL;
-
         ASSERT(nullptr != notification);
-        _callbackLock.Lock();
 
         // Make sure we can't unregister the same notification callback multiple times
-        auto itr = std::find(list.begin(), list.end(), notification);
-        if (itr != list.end()) {
-            (*itr)->Release();
-            list.erase(itr);
-            status = Core::ERROR_NONE;
-        }
-
-        _callbackLock.Unlock();
-        return status;
+        return (registry.Unregister(notification) ? Core::ERROR_NONE : Core::ERROR_GENERAL);
     }
 
     Core::hresult PowerManagerImplementation::Register(Exchange::IPowerManager::IRebootNotification* notification)
@@ -281,15 +318,22 @@ namespace Plugin {
         return errorCode;
     }
 
+    void PowerManagerImplementation::publishSnapshot(const std::function<void(PowerSnapshot&)>& update) const
+    {
+        std::lock_guard<std::mutex> lock(_snapshotLock);
+        std::shared_ptr<PowerSnapshot> next = std::make_shared<PowerSnapshot>(*std::atomic_load(&_snapshot));
+        update(*next);
+        std::atomic_store(&_snapshot, std::shared_ptr<const PowerSnapshot>(next));
+    }
+
     Core::hresult PowerManagerImplementation::GetPowerState(PowerState& currentState, PowerState& prevState) const
     {
         LOGINFO(">>");
 
-        _apiLock.Lock();
-
-        uint32_t errorCode = _powerController.GetPowerState(currentState, prevState);
-
-        _apiLock.Unlock();
+        const std::shared_ptr<const PowerSnapshot> snapshot(std::atomic_load(&_snapshot));
+        currentState       = snapshot->powerState;
+        prevState          = snapshot->prevPowerState;
+        uint32_t errorCode = Core::ERROR_NONE;
 
         LOGINFO("<< currentState : %s, prevState : %s, errorCode = %d", util::str(currentState), util::str(prevState), errorCode);
 
@@ -305,8 +349,12 @@ namespace Plugin {
             return errorCode;
         }
 
-        // We don't do a thread switching here, as it may move device to deep sleep mode
-        // even before client receiving the event
+        publishSnapshot([this](PowerSnapshot& snapshot) {
+            _powerController.GetPowerState(snapshot.powerState, snapshot.prevPowerState);
+        });
+
+        // Dispatched on this thread and, for DEEP_SLEEP, waited for by every client without a
+        // deadline, so no client misses the event before the device suspends below
         dispatchPowerModeChangedEvent(prevState, newState);
 
         LOGINFO("keyCode: %d, prevState: %s, newState: %s, reason: %s, errorcode: %u", keyCode, util::str(prevState), util::str(newState), reason.c_str(), errorCode);
@@ -339,9 +387,16 @@ namespace Plugin {
     //    - Nested state change requests for same state change requests (ex ON over ON) is silently ignored (i,e old state change request is not cancelled)
     // 3. To enforce state change, sync run model is intrduced where selfLock is held until state change is complete.
     //    - This was introduced because immerse ui was not launching if there is a direct transition from DEEP_SLEEP => ON (see RDKEMW-5633)
+    // 4. Requests are coalesced
+    //    - Of the requests waiting for selfLock only the latest one is processed, the others are replaced by it and
+    //      return ERROR_ABORTED without changing the state
+    //    - A request for the current state aborts the pending state change request (ex ON => STANDBY => ON)
     Core::hresult PowerManagerImplementation::SetPowerState(const int keyCode, const PowerState newState, const string& reason)
     {
         static WPEFramework::Core::BinairySemaphore selfLock{ 1, 1 };
+        static std::atomic<uint32_t> latestRequest{ 0 };
+
+        const uint32_t request = ++latestRequest;
 
         PowerState currState = POWER_STATE_UNKNOWN;
         PowerState prevState = POWER_STATE_UNKNOWN;
@@ -355,6 +410,13 @@ namespace Plugin {
 
         LOGINFO("selfLock Acquired");
 
+        if (request != latestRequest) {
+            LOGINFO("Request for %s replaced by a later request", util::str(newState));
+            selfLock.Unlock();
+            LOGINFO("selfLock Released isSync: na");
+            return Core::ERROR_ABORTED;
+        }
+
         uint32_t errorCode = GetPowerState(currState, prevState);
 
         // Cannot determine current state, won't be able to process request
@@ -410,8 +472,17 @@ namespace Plugin {
                 _modeChangeController->AckAwait(client.first);
             }
 
-            // For sync state change requests timeout is `0`
-            const uint32_t timeOut = isSync ? 0 : POWER_MODE_PRECHANGE_TIMEOUT_SEC;
+            // For sync state change requests timeout is `0`, otherwise it's derived from how fast the awaited clients responded before.
+            // The transition waits exactly that long; clients are told the ceiling in whole seconds, the unit of stateChangeAfter.
+            // A client that needs longer than its history suggests asks for it with DelayPowerModeChangeBy.
+            uint32_t slowestClient   = 0;
+            const uint32_t timeOutMs = isSync ? 0 : _ackLatencies.Timeout(_modeChangeController->Pending(), slowestClient);
+            const uint32_t timeOut   = (timeOutMs + 999) / 1000;
+            LOGINFO("transactionId: %d, timeout: %u ms (clients told %u s), slowest client: %u", transactionId, timeOutMs, timeOut, slowestClient);
+
+            // for the completion handler's telemetry
+            const std::unordered_map<uint32_t, std::string> clients = _modeChangeClients;
+            const std::weak_ptr<PreModeChangeController> controller = _modeChangeController;
 
             // Like in `Job` class we avoid impl destruction before handler is invoked
             this->AddRef();
@@ -430,11 +501,16 @@ namespace Plugin {
             //  3. ACK TIMER thread if `Schedule` timed-out
             //     - To avoid race conditions in this usecase, take `_apiLock` to run completion handler
             //  4. Caller thread of last acknowledging client
-            _modeChangeController->Schedule(timeOut * 1000,
-                [this, keyCode, currState, newState, reason, isSync](bool isTimedout, bool isAborted) mutable {
+            _modeChangeController->Schedule(timeOutMs,
+                [this, keyCode, currState, newState, reason, isSync, timeOutMs, clients, controller](bool isTimedout, bool isAborted) mutable {
                     LOGINFO(">> CompletionHandler isTimedout: %d, isAborted: %d", isTimedout, isAborted);
 
                     if (!isAborted) {
+                        // held by _modeChangeController or, on timeout, by the timer
+                        std::shared_ptr<PreModeChangeController> self = controller.lock();
+                        if (self) {
+                            reportPowerModePreChange(*self, clients, newState, timeOutMs, isTimedout);
+                        }
                         powerModePreChangeCompletionHandler(keyCode, currState, newState, reason);
                     } else {
                         LOGWARN("modeChangeController was already deleted, do not process CompletionHandler");
@@ -452,7 +528,16 @@ namespace Plugin {
                     LOGINFO("<< CompletionHandler");
                 });
         } else {
-            LOGINFO("Requested power state is same as current power state, no action required");
+            _apiLock.Lock();
+            if (_modeChangeController && _modeChangeController->IsRunning()) {
+                // requests cancelled out, completion handler is invoked as aborted
+                LOGINFO("Requested power state is current power state, abort state change request for %s state",
+                    util::str(_modeChangeController->powerState()));
+                _modeChangeController.reset();
+            } else {
+                LOGINFO("Requested power state is same as current power state, no action required");
+            }
+            _apiLock.Unlock();
         }
 
         // For Async state change requests, release the lock immediately, allowing nested state changes if required
@@ -470,17 +555,45 @@ namespace Plugin {
     void PowerManagerImplementation::submitPowerModePreChangeEvent(const PowerState currentState, const PowerState newState, const int transactionId, const int timeOut)
     {
         LOGINFO(">> currentState : %s, newState : %s, transactionId : %d", util::str(currentState), util::str(newState), transactionId);
-        for (auto& notification : _preModeChangeNotifications) {
-            Core::IWorkerPool::Instance().Submit(
-                PowerManagerImplementation::LambdaJob::Create(this,
-                    [notification, currentState, newState, transactionId, timeOut]() {
-                        notification->OnPowerModePreChange(currentState, newState, transactionId, timeOut);
-                    }));
-        }
+        // each client on its own worker pool job, the acks are collected by _modeChangeController
+        _preModeChangeNotifications.NotifyParallel([currentState, newState, transactionId, timeOut](Exchange::IPowerManager::IModePreChangeNotification* notification) {
+            notification->OnPowerModePreChange(currentState, newState, transactionId, timeOut);
+        }, 0);
 
         LOGINFO("<< currentState : %s, newState : %s, transactionId : %d", util::str(currentState), util::str(newState), transactionId);
     }
 
+    void PowerManagerImplementation::reportPowerModePreChange(PreModeChangeController& controller, const std::unordered_map<uint32_t, std::string>& clients,
+        const PowerState newState, const uint32_t timeoutMs, const bool isTimedout)
+    {
+        const uint32_t elapsedMs = controller.ElapsedMs();
+        uint32_t culprit         = 0;
+        uint32_t unacknowledged  = 0;
+
+        if (isTimedout) {
+            for (const uint32_t clientId : controller.Unacknowledged()) {
+                uint32_t responseMs = 0;
+                // never responded: needs at least the time it was waited for
+                if (controller.FirstResponse(clientId, controller.TransactionId(), responseMs)) {
+                    _ackLatencies.Record(clientId, elapsedMs);
+                }
+                culprit = (culprit == 0) ? clientId : culprit;
+                unacknowledged++;
+            }
+        } else {
+            culprit = controller.LastAcknowledged();
+        }
+
+        const auto client      = clients.find(culprit);
+        const std::string name = (client != clients.end()) ? client->second : "none";
+        std::string message    = std::string("newState=") + util::str(newState) + " timeoutMs=" + std::to_string(timeoutMs)
+            + " elapsedMs=" + std::to_string(elapsedMs) + " timedOut=" + (isTimedout ? "1" : "0")
+            + " culprit=" + name + " unacknowledged=" + std::to_string(unacknowledged);
+
+        LOGINFO("pre-change %s", message.c_str());
+        Utils::Telemetry::sendMessage(const_cast<char*>("PWRMGR_PRECHANGE_INFO"), const_cast<char*>(message.c_str()));
+    }
+
     Core::hresult PowerManagerImplementation::GetTemperatureThresholds(float& high, float& critical) const
     {
         LOGINFO(">>");
@@ -548,14 +661,18 @@ namespace Plugin {
         LOGINFO(">>");
 
 #ifdef ENABLE_THERMAL_PROTECTION
-        _apiLock.Lock();
-
-        ThermalTemperature curLevel = THERMAL_TEMPERATURE_UNKNOWN;
-        float curTemperature        = 0;
+        const std::shared_ptr<const PowerSnapshot> snapshot(std::atomic_load(&_snapshot));
+        if (snapshot->temperatureSampled) {
+            temperature = snapshot->temperature;
+            errorCode   = Core::ERROR_NONE;
+        } else {
+            ThermalTemperature curLevel = THERMAL_TEMPERATURE_UNKNOWN;
+            float curTemperature        = 0;
 
-        errorCode   = _thermalController.GetThermalState(curLevel, curTemperature);
-        temperature = curTemperature;
-        _apiLock.Unlock();
+            // waits for the first sample if the thermal controller is taking it
+            errorCode   = _thermalController.GetThermalState(curLevel, curTemperature);
+            temperature = curTemperature;
+        }
 #else
         temperature = -1;
         errorCode   = Core::ERROR_GENERAL;
@@ -586,11 +703,31 @@ namespace Plugin {
     {
         LOGINFO(">>");
 
-        _apiLock.Lock();
+        // read from the device once per deep sleep
+        const std::shared_ptr<const PowerSnapshot> snapshot(std::atomic_load(&_snapshot));
+        uint32_t errorCode = Core::ERROR_NONE;
 
-        uint32_t errorCode = _deepSleepController.GetLastWakeupReason(wakeupReason);
+        if (snapshot->wakeupReasonRead) {
+            wakeupReason = snapshot->wakeupReason;
+        } else {
+            _apiLock.Lock();
 
-        _apiLock.Unlock();
+            const uint32_t deepSleepEnds = snapshot->deepSleepEnds;
+            errorCode = _deepSleepController.GetLastWakeupReason(wakeupReason);
+
+            if (Core::ERROR_NONE == errorCode) {
+                const WakeupReason reason = wakeupReason;
+                publishSnapshot([reason, deepSleepEnds](PowerSnapshot& next) {
+                    // unless a deep sleep ended meanwhile, the reason read is of the one before
+                    if (next.deepSleepEnds == deepSleepEnds) {
+                        next.wakeupReason     = reason;
+                        next.wakeupReasonRead = true;
+                    }
+                });
+            }
+
+            _apiLock.Unlock();
+        }
 
         LOGINFO("<< wakeupReason: %u, errorCode: %u", wakeupReason, errorCode);
 
@@ -642,6 +779,10 @@ namespace Plugin {
 
         uint32_t errorCode = _powerController.SetNetworkStandbyMode(standbyMode);
 
+        publishSnapshot([this](PowerSnapshot& snapshot) {
+            _powerController.GetNetworkStandbyMode(snapshot.nwStandbyMode);
+        });
+
         _apiLock.Unlock();
 
         if (Core::ERROR_NONE == errorCode) {
@@ -660,11 +801,8 @@ namespace Plugin {
     {
         LOGINFO(">>");
 
-        _apiLock.Lock();
-
-        uint32_t errorCode = _powerController.GetNetworkStandbyMode(standbyMode);
-
-        _apiLock.Unlock();
+        standbyMode        = std::atomic_load(&_snapshot)->nwStandbyMode;
+        uint32_t errorCode = Core::ERROR_NONE;
 
         LOGINFO("<< NwStandbyMode: %s, errorCode: %d",
             (standbyMode ? ("Enabled") : ("Disabled")), errorCode);
@@ -832,6 +970,10 @@ namespace Plugin {
         _apiLock.Lock();
 
         if (_modeChangeController) {
+            uint32_t responseMs = 0;
+            if (_modeChangeController->FirstResponse(clientId, transactionId, responseMs)) {
+                _ackLatencies.Record(clientId, responseMs);
+            }
             errorCode = _modeChangeController->Ack(clientId, transactionId);
         }
 
@@ -850,6 +992,11 @@ namespace Plugin {
         _apiLock.Lock();
 
         if (_modeChangeController) {
+            // asking for a delay is a response too, the delay itself is up to the client
+            uint32_t responseMs = 0;
+            if (_modeChangeController->FirstResponse(clientId, transactionId, responseMs)) {
+                _ackLatencies.Record(clientId, responseMs);
+            }
             errorCode = _modeChangeController->Reschedule(clientId, transactionId, delayPeriod * 1000);
         }
 
@@ -909,6 +1056,7 @@ namespace Plugin {
         if (it != _modeChangeClients.end()) {
             clientName = it->second;
             _modeChangeClients.erase(it);
+            _ackLatencies.Remove(clientId);
 
             // self-ack if called while power mode change is in progress
             if (_modeChangeController) {
@@ -926,6 +1074,7 @@ namespace Plugin {
 
     void PowerManagerImplementation::onDeepSleepTimerWakeup(const int wakeupTimeout)
     {
+        deepSleepEnded();
         LOGINFO(">> DeepSleep timedout: %d", wakeupTimeout);
         dispatchDeepSleepTimeoutEvent(wakeupTimeout);
 
@@ -937,6 +1086,8 @@ namespace Plugin {
 
     void PowerManagerImplementation::onDeepSleepUserWakeup(const bool userWakeup)
     {
+        deepSleepEnded();
+
         PowerState newState = PowerState::POWER_STATE_ON;
 
 #ifdef PLATCO_BOOTTO_STANDBY
@@ -949,6 +1100,8 @@ namespace Plugin {
 
     void PowerManagerImplementation::onDeepSleepFailed()
     {
+        deepSleepEnded();
+
         PowerState newState = PowerState::POWER_STATE_ON;
 
 #ifdef PLATCO_BOOTTO_STANDBY
@@ -969,6 +1122,23 @@ namespace Plugin {
         LOGINFO("<<");
     }
 
+    void PowerManagerImplementation::onThermalTemperatureSampled(const float temperature)
+    {
+        publishSnapshot([temperature](PowerSnapshot& snapshot) {
+            snapshot.temperature        = temperature;
+            snapshot.temperatureSampled = true;
+        });
+    }
+
+    void PowerManagerImplementation::deepSleepEnded()
+    {
+        // the wakeup reason is read from the device again
+        publishSnapshot([](PowerSnapshot& snapshot) {
+            snapshot.wakeupReasonRead = false;
+            snapshot.deepSleepEnds++;
+        });
+    }
+
     void PowerManagerImplementation::onDeepSleepForThermalChange()
     {
         /*Scheduled maintanace reboot is disabled. Instead state will change to LIGHT_SLEEP*/
@@ -21,7 +21,10 @@
 
 #include "Module.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <com/com.h>
@@ -31,6 +34,8 @@
 #include <interfaces/IPowerManager.h>
 
 #include "AckController.h"
+#include "AckLatencyHistory.h"
+#include "UtilsNotificationRegistry.h"
 
 // controllers
 #include "DeepSleepController.h"
@@ -145,6 +150,30 @@ namespace Plugin {
         static PowerManagerImplementation* _instance;
 
     private:
+        // What clients usually poll, in one consistent copy that is read without _apiLock
+        struct PowerSnapshot {
+            PowerSnapshot()
+                : powerState(PowerState::POWER_STATE_UNKNOWN)
+                , prevPowerState(PowerState::POWER_STATE_UNKNOWN)
+                , temperature(0)
+                , temperatureSampled(false)
+                , wakeupReason(WakeupReason::WAKEUP_REASON_UNKNOWN)
+                , wakeupReasonRead(false)
+                , deepSleepEnds(0)
+                , nwStandbyMode(false)
+            {
+            }
+
+            PowerState powerState;
+            PowerState prevPowerState;
+            float temperature;
+            bool temperatureSampled; // until then the thermal controller is asked
+            WakeupReason wakeupReason; // of the last deep sleep
+            bool wakeupReasonRead; // since the last deep sleep ended
+            uint32_t deepSleepEnds;
+            bool nwStandbyMode;
+        };
+
         PowerState m_powerStateBeforeReboot;
         bool m_networkStandbyMode;
         bool m_networkStandbyModeValid;
@@ -152,28 +181,41 @@ namespace Plugin {
 
         // lock to guard all apis of PowerManager
         mutable Core::CriticalSection _apiLock;
-        // lock to guard all notification from PowerManager to clients and also their callback register & unregister
-        mutable Core::CriticalSection _callbackLock;
 
         Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> _engine;
         Core::ProxyType<RPC::CommunicatorClient> _communicatorClient;
         PluginHost::IShell* _controller;
-        std::list<Exchange::IPowerManager::IRebootNotification*> _rebootNotifications;
-        std::list<Exchange::IPowerManager::IModePreChangeNotification*> _preModeChangeNotifications;
-        std::list<Exchange::IPowerManager::IModeChangedNotification*> _modeChangedNotifications;
-        std::list<Exchange::IPowerManager::IDeepSleepTimeoutNotification*> _deepSleepTimeoutNotifications;
-        std::list<Exchange::IPowerManager::INetworkStandbyModeChangedNotification*> _networkStandbyModeChangedNotifications;
-        std::list<Exchange::IPowerManager::IThermalModeChangedNotification*> _thermalModeChangedNotifications;
+        // notification sinks, dispatched without a lock (copy-on-write)
+        Utils::NotificationRegistry<Exchange::IPowerManager::IRebootNotification> _rebootNotifications;
+        Utils::NotificationRegistry<Exchange::IPowerManager::IModePreChangeNotification> _preModeChangeNotifications;
+        Utils::NotificationRegistry<Exchange::IPowerManager::IModeChangedNotification> _modeChangedNotifications;
+        Utils::NotificationRegistry<Exchange::IPowerManager::IDeepSleepTimeoutNotification> _deepSleepTimeoutNotifications;
+        Utils::NotificationRegistry<Exchange::IPowerManager::INetworkStandbyModeChangedNotification> _networkStandbyModeChangedNotifications;
+        Utils::NotificationRegistry<Exchange::IPowerManager::IThermalModeChangedNotification> _thermalModeChangedNotifications;
         std::shared_ptr<PreModeChangeController> _modeChangeController;
         std::unordered_map<uint32_t, std::string> _modeChangeClients;
+        AckLatencyHistory _ackLatencies; // of the pre-change clients, for the transition timeout
+        // replaced (copy-on-write) by the writers on change, readers only load it
+        mutable std::shared_ptr<const PowerSnapshot> _snapshot;
+        mutable std::mutex _snapshotLock; // serializes the writers
+        Core::ProxyType<Core::IDispatch> _latencyReportJob; // logNotificationLatencies() every POWER_NOTIFICATION_LATENCY_REPORT_SEC
 
         void dispatchPowerModeChangedEvent(const PowerState& currentState, const PowerState& newState);
         void dispatchDeepSleepTimeoutEvent(const uint32_t& timeout);
         void dispatchRebootBeginEvent(const string& rebootReasonCustom, const string& rebootReasonOther, const string& rebootRequestor);
         void dispatchThermalModeChangedEvent(const ThermalTemperature& currentThermalLevel, const ThermalTemperature& newThermalLevel, const float& currentTemperature);
         void dispatchNetworkStandbyModeChangedEvent(const bool& enabled);
+        // per-client calls, overruns, callback and delivery latency of every notification registry
+        void logNotificationLatencies() const;
+        void scheduleLatencyReport();
+        template <typename T>
+        static void logLatencies(const Utils::NotificationRegistry<T>& registry, const char* event);
 
         void submitPowerModePreChangeEvent(const PowerState currentState, const PowerState newState, const int transactionId, const int timeOut);
+        void reportPowerModePreChange(PreModeChangeController& controller, const std::unordered_map<uint32_t, std::string>& clients,
+            const PowerState newState, const uint32_t timeoutMs, const bool isTimedout);
+        void publishSnapshot(const std::function<void(PowerSnapshot&)>& update) const;
+        void deepSleepEnded();
         void powerModePreChangeCompletionHandler(const int keyCode, PowerState currentState, PowerState powerState, const std::string& reason);
         Core::hresult setDevicePowerState(const int& keyCode, PowerState currentState, PowerState powerState, const std::string& reason);
         inline bool isSyncStateChange(PowerState currState, PowerState newState) const;
@@ -184,11 +226,12 @@ namespace Plugin {
         virtual void onDeepSleepFailed() override;
         virtual void onThermalTemperatureChanged(const ThermalTemperature cur_Thermal_Level, const ThermalTemperature new_Thermal_Level, const float current_Temp) override;
         virtual void onDeepSleepForThermalChange() override;
+        virtual void onThermalTemperatureSampled(const float temperature) override;
 
         template <typename T>
-        Core::hresult Register(std::list<T*>& list, T* notification);
+        Core::hresult Register(Utils::NotificationRegistry<T>& registry, T* notification);
         template <typename T>
-        Core::hresult Unregister(std::list<T*>& list, const T* notification);
+        Core::hresult Unregister(Utils::NotificationRegistry<T>& registry, const T* notification);
 
         bool isWakeupSrcEnabled(const std::list<WakeupSourceConfig>& configs, WakeupSrcType src) const;
         Core::hresult setWakeupSourceConfig(const std::list<WakeupSourceConfig>& configs);
@@ -22,11 +22,11 @@
 #include <core/WorkerPool.h>
 
 #include "rfcapi.h"
-#include "secure_wrapper.h"
 
 #include "LambdaJob.h"
 #include "RebootController.h"
 #include "UtilsLogging.h"
+#include "UtilsSpawn.h"
 
 #define MAX_RFC_LEN 15
 
@@ -38,9 +38,10 @@ using Timestamp = std::chrono::steady_clock::time_point;
 using TimestampSec = std::chrono::time_point<std::chrono::steady_clock, std::chrono::seconds>;
 static constexpr const int HEARTBEAT_INTERVAL_SEC = 300;
 
-RebootController::RebootController(const Settings& settings)
+RebootController::RebootController(const Settings& settings, SettingsWriter& settingsWriter)
     : _workerPool(WPEFramework::Core::WorkerPool::Instance())
     , _settings(settings)
+    , _settingsWriter(settingsWriter)
     , _standbyRebootThreshold(86400 * 3, 300)
     , _forcedRebootThreshold(172800 * 3)
     , _rfcUpdated(false)
@@ -99,12 +100,20 @@ void RebootController::heartbeatMsg()
         if (_standbyRebootThreshold.IsThresholdExceeded(uptime)) {
             if (_standbyRebootThreshold.IsGraceIntervalExceeded(_settings.InactiveDuration())) {
                 LOGINFO("Going to reboot after %lld\n", uptime);
-                v_secure_system("sh /rebootNow.sh -s PwrMgr -o 'Standby Maintenance reboot'");
+                _settingsWriter.Flush();
+                Utils::Logging::Flush();
+                Utils::Spawn::Options options;
+                options.captureOutput = false;
+                Utils::Spawn::Run({ "sh", "/rebootNow.sh", "-s", "PwrMgr", "-o", "Standby Maintenance reboot" }, options);
             }
 
             if (_forcedRebootThreshold.IsThresholdExceeded(uptime)) {
                 LOGINFO("Going to force reboot after %lld\n", uptime);
-                v_secure_system("sh /rebootNow.sh -s PwrMgr -o 'Forced Maintenance reboot'");
+                _settingsWriter.Flush();
+                Utils::Logging::Flush();
+                Utils::Spawn::Options options;
+                options.captureOutput = false;
+                Utils::Spawn::Run({ "sh", "/rebootNow.sh", "-s", "PwrMgr", "-o", "Forced Maintenance reboot" }, options);
             }
         }
     }
@@ -81,7 +81,7 @@ class RebootController {
     };
 
 public:
-    RebootController(const Settings& settings);
+    RebootController(const Settings& settings, SettingsWriter& settingsWriter);
     ~RebootController();
 
 private:
@@ -93,6 +93,7 @@ private:
 private:
     WPEFramework::Core::IWorkerPool& _workerPool;
     const Settings& _settings;
+    SettingsWriter& _settingsWriter; // flushed before rebooting
     Threshold _standbyRebootThreshold;
     Threshold _forcedRebootThreshold;
     WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> _heartbeatJob;
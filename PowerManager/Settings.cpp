@@ -16,8 +16,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <sstream>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "plat_power.h"
 
@@ -34,8 +41,11 @@ class SettingsV1 {
 
     static constexpr const uint32_t UIMGR_SETTINGS_MAGIC = 0xFEBEEFAC;
     static constexpr const uint32_t PADDING_SIZE         = 32; // There is no strong reason to use padding, but maintained for compatibility
+    // in ledSettings.brightness of a record whose ledSettings.color is its CRC
+    static constexpr const uint32_t CRC_MARKER = 0x43524331; // "CRC1"
 
-    /*LED settings*/
+    /*LED settings, unused. Files saved by this version keep a CRC in them, older
+      versions ignore them so the layout, length and version stay those of V1*/
     typedef struct _PWRMgr_LED_Settings_t {
         unsigned int brightness;
         unsigned int color;
@@ -98,6 +108,20 @@ class SettingsV1 {
         }
     }
 
+    // CRC-32 (IEEE 802.3)
+    static uint32_t crc32(const void* data, const size_t length)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint32_t crc         = 0xFFFFFFFF;
+        for (size_t index = 0; index < length; index++) {
+            crc ^= bytes[index];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+
 public:
     inline static constexpr size_t Size()
     {
@@ -119,9 +143,11 @@ public:
             }
 
             const auto read_size = read(fd, &pwrSettings, expected_size);
-            if (read_size != expected_size) {
+            if (read_size != static_cast<ssize_t>(expected_size)) {
                 // failure
-                LOGERR("Unable to read full length expected: %zu, actual %zu", expected_size, read_size);
+                LOGERR("Unable to read full length expected: %zu, actual %zd", expected_size, read_size);
+            } else if ((CRC_MARKER == pwrSettings.ledSettings.brightness) && !crcMatches(pwrSettings)) {
+                LOGERR("Settings CRC mismatch, torn or corrupted write");
             } else {
                 settings._magic            = pwrSettings.magic;
                 settings._version          = pwrSettings.version;
@@ -140,30 +166,29 @@ public:
 
     static bool Save(int fd, Settings& settings)
     {
-        PWRMgr_Settings_t pwrSettings = {
-            .magic       = settings.magic(),
-            .version     = settings.version(),
-            .length      = Size(), // fixed for V1
-            .powerState  = conv(settings.powerState()),
-            .ledSettings = {
-                .brightness = 0, // unused, maintained for compatibility
-                .color      = 0  // unused, maintained for compatibility
-            },
-            .deep_sleep_timeout = settings.deepSleepTimeout(),
-            .nwStandbyMode      = settings.nwStandbyMode(),
-            .padding            = { 0 }
-        };
-
-        off_t ret = lseek(fd, 0, SEEK_SET);
-        if (ret == (off_t)-1) {
-            LOGERR("FATAL failed to reset seek offset %s", strerror(errno));
-            return false;
-        }
-
-        auto res = write(fd, &pwrSettings, Size());
-        if (res < 0) {
-            LOGERR("Failed to write settings %s", strerror(errno));
-            return false;
+        PWRMgr_Settings_t pwrSettings;
+        // no indeterminate padding in the CRC
+        memset(&pwrSettings, 0, sizeof(pwrSettings));
+
+        pwrSettings.magic                  = settings.magic();
+        pwrSettings.version                = static_cast<uint32_t>(Settings::Version::V1);
+        pwrSettings.length                 = Size(); // fixed for V1
+        pwrSettings.powerState             = conv(settings.powerState());
+        pwrSettings.ledSettings.brightness = CRC_MARKER;
+        pwrSettings.deep_sleep_timeout     = settings.deepSleepTimeout();
+        pwrSettings.nwStandbyMode          = settings.nwStandbyMode();
+        pwrSettings.ledSettings.color      = crc32(&pwrSettings, Size());
+
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&pwrSettings);
+        size_t written      = 0;
+        while (written < Size()) {
+            auto res = write(fd, data + written, Size() - written);
+            if (res > 0) {
+                written += static_cast<size_t>(res);
+            } else if ((res < 0) && (errno != EINTR)) {
+                LOGERR("Failed to write settings %s", strerror(errno));
+                return false;
+            }
         }
         return true;
     }
@@ -174,6 +199,15 @@ public:
         settings._magic   = UIMGR_SETTINGS_MAGIC;
         settings._version = static_cast<uint32_t>(Settings::Version::V1);
     }
+
+private:
+    // the CRC is of the record with ledSettings.color 0
+    static bool crcMatches(PWRMgr_Settings_t pwrSettings)
+    {
+        const uint32_t crc            = pwrSettings.ledSettings.color;
+        pwrSettings.ledSettings.color = 0;
+        return (crc == crc32(&pwrSettings, Size()));
+    }
 };
 
 using DefaultSettingsVersion = SettingsV1;
@@ -187,7 +221,7 @@ void Settings::initDefaults()
 Settings Settings::Load(const std::string& path)
 {
     Settings settings {};
-    int fd  = open(path.c_str(), O_CREAT | O_RDWR, S_IRWXU | S_IRUSR);
+    int fd  = open(path.c_str(), O_RDONLY | O_CLOEXEC);
     bool ok = false;
 
     if (fd >= 0) {
@@ -212,14 +246,15 @@ Settings Settings::Load(const std::string& path)
             LOGERR("no data in settings file");
         }
 
-        if (!ok) {
-            // failed to read settings file, init default settings
-            settings.initDefaults();
-            settings.save(fd);
-        }
-
-        fsync(fd);
         close(fd);
+    } else if (errno != ENOENT) {
+        LOGERR("Failed to open settings file %s", strerror(errno));
+    }
+
+    if (!ok) {
+        // missing or unreadable settings file, init default settings
+        settings.initDefaults();
+        settings.Save(path);
     }
 
     if (path == kRamSettingsFilePath) {
@@ -256,7 +291,8 @@ bool Settings::save(int fd)
 
 bool Settings::Save(const std::string& path)
 {
-    int fd = open(path.c_str(), O_CREAT | O_WRONLY, S_IRWXU | S_IRUSR);
+    const std::string temp = path + ".tmp";
+    int fd                 = open(temp.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, S_IRWXU | S_IRUSR);
 
     if (fd < 0) {
         LOGERR("Failed to open settings file %s", strerror(errno));
@@ -265,10 +301,25 @@ bool Settings::Save(const std::string& path)
 
     bool ok = save(fd);
 
-    fsync(fd);
-    close(fd);
+    ok = ok && (0 == fsync(fd));
+    ok = (0 == close(fd)) && ok;
+    ok = ok && (0 == rename(temp.c_str(), path.c_str()));
+    if (!ok) {
+        LOGERR("Failed to save settings file %s: %s", path.c_str(), strerror(errno));
+        unlink(temp.c_str());
+        return false;
+    }
+
+    // make the rename itself durable
+    const size_t slash          = path.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "." : ((slash == 0) ? "/" : path.substr(0, slash));
+    int dir                     = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
 
-    return ok;
+    return true;
 }
 
 void Settings::printDetails(const std::string& prefix) const
@@ -282,3 +333,100 @@ void Settings::printDetails(const std::string& prefix) const
     LOGINFO("Network Standby Mode: %s", _nwStandbyMode ? "Enabled" : "Disabled");
     LOGINFO("==================================================");
 }
+
+SettingsWriter::SettingsWriter(const std::string& path, uint32_t delayInMs)
+    : _path(path)
+    , _delayInMs(delayInMs)
+    , _lock()
+    , _fileLock()
+    , _scheduled()
+    , _pending()
+    , _stopping(false)
+    , _flusher()
+{
+    try {
+        _flusher = std::thread(&SettingsWriter::flushLoop, this);
+    } catch (const std::system_error&) {
+        LOGERR("Unable to start settings write-behind thread, saving synchronously");
+    }
+}
+
+SettingsWriter::~SettingsWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+    _scheduled.notify_all();
+    if (_flusher.joinable()) {
+        _flusher.join();
+    }
+    Flush();
+}
+
+void SettingsWriter::Schedule(const Settings& settings)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _pending.reset(new Settings(settings));
+    }
+
+    if (_flusher.joinable()) {
+        _scheduled.notify_all();
+    } else {
+        Flush();
+    }
+}
+
+bool SettingsWriter::Flush()
+{
+    // a newer copy scheduled meanwhile is saved by the next flush, never overwritten by an older one
+    std::lock_guard<std::mutex> fileLock(_fileLock);
+    std::unique_ptr<Settings> pending;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        pending = std::move(_pending);
+    }
+    if ((nullptr == pending) || pending->Save(_path)) {
+        return true;
+    }
+
+    // retried by the next flush, unless newer settings were scheduled meanwhile
+    std::lock_guard<std::mutex> lock(_lock);
+    if (nullptr == _pending) {
+        _pending = std::move(pending);
+    }
+    return false;
+}
+
+void SettingsWriter::flushLoop()
+{
+    typedef std::chrono::steady_clock Clock;
+    const uint32_t firstRetryInMs = std::max<uint32_t>(_delayInMs, 1);
+    uint32_t retryInMs = firstRetryInMs;
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true) {
+        _scheduled.wait(lock, [this]() { return (_stopping || (nullptr != _pending)); });
+        if (_stopping) {
+            break;
+        }
+
+        // later changes until then ride along with this save
+        const Clock::time_point due = Clock::now() + std::chrono::milliseconds(_delayInMs);
+        _scheduled.wait_until(lock, due, [this]() { return _stopping; });
+        if (_stopping) {
+            break;
+        }
+
+        lock.unlock();
+        const bool saved = Flush();
+        lock.lock();
+        if (saved) {
+            retryInMs = firstRetryInMs;
+        } else {
+            // don't hammer a failing file, an explicit Flush() still tries right away
+            _scheduled.wait_for(lock, std::chrono::milliseconds(retryInMs), [this]() { return _stopping; });
+            retryInMs = std::min<uint32_t>(retryInMs * 2, SETTINGS_RETRY_MAX_IN_MS);
+        }
+    }
+}
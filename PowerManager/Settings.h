@@ -19,12 +19,22 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include <core/Time.h>
 #include <interfaces/IPowerManager.h>
 #include <limits>
 
+// a scheduled save is written this long after the first unsaved change, later changes ride along
+#define SETTINGS_WRITE_BEHIND_IN_MS 500
+// a failing save is retried after twice as long each time, up to this
+#define SETTINGS_RETRY_MAX_IN_MS 60000
+
 class SettingsV1;
 
 class Settings {
@@ -57,9 +67,10 @@ class Settings {
 
 public:
     enum Version {
-        V1 = 1, // Current version
+        V1 = 1, // Current version, with a CRC in the unused LED settings
     };
     static Settings Load(const std::string& path = kSettingsFilePath);
+    // Replaces the file atomically: written to "<path>.tmp", fsync'ed and renamed over path
     bool Save(const std::string& path = kSettingsFilePath);
 
     inline void setMagic(const uint32_t magic) { _magic = magic; }
@@ -108,3 +119,38 @@ private:
 
     friend class SettingsV1;
 };
+
+/**
+ * Write-behind for Settings, keeps file writes off the power state transition path.
+ *
+ * Schedule() takes a copy of the settings; a background thread saves the
+ * latest copy SETTINGS_WRITE_BEHIND_IN_MS after the first unsaved one,
+ * backing off up to SETTINGS_RETRY_MAX_IN_MS while saving fails.
+ * Flush() saves a pending copy right away on the calling thread, e.g.
+ * before deep sleep or reboot. Pending settings are saved on destruction.
+ */
+class SettingsWriter {
+public:
+    explicit SettingsWriter(const std::string& path, uint32_t delayInMs = SETTINGS_WRITE_BEHIND_IN_MS);
+    ~SettingsWriter();
+
+    SettingsWriter(const SettingsWriter&) = delete;
+    SettingsWriter& operator=(const SettingsWriter&) = delete;
+
+    void Schedule(const Settings& settings);
+    // false if the pending settings could not be saved, they stay pending for the next flush
+    bool Flush();
+
+private:
+    void flushLoop();
+
+private:
+    const std::string _path;
+    const uint32_t _delayInMs;
+    std::mutex _lock;     // _pending, _stopping
+    std::mutex _fileLock; // serializes saves, taken before _lock
+    std::condition_variable _scheduled;
+    std::unique_ptr<Settings> _pending; // latest unsaved settings, nullptr if none
+    bool _stopping;
+    std::thread _flusher;
+};
@@ -17,8 +17,10 @@
  * limitations under the License.
  */
 
-#include "secure_wrapper.h"
+#include <fstream>
+
 #include "ThermalController.h"
+#include "UtilsSpawn.h"
 #include "rfcapi.h"
 
 ThermalController::ThermalController (INotification& parent, std::shared_ptr<IPlatform> platform)
@@ -190,11 +192,13 @@ bool ThermalController::isThermalProtectionEnabled()
 
 void ThermalController::logThermalShutdownReason()
 {
-    //command is echo THERMAL_SHUTDOWN_REASON > STANDBY_REASON_FILE
-    //int cmdSize =  strlen(THERMAL_SHUTDOWN_REASON) + strlen(STANDBY_REASON_FILE) + 10;
-    //char logCommand[cmdSize]= {'0'};
-    //snprintf(logCommand,cmdSize,"echo %s > %s",THERMAL_SHUTDOWN_REASON, STANDBY_REASON_FILE);
-    v_secure_system("echo %s > %s",THERMAL_SHUTDOWN_REASON, STANDBY_REASON_FILE);
+    // same as echo THERMAL_SHUTDOWN_REASON > STANDBY_REASON_FILE, without a shell
+    std::ofstream reasonFile(STANDBY_REASON_FILE, std::ios::trunc);
+    if (reasonFile) {
+        reasonFile << THERMAL_SHUTDOWN_REASON << std::endl;
+    } else {
+        LOGERR("Failed to write %s", STANDBY_REASON_FILE);
+    }
 }
 
 void ThermalController::rebootIfNeeded()
@@ -211,7 +215,9 @@ void ThermalController::rebootIfNeeded()
     if (m_cur_Thermal_Value >= rebootThreshold.critical)
     {
         LOGINFO("Rebooting is being forced!");
-        v_secure_system("/rebootNow.sh -s Power_Thermmgr -o 'Rebooting the box due to stb temperature greater than rebootThreshold critical...'");
+        Utils::Spawn::Options options;
+        options.captureOutput = false;
+        Utils::Spawn::Run({ "/rebootNow.sh", "-s", "Power_Thermmgr", "-o", "Rebooting the box due to stb temperature greater than rebootThreshold critical..." }, options);
     }
     else if (!_rebootZone && m_cur_Thermal_Value >= rebootThreshold.concern)
     {
@@ -233,7 +239,9 @@ void ThermalController::rebootIfNeeded()
         {
             LOGINFO("Rebooting since the temperature is still above critical level after %d seconds !! :  ",
             rebootThreshold.graceInterval);
-            v_secure_system("/rebootNow.sh -s Power_Thermmgr -o 'Rebooting the box as the stb temperature is still above critical level after 20 seconds...'");
+            Utils::Spawn::Options options;
+            options.captureOutput = false;
+            Utils::Spawn::Run({ "/rebootNow.sh", "-s", "Power_Thermmgr", "-o", "Rebooting the box as the stb temperature is still above critical level after 20 seconds..." }, options);
         }
         else {
             LOGINFO("Still in the reboot zone! Will go for reboot in %lu seconds unless the temperature falls below %u!", rebootThreshold.graceInterval-difftime, rebootThreshold.safe );
@@ -422,6 +430,7 @@ void ThermalController::pollThermalLevels()
                 LOGINFO("Current Temperature %d", (int)current_Temp );
             }
             m_cur_Thermal_Value = (int)current_Temp;
+            _parent.onThermalTemperatureSampled(m_cur_Thermal_Value);
 
             if (_stopThread) 
             {
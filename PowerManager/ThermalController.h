@@ -187,6 +187,8 @@ public:
 
             virtual void onThermalTemperatureChanged(const ThermalTemperature cur_Thermal_Level,const ThermalTemperature new_Thermal_Level, const float current_Temp) = 0;
             virtual void onDeepSleepForThermalChange() = 0;
+            // every successful temperature poll
+            virtual void onThermalTemperatureSampled(const float temperature) {}
     };
 
 private:
@@ -5,7 +5,7 @@
 #include "DeepSleep.h"
 #include "PowerUtils.h"
 #include "UtilsLogging.h"
-#include "secure_wrapper.h" // for v_secure_system
+#include "UtilsSpawn.h"
 
 class DeepSleepImpl : public hal::deepsleep::IPlatform {
     using WakeupReason = WPEFramework::Exchange::IPowerManager::WakeupReason;
@@ -118,7 +118,9 @@ public:
     {
         int32_t ret = -1;
         LOGINFO("Update the Deepsleep marker ");
-        ret = v_secure_system("sh /lib/rdk/alertSystem.sh deepSleepMgrMain SYST_INFO_devicetoDS");
+        ::Utils::Spawn::Options options;
+        options.captureOutput = false;
+        ret = ::Utils::Spawn::Run({ "sh", "/lib/rdk/alertSystem.sh", "deepSleepMgrMain", "SYST_INFO_devicetoDS" }, options).exitCode;
         if(ret != 0) {
             LOGERR("Failed to update the Deepsleep marker");
         }
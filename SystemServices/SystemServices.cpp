@@ -34,7 +34,6 @@
 #include "SystemServices.h"
 #include "StateObserverHelper.h"
 #include "uploadlogs.h"
-#include "secure_wrapper.h"
 #include <core/core.h>
 #include <core/JSON.h>
 #include<interfaces/entservices_errorcodes.h>
@@ -70,6 +69,7 @@
 #include "UtilsfileExists.h"
 #include "UtilsgetFileContent.h"
 #include "UtilsProcess.h"
+#include "UtilsSpawn.h"
 
 using namespace std;
 using namespace WPEFramework;
@@ -476,6 +476,7 @@ namespace WPEFramework {
          */
         SystemServices::SystemServices()
 	    : PluginHost::JSONRPCErrorAssessor<PluginHost::JSONRPCErrorAssessorTypes::FunctionCallbackType>(SystemServices::OnJSONRPCError)
+            , m_deviceStateFile(DEVICESTATE_FILE)
             , _pwrMgrNotification(*this)
             , _registeredEventHandlers(false)
         {
@@ -647,6 +648,9 @@ namespace WPEFramework {
 
             //Initialise timer with interval and callback function.
             m_operatingModeTimer.setInterval(updateDuration, MODE_TIMER_UPDATE_INTERVAL);
+            //mode_duration changes with every timer tick, write it behind instead of on each tick;
+            //the quiet period has to outlast a tick, so it's written every max delay while the timer runs
+            m_temp_settings.enableWriteBehind(2 * MODE_TIMER_UPDATE_INTERVAL);
 
             //first boot? then set to NORMAL mode
             if (!m_temp_settings.contains("mode") && m_currentMode == "") {
@@ -704,6 +708,7 @@ namespace WPEFramework {
 
             _registeredEventHandlers = false;
             m_operatingModeTimer.stop();
+            m_temp_settings.flush();
 #if defined(USE_IARMBUS) || defined(USE_IARM_BUS)
             DeinitializeIARM();
 #endif /* defined(USE_IARMBUS) || defined(USE_IARM_BUS) */
@@ -851,7 +856,7 @@ namespace WPEFramework {
             bool result = false;
             string fname = "nrdPluginApp";
 
-            nfxResult = Utils::killProcess(fname);
+            nfxResult = Utils::killProcessByName(fname);
             if (true == nfxResult) {
                 LOGINFO("SystemService shutting down Netflix...\n");
                 //give Netflix process some time to terminate gracefully.
@@ -1120,7 +1125,7 @@ namespace WPEFramework {
                  mocaFile.open(MOCA_FILE, ios::out);
                      if (mocaFile) {
                          mocaFile.close();
-                         eRetval = v_secure_system("/etc/init.d/moca_init start");
+                         eRetval = Utils::Spawn::Run({ "/etc/init.d/moca_init", "start" }).Succeeded() ? E_OK : E_NOK;
                      } else {
                          LOGERR("moca file open failed\n");
                          populateResponseWithError(SysSrv_FileAccessFailed, response);
@@ -1128,7 +1133,7 @@ namespace WPEFramework {
                  } else {
                      std::remove(MOCA_FILE);
                      if (!Utils::fileExists(MOCA_FILE)) {
-                         eRetval = v_secure_system("/etc/init.d/moca_init start");
+                         eRetval = Utils::Spawn::Run({ "/etc/init.d/moca_init", "start" }).Succeeded() ? E_OK : E_NOK;
                      } else {
                          LOGERR("moca file remove failed\n");
                          populateResponseWithError(SysSrv_FileAccessFailed, response);
@@ -1269,16 +1274,11 @@ namespace WPEFramework {
                 cmd += queryParams;
             }
 
-            std::string res = "";
-            FILE* pipe = v_secure_popen("r", "/lib/rdk/getDeviceDetails.sh %s %s", GET_STB_DETAILS_SCRIPT_READ_COMMAND, cmd.c_str());
-            if(pipe){
-              char buff[1024] = { '\0' };
-              while (fgets(buff, sizeof(buff), pipe)) {
-                    res += buff;
-                    memset(buff, 0, sizeof(buff));
-              }
-              v_secure_pclose(pipe);
+            std::vector<std::string> argv = { "/lib/rdk/getDeviceDetails.sh", GET_STB_DETAILS_SCRIPT_READ_COMMAND };
+            if (!cmd.empty()) {
+                argv.push_back(cmd);
             }
+            std::string res = Utils::Spawn::Run(argv).output;
             if (res.size() > 0) {
                 std::string model_number;
 		std::string device_type;
@@ -1501,10 +1501,9 @@ namespace WPEFramework {
                 JsonObject& response)
         {
             LOGWARN("SystemService updatingFirmware\n");
-            FILE* pipe = v_secure_popen("r", "/usr/bin/rdkvfwupgrader 0 4 >> /opt/logs/swupdate.log &");
-            if(pipe){
-               v_secure_pclose(pipe);
-            }
+            Utils::Spawn::Options options;
+            options.outputFile = "/opt/logs/swupdate.log";
+            Utils::Spawn::Detach({ "/usr/bin/rdkvfwupgrader", "0", "4" }, options);
             returnResponse(true);
         }
 
@@ -1697,8 +1696,10 @@ namespace WPEFramework {
                             }
                         }
                         //set values in temp file so they can be restored in receiver restarts / crashes
+                        m_temp_settings.beginTransaction();
                         m_temp_settings.setValue("mode", m_currentMode);
                         m_temp_settings.setValue("mode_duration", m_remainingDuration);
+                        m_temp_settings.commit();
                     } else {
                         LOGWARN("Current mode '%s' not changed", m_currentMode.c_str());
                     }
@@ -1837,14 +1838,15 @@ namespace WPEFramework {
         }
         
         // Function to read a parameter from a file and update its value
-        bool read_parameters(const string &filename, const string &param, bool &value) {
-            ifstream file(filename);
-        
-            // Check if the file was successfully opened
-            if (!file.is_open()) {
+        bool read_parameters(Utils::WatchedFile &watchedFile, const string &filename, const string &param, bool &value) {
+            string content;
+
+            // Served from the cache until the file changes
+            if (!watchedFile.Read(content)) {
                 LOGERR("Error opening file for reading: %s", filename.c_str());
                 return false;
             }
+            istringstream file(content);
         
             string line;
             bool param_found = false;
@@ -1867,7 +1869,6 @@ namespace WPEFramework {
                             value = false;
                         } else {
                             LOGERR("Error: Invalid value for parameter %s  in file: %s", param.c_str(), file_value.c_str());
-                            file.close();
                             return false;  // Invalid value
                         }
                         break;
@@ -1878,12 +1879,9 @@ namespace WPEFramework {
             // Check if there were any read errors
             if (file.fail() && !file.eof()) {
                 LOGERR("Error reading from file: %s", filename.c_str());
-                file.close();
                 return false;
             }
         
-            file.close();
-        
             if (!param_found) {
                 LOGERR("Parameter %s  not found in the file.", param.c_str());
 
@@ -2007,7 +2005,7 @@ namespace WPEFramework {
                 returnResponse(status);
             }
 
-            result = read_parameters(DEVICESTATE_FILE, BLOCKLIST, blocklistFlag);
+            result = read_parameters(m_deviceStateFile, DEVICESTATE_FILE, BLOCKLIST, blocklistFlag);
 		    if (result == true) {
                 LOGWARN("blocklistFlag=%d", blocklistFlag);
                 response["blocklist"] = blocklistFlag;
@@ -2137,7 +2135,9 @@ namespace WPEFramework {
                 }
             }
 
-            v_secure_system("/lib/rdk/xconfImageCheck.sh  >> /opt/logs/wpeframework.log");
+            Utils::Spawn::Options options;
+            options.outputFile = "/opt/logs/wpeframework.log";
+            Utils::Spawn::Run({ "/lib/rdk/xconfImageCheck.sh" }, options);
 
             //get xconf http code
             string httpCodeStr ="";
@@ -2870,17 +2870,7 @@ namespace WPEFramework {
             string tempBuffer;
 
             for (i = 0; i < sizeof(macTypeList)/sizeof(macTypeList[0]); i++) {
-                tempBuffer.clear();
-                FILE* pipe = v_secure_popen("r","/lib/rdk/getDeviceDetails.sh %s %s",GET_STB_DETAILS_SCRIPT_READ_COMMAND, macTypeList[i].c_str());
-                if (pipe) {
-                    char buff[1024] = { '\0' };
-                    while (fgets(buff, sizeof(buff), pipe)) {
-                           tempBuffer += buff;
-                           memset(buff, 0, sizeof(buff));
-                    }
-                     v_secure_pclose(pipe);
-
-               }
+                tempBuffer = Utils::Spawn::Run({ "/lib/rdk/getDeviceDetails.sh", GET_STB_DETAILS_SCRIPT_READ_COMMAND, macTypeList[i] }).output;
 
                 removeCharsFromString(tempBuffer, "\n\r");
                 LOGWARN("resp = %s\n", tempBuffer.c_str());
@@ -3363,26 +3353,8 @@ namespace WPEFramework {
         lock_guard<mutex> lck(m_uploadLogsMutex);
 
         if (-1 != m_uploadLogsPid) {
-            vector<int> processIds;
-            bool result = Utils::getChildProcessIDs(m_uploadLogsPid, processIds);
-
-            if (true == result) {
-                vector<int>::iterator pid_iterator = processIds.begin();
-                while (pid_iterator != processIds.end()) {
-                    std::string line = std::to_string(*pid_iterator);
-                    line = trim(line);
-                    char *end;
-                    int pid = strtol(line.c_str(), &end, 10);
-                    if (line.c_str() != end && 0 != pid && 1 != pid) {
-                        kill(pid, SIGKILL);
-                    } else {
-                        LOGERR("Bad pid: %d", pid);
-                    }
-                    pid_iterator++;
-                }
-
-            } else {
-                LOGERR("Cannot get the child process Ids\n");
+            if (!Utils::killChildProcesses(m_uploadLogsPid, SIGKILL)) {
+                LOGERR("Cannot kill the child processes of %d\n", m_uploadLogsPid);
             }
 
             kill(m_uploadLogsPid, SIGKILL);
@@ -38,6 +38,7 @@ using std::ofstream;
 #include "Module.h"
 #include "tracing/Logging.h"
 #include "UtilsThreadRAII.h"
+#include "UtilsFileWatch.h"
 #include "SystemServicesHelper.h"
 #include "platformcaps/platformcaps.h"
 #if defined(USE_IARMBUS) || defined(USE_IARM_BUS)
@@ -227,6 +228,7 @@ namespace WPEFramework {
                 pid_t m_uploadLogsPid;
                 std::mutex m_uploadLogsMutex;
                 std::mutex m_territoryMutex;
+                Utils::WatchedFile m_deviceStateFile;
                 PowerManagerInterfaceRef _powerManagerPlugin;
                 Core::Sink<PowerManagerNotification> _pwrMgrNotification;
                 bool _registeredEventHandlers;
@@ -32,7 +32,7 @@
 #include "UtilsFile.h"
 #include "UtilsString.h"
 #include "UtilsgetFileContent.h"
-#include <secure_wrapper.h>
+#include "UtilsSpawn.h"
 
 #define GET_STB_DETAILS_SCRIPT_READ_COMMAND "read"
 
@@ -175,24 +175,16 @@ namespace WPEFramework {
 
         string getModel()
         {
-            FILE* pipe = v_secure_popen("r", "/lib/rdk/getDeviceDetails.sh %s", GET_STB_DETAILS_SCRIPT_READ_COMMAND);
-            LOGWARN("%s: opened pipe for command /lib/rdk/getDeviceDetails.sh, with result: %s\n",
-                    __FUNCTION__ , pipe ? "success" : "failure");
-            if (!pipe) {
-                LOGERR("%s: SERVICEMANAGER_FILE_ERROR: Can't open pipe for command /lib/rdk/getDeviceDetails.sh for read mode: %s\n"
-                        , __FUNCTION__, strerror(errno));
+            const Utils::Spawn::Result spawned = Utils::Spawn::Run({ "/lib/rdk/getDeviceDetails.sh", GET_STB_DETAILS_SCRIPT_READ_COMMAND });
+            LOGWARN("%s: ran /lib/rdk/getDeviceDetails.sh, with result: %s\n",
+                    __FUNCTION__ , spawned.started ? "success" : "failure");
+            if (!spawned.started) {
+                LOGERR("%s: SERVICEMANAGER_FILE_ERROR: Can't run /lib/rdk/getDeviceDetails.sh: %s\n"
+                        , __FUNCTION__, strerror(spawned.error));
                 return "ERROR";
             }
 
-            char buffer[128] = {'\0'};
-            string result;
-
-            while (!feof(pipe)) {
-                if (fgets(buffer, 128, pipe) != NULL) {
-                    result += buffer;
-                }
-            }
-            v_secure_pclose(pipe);
+            const string& result = spawned.output;
 
             string tri = caseInsensitive(result);
             string ret = tri.c_str();
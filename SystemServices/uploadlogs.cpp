@@ -30,6 +30,7 @@
 
 #include "UtilsCStr.h"
 #include "UtilsLogging.h"
+#include "UtilsSpawn.h"
 #include "UtilsfileExists.h"
 #include "secure_wrapper.h"
 
@@ -138,35 +139,27 @@ pid_t logUploadAsync(void)
     if (E_NOK == getUploadLogParameters(tftp_server, upload_protocol, upload_httplink))
         return -1;
 
-    const char *argArray[] = {
+    const std::vector<std::string> argv = {
         "/bin/sh",
         "/lib/rdk/uploadSTBLogs.sh",
-        tftp_server.c_str(),
+        tftp_server,
         "0", //FLAG,
         "1", //DCM_FLAG,
         "0", //UploadOnReboot,
-        upload_protocol.c_str(),
-        upload_httplink.c_str(), 
-        "1",
-        0
+        upload_protocol,
+        upload_httplink,
+        "1"
     };
 
-    pid_t pid  = fork();
+    // posix_spawn, the caller waits for / kills the process
+    pid_t pid = Utils::Spawn::Start(argv);
 
     if (-1 == pid)
     {
-        LOGERR("Fork failed for %s", argArray[2]);
-    }
-    else if (0 == pid)
-    {
-        if (execve(argArray[0], (char **)argArray, environ) == -1)
-        {
-            LOGERR("Execve failed: %s", strerror(errno));
-            _Exit(127);
-        }
+        LOGERR("Spawn failed for %s", argv[2].c_str());
     }
 
-    LOGINFO("Started %d process with %s", pid, argArray[1]);
+    LOGINFO("Started %d process with %s", pid, argv[1].c_str());
 
     return pid;
 }
@@ -0,0 +1,41 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2025 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "UtilsSpawn.h"
+
+class SpawnImplMock : public Utils::Spawn::IImplementation {
+public:
+    ~SpawnImplMock() override = default;
+
+    MOCK_METHOD(Utils::Spawn::Result, Run, (const std::vector<std::string>& argv, const Utils::Spawn::Options& options), (override));
+};
+
+// what Run() returns for a process that exited with exitCode and printed output
+inline Utils::Spawn::Result SpawnResult(int exitCode, const std::string& output = std::string())
+{
+    Utils::Spawn::Result result;
+    result.started = true;
+    result.exitCode = exitCode;
+    result.output = output;
+    return result;
+}
@@ -24,6 +24,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 #include "FrameRate.h"
 
@@ -44,6 +46,23 @@ using namespace WPEFramework;
 
 using ::testing::NiceMock;
 
+static uint32_t GetFpsHistoryWindows(uint64_t since, std::vector<Exchange::IFrameRateStatistics::FpsWindowStats>& history, bool& success)
+{
+    history.clear();
+    Exchange::IFrameRateStatistics::IFpsWindowIterator* windows = nullptr;
+    uint32_t result = Plugin::FrameRateImplementation::_instance->GetFpsHistory(since, windows, success);
+    if (nullptr != windows)
+    {
+        Exchange::IFrameRateStatistics::FpsWindowStats stats;
+        while (windows->Next(stats))
+        {
+            history.push_back(stats);
+        }
+        windows->Release();
+    }
+    return result;
+}
+
 class FrameRateTest : public ::testing::Test {
 protected:
     Core::ProxyType<Plugin::FrameRate> plugin;
@@ -592,6 +611,518 @@ TEST_F(FrameRateTest, OnReportFpsTimer_SingleUpdate)
     notificationHandler->Release();
 }
 
+TEST_F(FrameRateTest, OnReportFpsTimer_ConcurrentUpdates)
+{
+    L1FrameRateNotificationHandler* notificationHandler = new L1FrameRateNotificationHandler();
+
+    if (Plugin::FrameRateImplementation::_instance != nullptr)
+    {
+        Plugin::FrameRateImplementation::_instance->Register(notificationHandler);
+
+        std::vector<std::thread> producers;
+        for (int fps = 50; fps <= 70; fps += 10)
+        {
+            producers.emplace_back([fps]() {
+                bool success;
+                for (int i = 0; i < 1000; i++)
+                {
+                    Plugin::FrameRateImplementation::_instance->UpdateFps(fps, success);
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+        EXPECT_TRUE(notificationHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+        EXPECT_EQ(60, notificationHandler->GetLastAverage());
+        EXPECT_EQ(50, notificationHandler->GetLastMin());
+        EXPECT_EQ(70, notificationHandler->GetLastMax());
+
+        Plugin::FrameRateImplementation::_instance->Unregister(notificationHandler);
+    }
+
+    notificationHandler->Release();
+}
+
+TEST_F(FrameRateTest, GetFpsPercentiles_AfterReport)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    bool success = false;
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->SetJankThreshold(40, success));
+    EXPECT_TRUE(success);
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, Plugin::FrameRateImplementation::_instance->SetJankThreshold(-1, success));
+
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+    for (int i = 0; i < 100; i++)
+    {
+        Plugin::FrameRateImplementation::_instance->UpdateFps((i < 3) ? 20 : 60, success);
+    }
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    int p1 = 0, p5 = 0, p50 = 0, p95 = 0, p99 = 0;
+    uint64_t jankFrames = 0;
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->GetFpsPercentiles(p1, p5, p50, p95, p99, jankFrames, success));
+    EXPECT_TRUE(success);
+    EXPECT_EQ(20, p1);
+    EXPECT_EQ(60, p5);
+    EXPECT_EQ(60, p50);
+    EXPECT_EQ(60, p99);
+    EXPECT_EQ(3u, jankFrames);
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+}
+
+TEST_F(FrameRateTest, GetFpsPercentiles_JsonRpc)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setJankThreshold"), _T("{\"threshold\":40}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("setJankThreshold"), _T("{\"threshold\":-1}"), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsCollection"), _T("{}"), response));
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFps"), (i < 3) ? _T("{\"newFpsValue\":20}") : _T("{\"newFpsValue\":60}"), response));
+    }
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFpsPercentiles"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"p1\":20") != string::npos);
+    EXPECT_TRUE(response.find("\"p50\":60") != string::npos);
+    EXPECT_TRUE(response.find("\"jankFrames\":3") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsCollection"), _T("{}"), response));
+}
+
+TEST_F(FrameRateTest, UpdateFpsBatch_MatchesPerSampleUpdates)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+    L1FrameRateNotificationHandler* notificationHandler = new L1FrameRateNotificationHandler();
+    Plugin::FrameRateImplementation::_instance->Register(notificationHandler);
+
+    const uint64_t timestamps[] = { 1000, 17666, 34333, 51000, 67666 };
+    const int fps[] = { 60, 58, 24, 61, 60 };
+    bool success = false;
+
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+    for (const int value : fps)
+    {
+        Plugin::FrameRateImplementation::_instance->UpdateFps(value, success);
+    }
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    EXPECT_TRUE(notificationHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+    int average = notificationHandler->GetLastAverage();
+    int min = notificationHandler->GetLastMin();
+    int max = notificationHandler->GetLastMax();
+    int p1 = 0, p5 = 0, p50 = 0, p95 = 0, p99 = 0;
+    uint64_t jankFrames = 0;
+    Plugin::FrameRateImplementation::_instance->GetFpsPercentiles(p1, p5, p50, p95, p99, jankFrames, success);
+
+    notificationHandler->Reset();
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->UpdateFpsBatch(5, timestamps, fps, success));
+    EXPECT_TRUE(success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    EXPECT_TRUE(notificationHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+    EXPECT_EQ(average, notificationHandler->GetLastAverage());
+    EXPECT_EQ(min, notificationHandler->GetLastMin());
+    EXPECT_EQ(max, notificationHandler->GetLastMax());
+
+    int batchP1 = 0, batchP5 = 0, batchP50 = 0, batchP95 = 0, batchP99 = 0;
+    uint64_t batchJankFrames = 0;
+    Plugin::FrameRateImplementation::_instance->GetFpsPercentiles(batchP1, batchP5, batchP50, batchP95, batchP99, batchJankFrames, success);
+    EXPECT_EQ(p1, batchP1);
+    EXPECT_EQ(p50, batchP50);
+    EXPECT_EQ(p99, batchP99);
+    EXPECT_EQ(jankFrames, batchJankFrames);
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+    Plugin::FrameRateImplementation::_instance->Unregister(notificationHandler);
+    notificationHandler->Release();
+}
+
+TEST_F(FrameRateTest, UpdateFpsBatch_InvalidSample)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    const uint64_t timestamps[] = { 1000, 17666 };
+    const int fps[] = { 60, -1 };
+    bool success = true;
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, Plugin::FrameRateImplementation::_instance->UpdateFpsBatch(2, timestamps, fps, success));
+    EXPECT_FALSE(success);
+}
+
+TEST_F(FrameRateTest, UpdateFpsBatch_JsonRpc)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+    L1FrameRateNotificationHandler* notificationHandler = new L1FrameRateNotificationHandler();
+    Plugin::FrameRateImplementation::_instance->Register(notificationHandler);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsCollection"), _T("{}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFpsBatch"),
+        _T("{\"samples\":[{\"timestamp\":1000,\"fps\":50},{\"timestamp\":17666,\"fps\":70},{\"timestamp\":34333,\"fps\":60}]}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("updateFpsBatch"),
+        _T("{\"samples\":[{\"timestamp\":51000,\"fps\":-1}]}"), response));
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("updateFpsBatch"),
+        _T("{\"samples\":[{\"fps\":60}]}"), response));
+
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    EXPECT_TRUE(notificationHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+    EXPECT_EQ(60, notificationHandler->GetLastAverage());
+    EXPECT_EQ(50, notificationHandler->GetLastMin());
+    EXPECT_EQ(70, notificationHandler->GetLastMax());
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsCollection"), _T("{}"), response));
+    Plugin::FrameRateImplementation::_instance->Unregister(notificationHandler);
+    notificationHandler->Release();
+}
+
+TEST_F(FrameRateTest, UpdateFramePresentTimes_PacingStatistics)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+    ON_CALL(*p_videoDeviceMock, getCurrentDisframerate(::testing::_))
+        .WillByDefault(::testing::DoAll(
+            ::testing::SetArrayArgument<0>("1920x1080x60", "1920x1080x60" + 13),
+            ::testing::Return(0)));
+
+    bool success = false;
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+
+    // 16.667ms cadence with one 40ms (>2x) and one 30ms (>1.5x) gap
+    const uint64_t timestamps[] = { 1000000, 1016667, 1033334, 1073334, 1090001, 1120001, 1136668 };
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->UpdateFramePresentTimes(7, timestamps, success));
+    EXPECT_TRUE(success);
+
+    const uint64_t stale[] = { 1136668 };
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, Plugin::FrameRateImplementation::_instance->UpdateFramePresentTimes(1, stale, success));
+
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    uint32_t meanIntervalUs = 0, maxGapUs = 0, over150Percent = 0, over200Percent = 0;
+    uint64_t intervalVarianceUs2 = 0;
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->GetFramePacing(meanIntervalUs, intervalVarianceUs2,
+                maxGapUs, over150Percent, over200Percent, success));
+    EXPECT_TRUE(success);
+    EXPECT_EQ(22778u, meanIntervalUs);
+    EXPECT_EQ(40000u, maxGapUs);
+    EXPECT_GT(intervalVarianceUs2, 0u);
+    EXPECT_EQ(2u, over150Percent);
+    EXPECT_EQ(1u, over200Percent);
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+}
+
+TEST_F(FrameRateTest, GetFramePacing_JsonRpc)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+    ON_CALL(*p_videoDeviceMock, getCurrentDisframerate(::testing::_))
+        .WillByDefault(::testing::DoAll(
+            ::testing::SetArrayArgument<0>("1920x1080x60", "1920x1080x60" + 13),
+            ::testing::Return(0)));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsCollection"), _T("{}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFramePresentTimes"),
+        _T("{\"timestamps\":[1000000,1016667,1033334,1073334,1090001,1120001,1136668]}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("updateFramePresentTimes"), _T("{\"timestamps\":[1136668]}"), response));
+
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFramePacing"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"meanIntervalUs\":22778") != string::npos);
+    EXPECT_TRUE(response.find("\"maxGapUs\":40000") != string::npos);
+    EXPECT_TRUE(response.find("\"over150Percent\":2") != string::npos);
+    EXPECT_TRUE(response.find("\"over200Percent\":1") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsCollection"), _T("{}"), response));
+}
+
+TEST_F(FrameRateTest, GetFpsHistory_JsonRpc)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsCollection"), _T("{}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFps"), _T("{\"newFpsValue\":30}"), response));
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFpsHistory"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"history\":[{") != string::npos);
+    EXPECT_TRUE(response.find("\"average\":30") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFpsHistory"), _T("{\"since\":4102444800000}"), response));
+    EXPECT_TRUE(response.find("\"history\":[]") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsCollection"), _T("{}"), response));
+}
+
+TEST_F(FrameRateTest, GetFpsHistory_SinceTimestamp)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    bool success = false;
+    std::vector<Exchange::IFrameRateStatistics::FpsWindowStats> history;
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+
+    Plugin::FrameRateImplementation::_instance->UpdateFps(30, success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    EXPECT_EQ(Core::ERROR_NONE, GetFpsHistoryWindows(0, history, success));
+    EXPECT_TRUE(success);
+    ASSERT_FALSE(history.empty());
+    const uint64_t since = history.back().timestamp;
+    EXPECT_EQ(30, history.back().average);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    Plugin::FrameRateImplementation::_instance->UpdateFps(50, success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+
+    EXPECT_EQ(Core::ERROR_NONE, GetFpsHistoryWindows(since, history, success));
+    ASSERT_EQ(1u, history.size());
+    EXPECT_EQ(40, history[0].average);
+    EXPECT_EQ(30, history[0].min);
+    EXPECT_EQ(50, history[0].max);
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+}
+
+TEST_F(FrameRateTest, FpsSessions_IndependentWindows)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    L1FrameRateNotificationHandler* fastHandler = new L1FrameRateNotificationHandler();
+    L1FrameRateNotificationHandler* slowHandler = new L1FrameRateNotificationHandler();
+    bool success = false;
+    uint32_t fastSession = 0;
+    uint32_t slowSession = 0;
+
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, Plugin::FrameRateImplementation::_instance->StartFpsSession(fastHandler, 50, fastSession, success));
+    EXPECT_FALSE(success);
+
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StartFpsSession(fastHandler, 100, fastSession, success));
+    EXPECT_TRUE(success);
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StartFpsSession(slowHandler, 60000, slowSession, success));
+    EXPECT_TRUE(success);
+    EXPECT_NE(fastSession, slowSession);
+
+    Plugin::FrameRateImplementation::_instance->UpdateFps(20, success);
+    Plugin::FrameRateImplementation::_instance->UpdateFps(40, success);
+
+    // restarting the StartFpsCollection window must not reset the sessions
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+
+    EXPECT_TRUE(fastHandler->WaitForRequestStatus(2000, FrameRate_OnFpsEvent));
+
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StopFpsSession(slowSession, success));
+    EXPECT_TRUE(success);
+    EXPECT_TRUE(slowHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+    EXPECT_EQ(30, slowHandler->GetLastAverage());
+    EXPECT_EQ(20, slowHandler->GetLastMin());
+    EXPECT_EQ(40, slowHandler->GetLastMax());
+
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StopFpsSession(fastSession, success));
+    EXPECT_EQ(Core::ERROR_UNKNOWN_KEY, Plugin::FrameRateImplementation::_instance->StopFpsSession(fastSession, success));
+    EXPECT_FALSE(success);
+
+    fastHandler->Release();
+    slowHandler->Release();
+}
+
+TEST_F(FrameRateTest, FpsSessions_Maximum)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    L1FrameRateNotificationHandler* sessionHandler = new L1FrameRateNotificationHandler();
+    std::vector<uint32_t> sessions;
+    bool success = false;
+    uint32_t session = 0;
+
+    // 16 client sessions next to the StartFpsCollection window, co-prime lengths share one report timer
+    for (int index = 0; index < 16; index++)
+    {
+        EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StartFpsSession(sessionHandler, 60001 + (2 * index), session, success));
+        EXPECT_TRUE(success);
+        sessions.push_back(session);
+    }
+    EXPECT_EQ(Core::ERROR_UNAVAILABLE, Plugin::FrameRateImplementation::_instance->StartFpsSession(sessionHandler, 60000, session, success));
+    EXPECT_FALSE(success);
+
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StopFpsSession(sessions.back(), success));
+    sessions.pop_back();
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StartFpsSession(sessionHandler, 60000, session, success));
+    sessions.push_back(session);
+
+    for (const uint32_t id : sessions)
+    {
+        Plugin::FrameRateImplementation::_instance->StopFpsSession(id, success);
+    }
+    sessionHandler->Release();
+}
+
+TEST_F(FrameRateTest, FpsSessions_JsonRpc)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+    Core::Event onFpsSessionEvent(false, true);
+
+    EXPECT_CALL(service, Submit(::testing::_, ::testing::_))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_TRUE(text.find("\"method\":\"org.rdk.FrameRate.onFpsSessionEvent\"") != string::npos);
+                if (text.find("\"average\":30,\"min\":30,\"max\":30") != string::npos) {
+                    onFpsSessionEvent.SetEvent();
+                }
+                return Core::ERROR_NONE;
+            }));
+
+    EVENT_SUBSCRIBE(0, _T("onFpsSessionEvent"), _T("org.rdk.FrameRate"), message);
+
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("startFpsSession"), _T("{\"frequency\":50}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsSession"), _T("{\"frequency\":100}"), response));
+    EXPECT_TRUE(response.find("\"sessionId\":") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    JsonObject started;
+    started.FromString(response);
+    const string stop = "{\"sessionId\":" + std::to_string(started["sessionId"].Number()) + "}";
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFps"), _T("{\"newFpsValue\":30}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, onFpsSessionEvent.Lock(2000));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsSession"), stop, response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_UNKNOWN_KEY, handler.Invoke(connection, _T("stopFpsSession"), stop, response));
+
+    EVENT_UNSUBSCRIBE(0, _T("onFpsSessionEvent"), _T("org.rdk.FrameRate"), message);
+}
+
+TEST_F(FrameRateTest, FpsSessions_KeepLastValueOverCollectionRestart)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    L1FrameRateNotificationHandler* sessionHandler = new L1FrameRateNotificationHandler();
+    bool success = false;
+    uint32_t session = 0;
+
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StartFpsSession(sessionHandler, 100, session, success));
+    Plugin::FrameRateImplementation::_instance->UpdateFps(45, success);
+    EXPECT_TRUE(sessionHandler->WaitForRequestStatus(2000, FrameRate_OnFpsEvent));
+    EXPECT_EQ(45, sessionHandler->GetLastAverage());
+
+    // StartFpsCollection starts its own window without a last value, the session keeps carrying 45
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+    for (int window = 0; window < 2; window++)
+    {
+        sessionHandler->Reset();
+        EXPECT_TRUE(sessionHandler->WaitForRequestStatus(2000, FrameRate_OnFpsEvent));
+    }
+    EXPECT_EQ(45, sessionHandler->GetLastAverage());
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->StopFpsSession(session, success));
+    sessionHandler->Release();
+}
+
+TEST_F(FrameRateTest, SetFpsReportPolicy_JsonRpc)
+{
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("setFpsReportPolicy"), _T("{\"delta\":-2}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, handler.Invoke(connection, _T("setFpsReportPolicy"), _T("{\"delta\":5,\"heartbeat\":-1}"), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setFpsReportPolicy"), _T("{\"delta\":5,\"heartbeat\":10000}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setFpsReportPolicy"), _T("{\"delta\":-1}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+}
+
+TEST_F(FrameRateTest, SetFpsReportPolicy_SuppressesUnchangedWindows)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    L1FrameRateNotificationHandler* notificationHandler = new L1FrameRateNotificationHandler();
+    Plugin::FrameRateImplementation::_instance->Register(notificationHandler);
+
+    bool success = false;
+    std::vector<Exchange::IFrameRateStatistics::FpsWindowStats> history;
+    EXPECT_EQ(Core::ERROR_INVALID_PARAMETER, Plugin::FrameRateImplementation::_instance->SetFpsReportPolicy(-2, 0, success));
+    EXPECT_EQ(Core::ERROR_NONE, Plugin::FrameRateImplementation::_instance->SetFpsReportPolicy(5, 0, success));
+    EXPECT_TRUE(success);
+    Plugin::FrameRateImplementation::_instance->StartFpsCollection(success);
+
+    Plugin::FrameRateImplementation::_instance->UpdateFps(60, success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    EXPECT_TRUE(notificationHandler->WaitForRequestStatus(1000, FrameRate_OnFpsEvent));
+    EXPECT_EQ(60, notificationHandler->GetLastAverage());
+
+    // 60..61 stays within the delta, the window is kept but not reported
+    Plugin::FrameRateImplementation::_instance->UpdateFps(61, success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    GetFpsHistoryWindows(0, history, success);
+    ASSERT_FALSE(history.empty());
+    EXPECT_FALSE(history.back().notified);
+    EXPECT_EQ(61, history.back().max);
+    EXPECT_EQ(60, notificationHandler->GetLastMax());
+
+    Plugin::FrameRateImplementation::_instance->UpdateFps(70, success);
+    Plugin::FrameRateImplementation::_instance->onReportFpsTimer();
+    GetFpsHistoryWindows(0, history, success);
+    EXPECT_TRUE(history.back().notified);
+    EXPECT_EQ(65, notificationHandler->GetLastAverage());
+    EXPECT_EQ(70, notificationHandler->GetLastMax());
+
+    Plugin::FrameRateImplementation::_instance->StopFpsCollection(success);
+    Plugin::FrameRateImplementation::_instance->SetFpsReportPolicy(-1, 0, success);
+    Plugin::FrameRateImplementation::_instance->Unregister(notificationHandler);
+    notificationHandler->Release();
+}
+
+TEST_F(FrameRateTest, GetDisplayFrameRate_ServedFromCache)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    ON_CALL(*p_videoDeviceMock, getFRFMode(::testing::_))
+        .WillByDefault(::testing::DoAll(
+            ::testing::SetArgPointee<0>(1),
+            ::testing::Return(0)));
+    // the video device is resolved once and reused
+    EXPECT_CALL(*p_hostImplMock, getVideoDevices())
+        .Times(1);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFrmMode"), _T("{}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFrmMode"), _T("{}"), response));
+
+    EXPECT_CALL(*p_videoDeviceMock, getCurrentDisframerate(::testing::_))
+        .Times(0);
+    Plugin::FrameRateImplementation::_instance->OnDisplayFrameratePostChange("3840x2160x50");
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getDisplayFrameRate"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"framerate\":\"3840x2160x50\"") != string::npos);
+}
+
+TEST_F(FrameRateTest, GetFrmMode_ResolvesVideoDeviceAgainAfterDsError)
+{
+    ASSERT_NE(nullptr, Plugin::FrameRateImplementation::_instance);
+
+    // the first call after a device manager restart fails on the handle of the previous connection
+    EXPECT_CALL(*p_hostImplMock, getVideoDevices())
+        .Times(2);
+    EXPECT_CALL(*p_videoDeviceMock, getFRFMode(::testing::_))
+        .WillOnce(::testing::Return(1))
+        .WillOnce(::testing::DoAll(
+            ::testing::SetArgPointee<0>(1),
+            ::testing::Return(0)));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFrmMode"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"auto-frm-mode\":1") != string::npos);
+}
+
 TEST_F(FrameRateTest, OnDisplayFrameratePreChange_ValidFrameRate)
 {
     L1FrameRateNotificationHandler* notificationHandler = new L1FrameRateNotificationHandler();
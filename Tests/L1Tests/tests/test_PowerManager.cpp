@@ -16,7 +16,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <bitset>
 
@@ -478,6 +481,50 @@ TEST_F(TestPowerManager, GetCoreTemperature)
     EXPECT_EQ(status, Core::ERROR_NONE);
 }
 
+TEST_F(TestPowerManager, GettersReadPublishedState)
+{
+    // wakeup reason is read once, until the next deep sleep
+    EXPECT_CALL(*p_powerManagerHalMock, PLAT_DS_GetLastWakeupReason(::testing::_))
+        .WillOnce(::testing::Invoke(
+            [](DeepSleep_WakeupReason_t* wakeupReason) {
+                *wakeupReason = DEEPSLEEP_WAKEUPREASON_IR;
+                return DEEPSLEEPMGR_SUCCESS;
+            }));
+
+    PowerState currentState = PowerState::POWER_STATE_UNKNOWN;
+    PowerState prevState    = PowerState::POWER_STATE_UNKNOWN;
+    uint32_t status         = powerManagerImpl->GetPowerState(currentState, prevState);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+    EXPECT_EQ(currentState, initialPowerState());
+
+    for (int read = 0; read < 2; read++) {
+        WakeupReason wakeupReason = WakeupReason::WAKEUP_REASON_UNKNOWN;
+        status                    = powerManagerImpl->GetLastWakeupReason(wakeupReason);
+        EXPECT_EQ(status, Core::ERROR_NONE);
+        EXPECT_EQ(wakeupReason, WakeupReason::WAKEUP_REASON_IR);
+    }
+
+    // from the thermal controller until its first sample is published, then from the snapshot
+    for (int read = 0; read < 2; read++) {
+        float temperature = 0;
+        status            = powerManagerImpl->GetThermalState(temperature);
+        EXPECT_EQ(status, Core::ERROR_NONE);
+        EXPECT_EQ(temperature, 40.0);
+    }
+
+    bool standbyMode = true;
+    status           = powerManagerImpl->GetNetworkStandbyMode(standbyMode);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+    EXPECT_EQ(standbyMode, false);
+
+    status = powerManagerImpl->SetNetworkStandbyMode(true);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->GetNetworkStandbyMode(standbyMode);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+    EXPECT_EQ(standbyMode, true);
+}
+
 TEST_F(TestPowerManager, PowerModePreChangeAck)
 {
     EXPECT_CALL(*p_powerManagerHalMock, PLAT_API_SetPowerState(::testing::_))
@@ -616,6 +663,143 @@ TEST_F(TestPowerManager, PowerModePreChangeAckTimeout)
     EXPECT_EQ(status, Core::ERROR_NONE);
 }
 
+TEST_F(TestPowerManager, PowerModePreChangeTimeoutFollowsHistory)
+{
+    EXPECT_CALL(*p_powerManagerHalMock, PLAT_API_SetPowerState(::testing::_))
+        .WillRepeatedly(::testing::Return(PWRMGR_SUCCESS));
+
+    int keyCode = 0;
+
+    uint32_t clientId = 0;
+    uint32_t status   = powerManagerImpl->AddPowerModePreChangeClient("l1-test-client", clientId);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    Core::ProxyType<PowerModePreChangeEvent> prechangeEvent = Core::ProxyType<PowerModePreChangeEvent>::Create();
+    Core::ProxyType<PowerModeChangedEvent> modeChangedEvent = Core::ProxyType<PowerModeChangedEvent>::Create();
+
+    EXPECT_EQ(status, powerManagerImpl->Register(&(*prechangeEvent)));
+    EXPECT_EQ(status, powerManagerImpl->Register(&(*modeChangedEvent)));
+
+    // the client acknowledges right away until it has history, then stops responding
+    std::atomic<bool> acknowledge(true);
+    EXPECT_CALL(*prechangeEvent, OnPowerModePreChange(::testing::_, ::testing::_, ::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&](const PowerState currentState, const PowerState newState, const int transactionId, const int stateChangeAfter) {
+                EXPECT_EQ(stateChangeAfter, 1);
+                if (acknowledge) {
+                    EXPECT_EQ(Core::ERROR_NONE, powerManagerImpl->PowerModePreChangeComplete(clientId, transactionId));
+                }
+            }));
+
+    std::mutex lock;
+    std::condition_variable changed;
+    uint32_t changes = 0;
+    EXPECT_CALL(*modeChangedEvent, OnPowerModeChanged(::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&](const PowerState currState, const PowerState newState) {
+                std::lock_guard<std::mutex> guard(lock);
+                changes++;
+                changed.notify_all();
+            }));
+
+    auto transition = [&](const PowerState newState) {
+        std::unique_lock<std::mutex> guard(lock);
+        const uint32_t expected = changes + 1;
+        guard.unlock();
+        EXPECT_EQ(Core::ERROR_NONE, powerManagerImpl->SetPowerState(keyCode, newState, "l1-test"));
+        guard.lock();
+        return changed.wait_for(guard, std::chrono::seconds(5), [&]() { return (changes >= expected); });
+    };
+
+    for (int round = 0; round < 3; round++) {
+        ASSERT_TRUE(transition(PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP));
+        ASSERT_TRUE(transition(PowerState::POWER_STATE_ON));
+    }
+
+    // six immediate responses: the transition waits p99 + margin, not the one second the client is told
+    acknowledge = false;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(transition(PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP));
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(elapsed, 800);
+
+    // some delay to destroy AckController after IModeChanged notification
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    status = powerManagerImpl->RemovePowerModePreChangeClient(clientId);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->Unregister(&(*prechangeEvent));
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->Unregister(&(*modeChangedEvent));
+    EXPECT_EQ(status, Core::ERROR_NONE);
+}
+
+TEST_F(TestPowerManager, PowerModePreChangeCancelledOut)
+{
+    // requests cancel out, device power state is never changed
+    EXPECT_CALL(*p_powerManagerHalMock, PLAT_API_SetPowerState(::testing::_))
+        .Times(0);
+
+    int keyCode = 0;
+
+    uint32_t clientId = 0;
+    uint32_t status   = powerManagerImpl->AddPowerModePreChangeClient("l1-test-client", clientId);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    Core::ProxyType<PowerModePreChangeEvent> prechangeEvent = Core::ProxyType<PowerModePreChangeEvent>::Create();
+    Core::ProxyType<PowerModeChangedEvent> modeChangedEvent = Core::ProxyType<PowerModeChangedEvent>::Create();
+
+    EXPECT_EQ(status, powerManagerImpl->Register(&(*prechangeEvent)));
+    EXPECT_EQ(status, powerManagerImpl->Register(&(*modeChangedEvent)));
+
+    int transaction_id = 0;
+    WaitGroup wg;
+    wg.Add(1);
+    EXPECT_CALL(*prechangeEvent, OnPowerModePreChange(::testing::_, ::testing::_, ::testing::_, ::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&](const PowerState currentState, const PowerState newState, const int transactionId, const int stateChangeAfter) {
+                EXPECT_EQ(newState, PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP);
+                transaction_id = transactionId;
+                wg.Done();
+            }));
+
+    EXPECT_CALL(*modeChangedEvent, OnPowerModeChanged(::testing::_, ::testing::_))
+        .Times(0);
+
+    status = powerManagerImpl->SetPowerState(keyCode, PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP, "l1-test");
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    wg.Wait();
+
+    // back to the current state before the client acknowledged, aborts the pending state change
+    status = powerManagerImpl->SetPowerState(keyCode, initialPowerState(), "l1-test");
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->PowerModePreChangeComplete(clientId, transaction_id);
+    EXPECT_EQ(status, Core::ERROR_INVALID_PARAMETER);
+
+    // past the pre-change timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+    PowerState currentState = PowerState::POWER_STATE_UNKNOWN;
+    PowerState prevState    = PowerState::POWER_STATE_UNKNOWN;
+
+    status = powerManagerImpl->GetPowerState(currentState, prevState);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+    EXPECT_EQ(currentState, initialPowerState());
+
+    status = powerManagerImpl->RemovePowerModePreChangeClient(clientId);
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->Unregister(&(*prechangeEvent));
+    EXPECT_EQ(status, Core::ERROR_NONE);
+
+    status = powerManagerImpl->Unregister(&(*modeChangedEvent));
+    EXPECT_EQ(status, Core::ERROR_NONE);
+}
+
 TEST_F(TestPowerManager, PowerModePreChangeUnregisterBeforeAck)
 {
     EXPECT_CALL(*p_powerManagerHalMock, PLAT_API_SetPowerState(::testing::_))
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "AckLatencyHistory.h"
+
+namespace {
+const uint32_t minimumMs = 200;
+const uint32_t maximumMs = 1000;
+const uint32_t marginMs  = 100;
+}
+
+TEST(TestAckLatencyHistory, unknownClients_getMaximum)
+{
+    AckLatencyHistory history(minimumMs, maximumMs, marginMs);
+    uint32_t culprit = 99;
+
+    EXPECT_EQ(minimumMs, history.Timeout({}, culprit));
+    EXPECT_EQ(0u, culprit);
+
+    // too few samples to trust
+    for (uint32_t index = 1; index < ACK_HISTORY_MIN_SAMPLES; index++) {
+        history.Record(1, 10);
+    }
+    uint32_t p99Ms = 0;
+    EXPECT_FALSE(history.P99(1, p99Ms));
+    EXPECT_EQ(maximumMs, history.Timeout({ 1 }, culprit));
+    EXPECT_EQ(1u, culprit);
+}
+
+TEST(TestAckLatencyHistory, timeout_isSlowestP99PlusMargin_clamped)
+{
+    AckLatencyHistory history(minimumMs, maximumMs, marginMs);
+    uint32_t culprit = 0;
+    uint32_t p99Ms   = 0;
+
+    for (uint32_t index = 0; index < ACK_HISTORY_SIZE; index++) {
+        history.Record(1, 20);
+        history.Record(2, 300 + index);
+    }
+    ASSERT_TRUE(history.P99(2, p99Ms));
+    EXPECT_EQ(300u + ACK_HISTORY_SIZE - 1, p99Ms);
+
+    EXPECT_EQ(minimumMs, history.Timeout({ 1 }, culprit));
+    EXPECT_EQ(p99Ms + marginMs, history.Timeout({ 1, 2 }, culprit));
+    EXPECT_EQ(2u, culprit);
+
+    // a client that did not respond in time is recorded with the time it was waited for
+    history.Record(2, maximumMs);
+    EXPECT_EQ(maximumMs, history.Timeout({ 1, 2 }, culprit));
+
+    // old samples age out
+    for (uint32_t index = 0; index < ACK_HISTORY_SIZE; index++) {
+        history.Record(2, 150);
+    }
+    EXPECT_EQ(250u, history.Timeout({ 1, 2 }, culprit));
+
+    history.Remove(2);
+    EXPECT_EQ(maximumMs, history.Timeout({ 1, 2 }, culprit));
+}
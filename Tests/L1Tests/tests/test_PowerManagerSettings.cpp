@@ -6,6 +6,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+
 #include "PowerManagerImplementation.h"
 
 using namespace WPEFramework;
@@ -86,6 +91,135 @@ TEST_F(TestPowerManagerSettings, Empty)
     EXPECT_EQ(ramsettings.powerStateBeforeReboot(), PowerState::POWER_STATE_ON);
 }
 
+TEST_F(TestPowerManagerSettings, CorruptedFileFallsBackToDefaults)
+{
+    populateSettingsV1(PowerState::POWER_STATE_STANDBY, 60, true);
+
+    // flip a byte of the deep sleep timeout, as a torn write would leave it
+    int fd = open(_settingsFile.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    uint8_t byte = 0;
+    EXPECT_EQ(pread(fd, &byte, 1, 24), 1);
+    byte ^= 0xFF;
+    EXPECT_EQ(pwrite(fd, &byte, 1, 24), 1);
+    close(fd);
+
+    Settings settings = Settings::Load(_settingsFile);
+
+    EXPECT_EQ(settings.deepSleepTimeout(), 8U * 60U * 60U);
+    EXPECT_EQ(settings.nwStandbyMode(), false);
+    EXPECT_NE(access((_settingsFile + ".tmp").c_str(), F_OK), 0);
+}
+
+TEST_F(TestPowerManagerSettings, SavedInV1Layout)
+{
+    populateSettingsV1(PowerState::POWER_STATE_STANDBY, 60, true);
+
+    // what older versions check before loading the file
+    int fd = open(_settingsFile.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    uint32_t header[3] = {};
+    EXPECT_EQ(pread(fd, header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+    struct stat buf = {};
+    EXPECT_EQ(fstat(fd, &buf), 0);
+    close(fd);
+
+    EXPECT_EQ(header[0], 0xFEBEEFACU);
+    EXPECT_EQ(header[1], static_cast<uint32_t>(Settings::Version::V1));
+    EXPECT_EQ(header[2], static_cast<uint32_t>(buf.st_size));
+
+    Settings settings = Settings::Load(_settingsFile);
+    EXPECT_EQ(settings.deepSleepTimeout(), 60U);
+    EXPECT_EQ(settings.nwStandbyMode(), true);
+}
+
+TEST_F(TestPowerManagerSettings, WriterKeepsSettingsPendingOnFailure)
+{
+    const std::string directory = "/tmp/test_uimgr_settings";
+    const std::string path      = directory + "/uimgr_settings.bin";
+    if(0!=system(("rm -rf " + directory).c_str())){/* do nothig */}
+
+    Settings settings = Settings::Load(_settingsFile);
+    SettingsWriter writer(path, 60000);
+
+    settings.SetDeepSleepTimeout(120);
+    writer.Schedule(settings);
+    // no directory to save in
+    EXPECT_FALSE(writer.Flush());
+
+    ASSERT_EQ(mkdir(directory.c_str(), S_IRWXU), 0);
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(Settings::Load(path).deepSleepTimeout(), 120U);
+
+    if(0!=system(("rm -rf " + directory).c_str())){/* do nothig */}
+}
+
+TEST_F(TestPowerManagerSettings, WriterBacksOffWhileSaveFails)
+{
+    const std::string directory = "/tmp/test_uimgr_settings";
+    const std::string path      = directory + "/uimgr_settings.bin";
+    if(0!=system(("rm -rf " + directory).c_str())){/* do nothig */}
+
+    Settings settings = Settings::Load(_settingsFile);
+    testing::internal::CaptureStderr();
+    {
+        SettingsWriter writer(path, 10);
+        settings.SetDeepSleepTimeout(120);
+        writer.Schedule(settings);
+        // without a backoff about 60 attempts, with it 10 + 20 + 40 + ... ms apart
+        std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    }
+    Utils::Logging::Flush();
+    const std::string output = testing::internal::GetCapturedStderr();
+
+    size_t attempts = 0;
+    for (size_t position = output.find("Failed to"); position != std::string::npos; position = output.find("Failed to", position + 1)) {
+        attempts++;
+    }
+    EXPECT_GE(attempts, 2U);
+    EXPECT_LE(attempts, 10U);
+}
+
+TEST_F(TestPowerManagerSettings, WriterSavesOnFlushAndDestruction)
+{
+    Settings settings = Settings::Load(_settingsFile);
+
+    {
+        SettingsWriter writer(_settingsFile, 60000);
+
+        settings.SetDeepSleepTimeout(120);
+        writer.Schedule(settings);
+        // not saved before the write-behind delay
+        EXPECT_EQ(Settings::Load(_settingsFile).deepSleepTimeout(), 8U * 60U * 60U);
+
+        EXPECT_TRUE(writer.Flush());
+        EXPECT_EQ(Settings::Load(_settingsFile).deepSleepTimeout(), 120U);
+
+        settings.SetNwStandbyMode(true);
+        writer.Schedule(settings);
+    }
+
+    Settings saved = Settings::Load(_settingsFile);
+    EXPECT_EQ(saved.deepSleepTimeout(), 120U);
+    EXPECT_EQ(saved.nwStandbyMode(), true);
+}
+
+TEST_F(TestPowerManagerSettings, WriterSavesBehind)
+{
+    Settings settings = Settings::Load(_settingsFile);
+    SettingsWriter writer(_settingsFile, 10);
+
+    settings.SetDeepSleepTimeout(240);
+    writer.Schedule(settings);
+
+    bool saved = false;
+    for (int retry = 0; (retry < 200) && !saved; retry++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        saved = (Settings::Load(_settingsFile).deepSleepTimeout() == 240U);
+    }
+    EXPECT_TRUE(saved);
+}
+
 TEST_P(TestPowerManagerSettings, AllTests)
 {
     const auto& param = GetParam();
@@ -0,0 +1,181 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "tptimer.h"
+#include "WorkerPoolImplementation.h"
+
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace WPEFramework;
+
+namespace {
+uint32_t ThreadCount()
+{
+    uint32_t count = 0;
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks != nullptr) {
+        while (readdir(tasks) != nullptr) {
+            count++;
+        }
+        closedir(tasks);
+    }
+    return count;
+}
+
+int64_t ElapsedMs(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+TEST(TpTimerTest, singleShot_firesOnce)
+{
+    std::atomic<int> fired(0);
+    Plugin::TpTimer timer;
+    timer.setSingleShot(true);
+    timer.connect([&fired]() { fired++; });
+
+    const auto start = std::chrono::steady_clock::now();
+    timer.start(50);
+    EXPECT_TRUE(timer.isActive());
+    while ((fired == 0) && (ElapsedMs(start) < 2000)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(ElapsedMs(start), 50);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(1, fired);
+    EXPECT_FALSE(timer.isActive());
+}
+
+TEST(TpTimerTest, periodic_firesUntilStopped)
+{
+    std::atomic<int> fired(0);
+    Plugin::TpTimer timer;
+    timer.connect([&fired]() { fired++; });
+
+    timer.start(20);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    timer.stop();
+    EXPECT_FALSE(timer.isActive());
+    const int count = fired;
+    EXPECT_GE(count, 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(count, fired);
+}
+
+TEST(TpTimerTest, stopFromCallback)
+{
+    std::atomic<int> fired(0);
+    Plugin::TpTimer timer;
+    timer.connect([&fired, &timer]() {
+        if (++fired == 3) {
+            timer.stop();
+        }
+    });
+
+    timer.start(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(3, fired);
+}
+
+TEST(TpTimerTest, manyTimers_shareOneThread)
+{
+    // make sure the wheel thread exists before counting
+    Plugin::TpTimer warmup;
+    warmup.setSingleShot(true);
+    warmup.start(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const uint32_t threads = ThreadCount();
+    std::atomic<int> fired(0);
+    std::vector<std::unique_ptr<Plugin::TpTimer>> timers;
+    for (int index = 0; index < 32; index++) {
+        timers.emplace_back(new Plugin::TpTimer());
+        timers.back()->setSingleShot(true);
+        timers.back()->connect([&fired]() { fired++; });
+        timers.back()->start(20 + index);
+    }
+    EXPECT_EQ(threads, ThreadCount());
+
+    const auto start = std::chrono::steady_clock::now();
+    while ((fired < 32) && (ElapsedMs(start) < 2000)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(32, fired);
+}
+
+TEST(TpTimerTest, longInterval_cascadesOnTime)
+{
+    // beyond the 2.56s level 0 span, the entry is cascaded from level 1
+    std::atomic<int64_t> firedAt(-1);
+    const auto start = std::chrono::steady_clock::now();
+    Plugin::TpTimer timer;
+    timer.setSingleShot(true);
+    timer.connect([&firedAt, &start]() { firedAt = ElapsedMs(start); });
+
+    timer.start(2700);
+    while ((firedAt < 0) && (ElapsedMs(start) < 5000)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(firedAt, 2700);
+    EXPECT_LT(firedAt, 2900);
+}
+
+TEST(TpTimerTest, workerPool_callbacksStayOnWheelThread)
+{
+    Core::ProxyType<WorkerPoolImplementation> workerPool = Core::ProxyType<WorkerPoolImplementation>::Create(
+        2, Core::Thread::DefaultStackSize(), 16);
+    Core::IWorkerPool::Assign(&(*workerPool));
+    workerPool->Run();
+
+    std::atomic<int> fired(0);
+    pthread_t threads[2];
+    {
+        Plugin::TpTimer first;
+        first.setSingleShot(true);
+        first.connect([&fired, &threads]() { threads[0] = pthread_self(); fired++; });
+        Plugin::TpTimer second;
+        second.setSingleShot(true);
+        second.connect([&fired, &threads]() { threads[1] = pthread_self(); fired++; });
+
+        first.start(10);
+        second.start(30);
+        const auto start = std::chrono::steady_clock::now();
+        while ((fired < 2) && (ElapsedMs(start) < 2000)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    ASSERT_EQ(2, fired);
+    EXPECT_NE(0, pthread_equal(threads[0], threads[1]));
+    char name[16] = {};
+    pthread_getname_np(threads[0], name, sizeof(name));
+    EXPECT_STREQ("TpTimerWheel", name);
+
+    Core::IWorkerPool::Assign(nullptr);
+    workerPool.Release();
+}
@@ -0,0 +1,250 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsFileWatch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace {
+const std::string watchDirectory = "/tmp/UtilsFileWatchTest";
+
+class UtilsFileWatchTest : public ::testing::Test {
+protected:
+    UtilsFileWatchTest()
+        : _watch(50)
+        , _lock()
+        , _changed()
+        , _calls()
+    {
+        ::mkdir(watchDirectory.c_str(), 0755);
+    }
+    ~UtilsFileWatchTest() override
+    {
+        ::unlink((watchDirectory + "/state.txt").c_str());
+        ::unlink((watchDirectory + "/other.txt").c_str());
+        ::unlink((watchDirectory + "/state.txt.tmp").c_str());
+        ::rmdir(watchDirectory.c_str());
+    }
+
+    static void Write(const std::string& name, const std::string& content)
+    {
+        std::ofstream file(watchDirectory + "/" + name, std::ios::trunc);
+        file << content;
+    }
+
+    Utils::FileWatch::Callback Counter()
+    {
+        return [this](const std::string& path) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _calls.push_back(path);
+            _changed.notify_all();
+        };
+    }
+
+    size_t WaitForCalls(size_t count, uint32_t timeoutInMs = 2000)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _changed.wait_for(lock, std::chrono::milliseconds(timeoutInMs), [this, count]() { return (_calls.size() >= count); });
+        return _calls.size();
+    }
+
+    Utils::FileWatch _watch;
+    std::mutex _lock;
+    std::condition_variable _changed;
+    std::vector<std::string> _calls;
+};
+}
+
+TEST_F(UtilsFileWatchTest, subscribe_reportsCreateModifyAndReplace)
+{
+    const std::string path = watchDirectory + "/state.txt";
+    ASSERT_NE(0u, _watch.Subscribe(path, Counter()));
+
+    Write("state.txt", "blocklist=false");
+    ASSERT_EQ(1u, WaitForCalls(1));
+    EXPECT_EQ(path, _calls[0]);
+
+    // a change of another file in the directory is not reported
+    Write("other.txt", "x");
+    EXPECT_EQ(1u, WaitForCalls(2, 200));
+
+    Write("state.txt.tmp", "blocklist=true");
+    ASSERT_EQ(0, ::rename((watchDirectory + "/state.txt.tmp").c_str(), path.c_str()));
+    EXPECT_EQ(2u, WaitForCalls(2));
+
+    ASSERT_EQ(0, ::unlink(path.c_str()));
+    EXPECT_EQ(3u, WaitForCalls(3));
+}
+
+TEST_F(UtilsFileWatchTest, changesWithinCoalescePeriod_areReportedOnce)
+{
+    ASSERT_NE(0u, _watch.Subscribe(watchDirectory + "/state.txt", Counter()));
+
+    std::ofstream file(watchDirectory + "/state.txt");
+    for (int percent = 0; percent <= 100; percent += 10) {
+        file << percent << std::endl;
+    }
+    file.close();
+
+    EXPECT_EQ(1u, WaitForCalls(1));
+    EXPECT_EQ(1u, WaitForCalls(2, 200));
+}
+
+TEST_F(UtilsFileWatchTest, subscriptions_areIndependent)
+{
+    std::atomic<int> others(0);
+    const uint32_t first = _watch.Subscribe(watchDirectory + "/state.txt", Counter());
+    const uint32_t second = _watch.Subscribe(watchDirectory + "/state.txt", [&others](const std::string&) { others++; });
+    const uint32_t third = _watch.Subscribe(watchDirectory + "/other.txt", [&others](const std::string&) { others += 10; });
+    ASSERT_NE(0u, first);
+    ASSERT_NE(0u, second);
+    ASSERT_NE(0u, third);
+
+    _watch.Unsubscribe(second);
+    Write("state.txt", "1");
+    Write("other.txt", "1");
+    EXPECT_EQ(1u, WaitForCalls(1));
+    EXPECT_EQ(1u, WaitForCalls(2, 200));
+    EXPECT_EQ(10, others.load());
+
+    // the directory stays watched until its last subscription is gone
+    _watch.Unsubscribe(third);
+    Write("state.txt", "2");
+    EXPECT_EQ(2u, WaitForCalls(2));
+
+    _watch.Unsubscribe(first);
+    Write("state.txt", "3");
+    EXPECT_EQ(2u, WaitForCalls(3, 200));
+}
+
+TEST_F(UtilsFileWatchTest, subscribe_missingDirectory_fails)
+{
+    EXPECT_EQ(0u, _watch.Subscribe(watchDirectory + "/missing/state.txt", Counter()));
+    EXPECT_EQ(0u, _watch.Subscribe(watchDirectory + "/", Counter()));
+    EXPECT_EQ(0u, _watch.Subscribe(watchDirectory + "/state.txt", nullptr));
+}
+
+TEST_F(UtilsFileWatchTest, unsubscribe_fromCallback)
+{
+    std::atomic<uint32_t> id(0);
+    std::atomic<int> calls(0);
+    id = _watch.Subscribe(watchDirectory + "/state.txt", [this, &id, &calls](const std::string&) {
+        calls++;
+        _watch.Unsubscribe(id);
+        std::lock_guard<std::mutex> lock(_lock);
+        _calls.push_back("unsubscribed");
+        _changed.notify_all();
+    });
+    ASSERT_NE(0u, id.load());
+
+    Write("state.txt", "1");
+    EXPECT_EQ(1u, WaitForCalls(1));
+    Write("state.txt", "2");
+    EXPECT_EQ(1u, WaitForCalls(2, 200));
+    EXPECT_EQ(1, calls.load());
+}
+
+TEST_F(UtilsFileWatchTest, isPending_untilCallbackReturned)
+{
+    const uint32_t id = _watch.Subscribe(watchDirectory + "/state.txt", Counter());
+    ASSERT_NE(0u, id);
+    EXPECT_FALSE(_watch.IsPending(id));
+
+    Write("state.txt", "1");
+    EXPECT_TRUE(_watch.IsPending(id));
+    EXPECT_EQ(1u, WaitForCalls(1));
+    EXPECT_FALSE(_watch.IsPending(id));
+    EXPECT_FALSE(_watch.IsPending(id + 1));
+}
+
+TEST_F(UtilsFileWatchTest, watchedFile_readsChangesRightAway)
+{
+    Utils::WatchedFile file(watchDirectory + "/state.txt", _watch);
+    std::string content;
+
+    EXPECT_FALSE(file.Read(content));
+    EXPECT_EQ("", content);
+
+    Write("state.txt", "blocklist=true\n");
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("blocklist=true\n", content);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("blocklist=true\n", content);
+
+    Write("state.txt.tmp", "blocklist=false\n");
+    ::rename((watchDirectory + "/state.txt.tmp").c_str(), (watchDirectory + "/state.txt").c_str());
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("blocklist=false\n", content);
+
+    ::unlink((watchDirectory + "/state.txt").c_str());
+    EXPECT_FALSE(file.Read(content));
+}
+
+TEST_F(UtilsFileWatchTest, watchedFile_withoutDirectory_readsEveryTime)
+{
+    Utils::WatchedFile file(watchDirectory + "/missing/state.txt", _watch);
+    std::string content;
+
+    EXPECT_FALSE(file.Read(content));
+    ::mkdir((watchDirectory + "/missing").c_str(), 0755);
+    std::ofstream(watchDirectory + "/missing/state.txt") << "1";
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("1", content);
+
+    ::unlink((watchDirectory + "/missing/state.txt").c_str());
+    ::rmdir((watchDirectory + "/missing").c_str());
+}
+
+TEST_F(UtilsFileWatchTest, watchedFile_watchesReplacedDirectory)
+{
+    const std::string directory = watchDirectory + "/replaced";
+    ::mkdir(directory.c_str(), 0755);
+    std::ofstream(directory + "/state.txt") << "1";
+    Utils::WatchedFile file(directory + "/state.txt", _watch);
+    std::string content;
+
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("1", content);
+
+    ::unlink((directory + "/state.txt").c_str());
+    ::rmdir(directory.c_str());
+    EXPECT_FALSE(file.Read(content));
+
+    ::mkdir(directory.c_str(), 0755);
+    std::ofstream(directory + "/state.txt") << "2";
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("2", content);
+
+    // watched again, a change is not missed by the cache
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::ofstream(directory + "/state.txt", std::ios::trunc) << "3";
+    EXPECT_TRUE(file.Read(content));
+    EXPECT_EQ("3", content);
+
+    ::unlink((directory + "/state.txt").c_str());
+    ::rmdir(directory.c_str());
+}
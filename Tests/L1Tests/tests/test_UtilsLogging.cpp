@@ -0,0 +1,169 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsLogging.h"
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::string Capture(const std::function<void()>& body)
+{
+    testing::internal::CaptureStderr();
+    body();
+    Utils::Logging::Flush();
+    return testing::internal::GetCapturedStderr();
+}
+
+uint32_t Occurrences(const std::string& text, const std::string& pattern)
+{
+    uint32_t count = 0;
+    for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+        count++;
+    }
+    return count;
+}
+}
+
+TEST(UtilsLoggingTest, threadId_isCachedPerThread)
+{
+    const int tid = Utils::Logging::ThreadId();
+    EXPECT_EQ(tid, static_cast<int>(syscall(SYS_gettid)));
+    EXPECT_EQ(tid, Utils::Logging::ThreadId());
+
+    int other = 0;
+    std::thread([&other]() { other = Utils::Logging::ThreadId(); }).join();
+    EXPECT_NE(tid, other);
+}
+
+TEST(UtilsLoggingTest, flush_writesEverythingInOrder)
+{
+    const std::string output = Capture([]() {
+        for (int index = 0; index < 100; index++) {
+            LOGINFO("message %d", index);
+        }
+    });
+
+    size_t position = 0;
+    for (int index = 0; index < 100; index++) {
+        const std::string expected = "message " + std::to_string(index) + "\n";
+        position = output.find(expected, position);
+        ASSERT_NE(std::string::npos, position) << expected;
+    }
+    EXPECT_NE(std::string::npos, output.find("INFO [test_UtilsLogging.cpp:"));
+}
+
+TEST(UtilsLoggingTest, oversizedMessage_writtenWhole)
+{
+    const std::string payload(4 * Utils::Logging::AsyncWriter::LOG_MESSAGE_SIZE, 'x');
+    const std::string output = Capture([&payload]() {
+        LOGWARN("before");
+        LOGERR("%s", payload.c_str());
+    });
+
+    EXPECT_NE(std::string::npos, output.find(payload + "\n"));
+    EXPECT_LT(output.find("before"), output.find(payload));
+}
+
+TEST(UtilsLoggingTest, blockPolicy_losesNothing)
+{
+    Utils::Logging::AsyncWriter& writer = Utils::Logging::AsyncWriter::Instance();
+    const Utils::Logging::Overflow policy = writer.Policy();
+    const uint64_t dropped = writer.Dropped();
+    writer.Policy(Utils::Logging::Overflow::BLOCK);
+
+    const std::string output = Capture([]() {
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; thread++) {
+            threads.emplace_back([thread]() {
+                for (int index = 0; index < 2000; index++) {
+                    LOGINFO("blocking %d", thread);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    writer.Policy(policy);
+
+    EXPECT_EQ(dropped, writer.Dropped());
+    EXPECT_EQ(8000u, Occurrences(output, ": blocking "));
+}
+
+TEST(UtilsLoggingTest, dropPolicy_countsAndReportsLoss)
+{
+    Utils::Logging::AsyncWriter& writer = Utils::Logging::AsyncWriter::Instance();
+    const Utils::Logging::Overflow policy = writer.Policy();
+    const uint64_t dropped = writer.Dropped();
+    writer.Policy(Utils::Logging::Overflow::DROP);
+
+    const std::string output = Capture([]() {
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; thread++) {
+            threads.emplace_back([]() {
+                for (int index = 0; index < 5000; index++) {
+                    LOGINFO("dropping");
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    writer.Policy(policy);
+
+    const uint64_t lost = writer.Dropped() - dropped;
+    EXPECT_EQ(20000u, Occurrences(output, ": dropping\n") + lost);
+    if (lost > 0) {
+        EXPECT_NE(std::string::npos, output.find("log messages dropped"));
+    }
+}
+
+TEST(UtilsLoggingTest, fatalSignal_drainsQueue)
+{
+    // re-executes the binary, so the child has a running writer thread instead of the forked one
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_DEATH({
+        for (int index = 0; index < 300; index++) {
+            LOGERR("before abort %d", index);
+        }
+        ::abort();
+    },
+        "before abort 299\n");
+}
+
+TEST(UtilsLoggingTest, terminate_drainsQueue)
+{
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_DEATH({
+        for (int index = 0; index < 300; index++) {
+            LOGERR("before terminate %d", index);
+        }
+        std::terminate();
+    },
+        "before terminate 299\n");
+}
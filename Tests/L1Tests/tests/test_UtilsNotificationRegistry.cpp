@@ -0,0 +1,412 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsNotificationRegistry.h"
+#include "WorkerPoolImplementation.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace WPEFramework;
+
+namespace {
+struct ITestNotification {
+    virtual ~ITestNotification() = default;
+    virtual uint32_t AddRef() const = 0;
+    virtual uint32_t Release() const = 0;
+    virtual void OnEvent(int value) = 0;
+};
+
+class TestNotification : public ITestNotification {
+public:
+    TestNotification(std::vector<int>* order = nullptr, int id = 0, uint32_t delayInMs = 0)
+        : references(1)
+        , calls(0)
+        , lastValue(0)
+        , _order(order)
+        , _id(id)
+        , _delayInMs(delayInMs)
+    {
+    }
+
+    uint32_t AddRef() const override
+    {
+        return ++references;
+    }
+    uint32_t Release() const override
+    {
+        return --references;
+    }
+    void OnEvent(int value) override
+    {
+        if (_delayInMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(_delayInMs));
+        }
+        if (_order != nullptr) {
+            _order->push_back(_id);
+        }
+        lastValue = value;
+        calls++;
+    }
+
+    mutable std::atomic<uint32_t> references;
+    std::atomic<uint32_t> calls;
+    std::atomic<int> lastValue;
+
+private:
+    std::vector<int>* _order;
+    const int _id;
+    const uint32_t _delayInMs;
+};
+
+using Registry = Utils::NotificationRegistry<ITestNotification>;
+}
+
+TEST(UtilsNotificationRegistryTest, register_holdsOneReference)
+{
+    TestNotification sink;
+    {
+        Registry registry;
+        EXPECT_TRUE(registry.Register(&sink));
+        EXPECT_FALSE(registry.Register(&sink));
+        EXPECT_EQ(2u, sink.references);
+        EXPECT_EQ(1u, registry.Count());
+        EXPECT_TRUE(registry.Contains(&sink));
+
+        EXPECT_TRUE(registry.Unregister(&sink));
+        EXPECT_FALSE(registry.Unregister(&sink));
+        EXPECT_EQ(1u, sink.references);
+
+        EXPECT_TRUE(registry.Register(&sink));
+    }
+    // released by the destructor
+    EXPECT_EQ(1u, sink.references);
+}
+
+TEST(UtilsNotificationRegistryTest, notify_callsInRegistrationOrder)
+{
+    std::vector<int> order;
+    TestNotification first(&order, 1), second(&order, 2), third(&order, 3);
+    Registry registry;
+    registry.Register(&first);
+    registry.Register(&second);
+    registry.Register(&third);
+
+    registry.Notify([](ITestNotification* notification) { notification->OnEvent(7); });
+
+    EXPECT_EQ((std::vector<int> { 1, 2, 3 }), order);
+    EXPECT_EQ(7, third.lastValue);
+}
+
+TEST(UtilsNotificationRegistryTest, unregisterFromCallback_keepsSinkAliveForDispatch)
+{
+    TestNotification first, second;
+    Registry registry;
+    registry.Register(&first);
+    registry.Register(&second);
+
+    registry.Notify([&registry, &first](ITestNotification* notification) {
+        if (notification == &first) {
+            registry.Unregister(&first);
+            // the running dispatch still holds the registry's reference
+            EXPECT_EQ(2u, first.references);
+        }
+        notification->OnEvent(1);
+    });
+
+    EXPECT_EQ(1u, first.calls);
+    EXPECT_EQ(1u, second.calls);
+    EXPECT_EQ(1u, first.references);
+    EXPECT_FALSE(registry.Contains(&first));
+}
+
+TEST(UtilsNotificationRegistryTest, latencies_trackedPerSink)
+{
+    TestNotification fast, slow(nullptr, 0, 20);
+    Registry registry;
+    registry.Register(&fast);
+    registry.Register(&slow);
+
+    for (int index = 0; index < 3; index++) {
+        registry.Notify([index](ITestNotification* notification) { notification->OnEvent(index); });
+    }
+
+    const std::vector<Registry::Latency> latencies = registry.Latencies();
+    ASSERT_EQ(2u, latencies.size());
+    EXPECT_EQ(&fast, latencies[0].sink);
+    EXPECT_EQ(3u, latencies[0].calls);
+    EXPECT_EQ(3u, latencies[1].calls);
+    EXPECT_GE(latencies[1].averageUs, 20000u);
+    EXPECT_GE(latencies[1].maxUs, latencies[1].lastUs);
+    EXPECT_LT(latencies[0].averageUs, latencies[1].averageUs);
+    EXPECT_EQ(0u, latencies[1].late);
+}
+
+TEST(UtilsNotificationRegistryTest, notifyParallel_slowSinkOnlyDelaysItself)
+{
+    Core::ProxyType<WorkerPoolImplementation> workerPool(Core::ProxyType<WorkerPoolImplementation>::Create(4, Core::Thread::DefaultStackSize(), 16));
+    Core::IWorkerPool::Assign(&(*workerPool));
+    workerPool->Run();
+
+    TestNotification fast1, fast2, slow(nullptr, 0, 500);
+    {
+        Registry registry;
+        registry.Register(&fast1);
+        registry.Register(&slow);
+        registry.Register(&fast2);
+
+        const auto start = std::chrono::steady_clock::now();
+        const uint32_t completed = registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(3); }, 100);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(2u, completed);
+        EXPECT_LT(elapsed, 400);
+        EXPECT_EQ(1u, fast1.calls);
+        EXPECT_EQ(1u, fast2.calls);
+        EXPECT_EQ(0u, slow.calls);
+
+        // unregistering does not release the sink under the running job
+        registry.Unregister(&slow);
+        EXPECT_EQ(2u, slow.references);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((slow.references != 1) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(1u, slow.calls);
+    EXPECT_EQ(1u, slow.references);
+
+    workerPool->Stop();
+    Core::IWorkerPool::Assign(nullptr);
+    workerPool.Release();
+}
+
+namespace {
+class AdjustableNotification : public ITestNotification {
+public:
+    AdjustableNotification(uint32_t delayInMs)
+        : delayInMs(delayInMs)
+        , calls(0)
+        , _references(1)
+        , _lock()
+        , _values()
+    {
+    }
+    ~AdjustableNotification() override
+    {
+        // a finished job may still hold the registry's reference for a moment
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while ((_references != 1) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(1u, _references.load());
+    }
+
+    uint32_t AddRef() const override
+    {
+        return ++_references;
+    }
+    uint32_t Release() const override
+    {
+        return --_references;
+    }
+    void OnEvent(int value) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayInMs.load()));
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _values.push_back(value);
+        }
+        calls++;
+    }
+
+    std::vector<int> Values()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _values;
+    }
+
+    bool WaitForCalls(uint32_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((calls < count) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return (calls >= count);
+    }
+
+    std::atomic<uint32_t> delayInMs;
+    std::atomic<uint32_t> calls;
+
+private:
+    mutable std::atomic<uint32_t> _references;
+    std::mutex _lock;
+    std::vector<int> _values;
+};
+
+class UtilsNotificationRegistryParallelTest : public ::testing::Test {
+protected:
+    UtilsNotificationRegistryParallelTest()
+        : _workerPool(Core::ProxyType<WorkerPoolImplementation>::Create(4, Core::Thread::DefaultStackSize(), 16))
+    {
+        Core::IWorkerPool::Assign(&(*_workerPool));
+        _workerPool->Run();
+    }
+    ~UtilsNotificationRegistryParallelTest() override
+    {
+        _workerPool->Stop();
+        Core::IWorkerPool::Assign(nullptr);
+        _workerPool.Release();
+    }
+
+    // the registry updates its figures after the sink's callback returned
+    static bool WaitFor(const std::function<bool()>& condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((condition() == false) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return condition();
+    }
+
+    Core::ProxyType<WorkerPoolImplementation> _workerPool;
+};
+}
+
+TEST_F(UtilsNotificationRegistryParallelTest, notifyParallel_keepsOrderPerSink)
+{
+    AdjustableNotification first(10), second(0);
+    Registry registry;
+    registry.Register(&first);
+    registry.Register(&second);
+
+    for (int index = 0; index < 8; index++) {
+        registry.NotifyParallel([index](ITestNotification* notification) { notification->OnEvent(index); }, 0);
+    }
+
+    ASSERT_TRUE(WaitFor([&registry]() { return ((registry.Latencies()[0].calls == 8) && (registry.Latencies()[1].calls == 8)); }));
+    const std::vector<int> expected { 0, 1, 2, 3, 4, 5, 6, 7 };
+    EXPECT_EQ(expected, first.Values());
+    EXPECT_EQ(expected, second.Values());
+
+    const std::vector<Registry::Latency> latencies = registry.Latencies();
+    ASSERT_EQ(2u, latencies.size());
+    EXPECT_EQ(8u, latencies[0].calls);
+    EXPECT_EQ(0u, latencies[0].queued);
+    // the later notifications waited for the earlier ones
+    EXPECT_GT(latencies[0].maxDeliveryUs, latencies[0].maxUs);
+    EXPECT_GE(latencies[0].averageDeliveryUs, latencies[0].averageUs);
+}
+
+TEST_F(UtilsNotificationRegistryParallelTest, notifyParallel_degradesAndRecoversSlowSink)
+{
+    AdjustableNotification fast(0), slow(60);
+    Registry registry;
+    registry.Register(&fast);
+    registry.Register(&slow);
+
+    for (uint32_t index = 0; index < NOTIFICATION_DEGRADE_AFTER; index++) {
+        EXPECT_EQ(1u, registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(1); }, 20));
+    }
+    ASSERT_TRUE(WaitFor([&registry]() { return registry.Latencies()[1].degraded; }));
+    EXPECT_FALSE(registry.Latencies()[0].degraded);
+    EXPECT_EQ(static_cast<uint64_t>(NOTIFICATION_DEGRADE_AFTER), registry.Latencies()[1].late);
+
+    // the degraded sink is neither waited for nor counted
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(1u, registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(2); }, 20));
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), 50);
+    ASSERT_TRUE(slow.WaitForCalls(NOTIFICATION_DEGRADE_AFTER + 1));
+    EXPECT_EQ(2, slow.Values().back());
+
+    slow.delayInMs = 0;
+    for (uint32_t index = 0; index < NOTIFICATION_RECOVER_AFTER; index++) {
+        registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(3); }, 20);
+        ASSERT_TRUE(WaitFor([&registry, index]() { return (registry.Latencies()[1].calls == (NOTIFICATION_DEGRADE_AFTER + 2 + index)); }));
+    }
+    EXPECT_FALSE(registry.Latencies()[1].degraded);
+    EXPECT_EQ(2u, registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(4); }, 1000));
+}
+
+TEST_F(UtilsNotificationRegistryParallelTest, notifyParallel_infiniteWaitsForDegradedSink)
+{
+    AdjustableNotification fast(0), slow(60);
+    Registry registry;
+    registry.Register(&fast);
+    registry.Register(&slow);
+
+    for (uint32_t index = 0; index < NOTIFICATION_DEGRADE_AFTER; index++) {
+        registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(1); }, 20);
+    }
+    ASSERT_TRUE(WaitFor([&registry]() { return ((registry.Latencies()[1].degraded) && (registry.Latencies()[1].queued == 0)); }));
+
+    EXPECT_EQ(2u, registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(2); }, Core::infinite));
+    EXPECT_EQ(2, slow.Values().back());
+    EXPECT_EQ(NOTIFICATION_DEGRADE_AFTER + 1, slow.calls.load());
+}
+
+TEST_F(UtilsNotificationRegistryParallelTest, notifyParallel_overflowCountsMissed)
+{
+    AdjustableNotification slow(20);
+    Registry registry;
+    registry.Register(&slow);
+
+    const uint32_t total = NOTIFICATION_MAX_QUEUED + 3;
+    for (uint32_t index = 0; index < total; index++) {
+        registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(1); }, 0);
+    }
+
+    ASSERT_TRUE(WaitFor([&registry]() { return (registry.Latencies()[0].queued == 0); }));
+    ASSERT_TRUE(WaitFor([&registry, total]() { return ((registry.Latencies()[0].calls + registry.Latencies()[0].missed) == total); }));
+    // at most one delivery was in progress while the others were queued
+    EXPECT_GE(registry.Latencies()[0].missed, 2u);
+    EXPECT_EQ(0u, registry.Latencies()[0].late);
+}
+
+TEST_F(UtilsNotificationRegistryParallelTest, unregister_skipsQueuedDeliveries)
+{
+    AdjustableNotification slow(50);
+    Registry registry;
+    registry.Register(&slow);
+
+    for (int index = 0; index < 4; index++) {
+        registry.NotifyParallel([index](ITestNotification* notification) { notification->OnEvent(index); }, 0);
+    }
+    uint32_t completed = 1;
+    std::thread waiter([&registry, &completed]() {
+        completed = registry.NotifyParallel([](ITestNotification* notification) { notification->OnEvent(4); }, Core::infinite);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(registry.Unregister(&slow));
+    waiter.join();
+
+    // only the delivery in progress when it was unregistered reached the sink
+    EXPECT_EQ(0u, completed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_LE(slow.calls.load(), 1u);
+}
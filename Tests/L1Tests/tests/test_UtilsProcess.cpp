@@ -0,0 +1,235 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsProcess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+namespace {
+const int childCount = 16;
+
+// a parent ("sh") with childCount sleeping children, all named utilsproctest
+class UtilsProcessTest : public ::testing::Test {
+protected:
+    UtilsProcessTest()
+        : _parent(-1)
+    {
+        _parent = fork();
+        if (_parent == 0) {
+            prctl(PR_SET_NAME, "utilsproctest");
+            for (int index = 0; index < childCount; index++) {
+                if (fork() == 0) {
+                    prctl(PR_SET_NAME, "utilsproctest");
+                    pause();
+                    _exit(0);
+                }
+            }
+            pause();
+            _exit(0);
+        }
+    }
+    ~UtilsProcessTest() override
+    {
+        vector<int> children;
+        Utils::findChildProcessIDs(_parent, children);
+        for (const int child : children) {
+            kill(child, SIGKILL);
+        }
+        kill(_parent, SIGKILL);
+        waitpid(_parent, nullptr, 0);
+    }
+
+    vector<int> WaitForChildren(size_t count)
+    {
+        vector<int> children;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        do {
+            children.clear();
+            Utils::findChildProcessIDs(_parent, children);
+            if (children.size() < count) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        } while ((children.size() < count) && (std::chrono::steady_clock::now() < deadline));
+        return children;
+    }
+
+    static bool WaitForState(int pid, char expected)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        string stat;
+        char state = '\0';
+        do {
+            if (Utils::readProcFile("/proc/" + std::to_string(pid) + "/stat", stat)) {
+                sscanf(stat.c_str() + stat.rfind(')') + 1, " %c", &state);
+            }
+            if (state != expected) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        } while ((state != expected) && (std::chrono::steady_clock::now() < deadline));
+        return (state == expected);
+    }
+
+    // what openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS)/readproc() reads for every process
+    static vector<int> FullScanChildren(int ppid)
+    {
+        vector<int> children;
+        DIR* proc = opendir("/proc");
+        struct dirent* entry;
+        string content;
+        int parent;
+        while ((entry = readdir(proc)) != NULL) {
+            char* end;
+            const long pid = strtol(entry->d_name, &end, 10);
+            if ((*end != '\0') || (pid <= 0)) {
+                continue;
+            }
+            const string path = string("/proc/") + entry->d_name;
+            Utils::readProcFile(path + "/statm", content);
+            Utils::readProcFile(path + "/status", content);
+            if (Utils::getParentProcessID(static_cast<int>(pid), parent) && (parent == ppid)) {
+                children.push_back(static_cast<int>(pid));
+            }
+        }
+        closedir(proc);
+        return children;
+    }
+
+    pid_t _parent;
+};
+}
+
+TEST_F(UtilsProcessTest, findChildProcessIDs_listsDirectChildren)
+{
+    vector<int> children = WaitForChildren(childCount);
+    ASSERT_EQ(static_cast<size_t>(childCount), children.size());
+
+    vector<int> scanned = FullScanChildren(_parent);
+    std::sort(children.begin(), children.end());
+    std::sort(scanned.begin(), scanned.end());
+    EXPECT_EQ(scanned, children);
+
+    int ppid = 0;
+    EXPECT_TRUE(Utils::getParentProcessID(children[0], ppid));
+    EXPECT_EQ(_parent, ppid);
+
+    // a process without children, one that does not exist
+    vector<int> none;
+    EXPECT_FALSE(Utils::findChildProcessIDs(children[0], none));
+    EXPECT_FALSE(Utils::findChildProcessIDs(-5, none));
+    EXPECT_TRUE(none.empty());
+}
+
+TEST_F(UtilsProcessTest, findProcessIDsByName_readsComm)
+{
+    vector<int> tree = WaitForChildren(childCount);
+    tree.push_back(_parent);
+
+    string name;
+    EXPECT_TRUE(Utils::getProcessName(_parent, name));
+    EXPECT_EQ("utilsproctest", name);
+
+    // may also list zombies left by earlier tests that nobody reaped
+    vector<int> processIds;
+    EXPECT_TRUE(Utils::findProcessIDsByName("utilsproctest", processIds));
+    for (const int pid : tree) {
+        EXPECT_NE(processIds.end(), std::find(processIds.begin(), processIds.end(), pid)) << pid;
+    }
+
+    processIds.clear();
+    EXPECT_FALSE(Utils::findProcessIDsByName("utilsproctes", processIds));
+}
+
+TEST_F(UtilsProcessTest, killChildProcesses_signalsOnlyChildren)
+{
+    WaitForChildren(childCount);
+
+    EXPECT_TRUE(Utils::killChildProcesses(_parent, SIGKILL));
+
+    // killed children stay zombies until the parent reaps them, the parent is alive
+    for (const int child : WaitForChildren(childCount)) {
+        EXPECT_TRUE(WaitForState(child, 'Z')) << child;
+    }
+    EXPECT_TRUE(WaitForState(_parent, 'S'));
+}
+
+TEST_F(UtilsProcessTest, signalProcess_checksIdentity)
+{
+    vector<int> children = WaitForChildren(childCount);
+    ASSERT_FALSE(children.empty());
+
+    EXPECT_FALSE(Utils::signalProcess(children[0], SIGKILL, [](int) { return false; }));
+    EXPECT_TRUE(Utils::signalProcess(children[0], 0));
+    EXPECT_TRUE(Utils::killProcessByName("utilsproctest", SIGKILL));
+
+    waitpid(_parent, nullptr, 0);
+    EXPECT_FALSE(Utils::signalProcess(_parent, 0));
+}
+
+TEST_F(UtilsProcessTest, signalProcess_fallsBackToKill)
+{
+    vector<int> children = WaitForChildren(childCount);
+    ASSERT_FALSE(children.empty());
+
+    // without free descriptors pidfd_open fails with EMFILE, which must not read as "process gone"
+    const pid_t checker = fork();
+    if (checker == 0) {
+        const struct rlimit none = { 0, 0 };
+        setrlimit(RLIMIT_NOFILE, &none);
+        const bool opened = (Utils::openProcessFd(children[0]) >= 0);
+        _exit(((opened == false) && (Utils::signalProcess(children[0], SIGKILL) == true)) ? 0 : 1);
+    }
+    int status = -1;
+    ASSERT_EQ(checker, waitpid(checker, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    EXPECT_TRUE(WaitForState(children[0], 'Z'));
+}
+
+TEST_F(UtilsProcessTest, benchmark_againstFullScan)
+{
+    ASSERT_EQ(static_cast<size_t>(childCount), WaitForChildren(childCount).size());
+
+    const int rounds = 50;
+    vector<int> children;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        children.clear();
+        Utils::findChildProcessIDs(_parent, children);
+    }
+    const auto targeted = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        children = FullScanChildren(_parent);
+    }
+    const auto full = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("child lookup of %d children: targeted %lld us, full /proc scan %lld us per lookup\n",
+        childCount, static_cast<long long>(targeted / rounds), static_cast<long long>(full / rounds));
+    EXPECT_EQ(static_cast<size_t>(childCount), children.size());
+}
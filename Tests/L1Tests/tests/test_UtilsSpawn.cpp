@@ -0,0 +1,201 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsSpawn.h"
+#include "WorkerPoolImplementation.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+
+using namespace WPEFramework;
+
+namespace {
+const std::string scriptDirectory = "/tmp/UtilsSpawnTest";
+
+class UtilsSpawnTest : public ::testing::Test {
+protected:
+    UtilsSpawnTest()
+    {
+        ::mkdir(scriptDirectory.c_str(), 0755);
+        Script("args.sh",
+            "echo \"count: $#\"\n"
+            "for argument in \"$@\"; do echo \"arg: $argument\"; done\n"
+            "echo \"to stderr\" >&2\n"
+            "exit 3\n");
+        Script("sleep.sh",
+            "sleep 30 &\n"
+            "echo started\n"
+            "sleep 30\n");
+    }
+    ~UtilsSpawnTest() override
+    {
+        ::unlink((scriptDirectory + "/args.sh").c_str());
+        ::unlink((scriptDirectory + "/sleep.sh").c_str());
+        ::unlink((scriptDirectory + "/output.log").c_str());
+        ::rmdir(scriptDirectory.c_str());
+    }
+
+    static std::string Script(const std::string& name, const std::string& body)
+    {
+        const std::string path = scriptDirectory + "/" + name;
+        std::ofstream file(path, std::ios::trunc);
+        file << "#!/bin/sh\n"
+             << body;
+        file.close();
+        ::chmod(path.c_str(), 0755);
+        return path;
+    }
+};
+}
+
+TEST_F(UtilsSpawnTest, run_passesArgvWithoutShell)
+{
+    const Utils::Spawn::Result result = Utils::Spawn::Run({ scriptDirectory + "/args.sh", "two words", "$HOME;exit 0" });
+
+    EXPECT_TRUE(result.started);
+    EXPECT_FALSE(result.timedOut);
+    EXPECT_EQ(3, result.exitCode);
+    EXPECT_FALSE(result.Succeeded());
+    EXPECT_EQ("count: 2\narg: two words\narg: $HOME;exit 0\n", result.output);
+}
+
+TEST_F(UtilsSpawnTest, run_capturesErrorsOnRequest)
+{
+    Utils::Spawn::Options options;
+    options.captureErrors = true;
+    const Utils::Spawn::Result result = Utils::Spawn::Run({ "sh", scriptDirectory + "/args.sh" }, options);
+
+    EXPECT_EQ("count: 0\nto stderr\n", result.output);
+
+    options.captureErrors = false;
+    options.maxOutputSize = 5;
+    EXPECT_EQ("count", Utils::Spawn::Run({ "sh", scriptDirectory + "/args.sh" }, options).output);
+}
+
+TEST_F(UtilsSpawnTest, run_missingProgram_isNotStarted)
+{
+    const Utils::Spawn::Result result = Utils::Spawn::Run({ scriptDirectory + "/missing.sh" });
+
+    EXPECT_FALSE(result.started);
+    EXPECT_EQ(ENOENT, result.error);
+    EXPECT_FALSE(Utils::Spawn::Run({}).started);
+}
+
+TEST_F(UtilsSpawnTest, run_timeout_killsProcessGroup)
+{
+    Utils::Spawn::Options options;
+    options.timeoutInMs = 200;
+
+    const auto start = std::chrono::steady_clock::now();
+    const Utils::Spawn::Result result = Utils::Spawn::Run({ scriptDirectory + "/sleep.sh" }, options);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_TRUE(result.started);
+    EXPECT_TRUE(result.timedOut);
+    EXPECT_EQ(SIGTERM, result.signal);
+    EXPECT_EQ("started\n", result.output);
+    EXPECT_LT(elapsed, 2000);
+}
+
+TEST_F(UtilsSpawnTest, run_appendsToOutputFile)
+{
+    const std::string log = scriptDirectory + "/output.log";
+    std::ofstream(log) << "before\n";
+
+    Utils::Spawn::Options options;
+    options.outputFile = log;
+    options.captureErrors = true;
+    const Utils::Spawn::Result result = Utils::Spawn::Run({ scriptDirectory + "/args.sh", "logged" }, options);
+
+    EXPECT_EQ(3, result.exitCode);
+    EXPECT_EQ("", result.output);
+    std::ifstream file(log);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ("before\ncount: 1\narg: logged\nto stderr\n", content);
+}
+
+TEST_F(UtilsSpawnTest, detach_returnsBeforeTheProcessExits)
+{
+    const std::string log = scriptDirectory + "/output.log";
+    Utils::Spawn::Options options;
+    options.outputFile = log;
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(Utils::Spawn::Detach({ "sh", "-c", "sleep 1; echo done" }, options));
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), 500);
+    EXPECT_FALSE(Utils::Spawn::Detach({ scriptDirectory + "/missing.sh" }));
+
+    std::string content;
+    for (int retry = 0; (retry < 50) && (content != "done\n"); retry++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::ifstream file(log);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    EXPECT_EQ("done\n", content);
+}
+
+TEST_F(UtilsSpawnTest, start_leavesReapingToCaller)
+{
+    const pid_t pid = Utils::Spawn::Start({ "sh", "-c", "exit 7" });
+    ASSERT_GT(pid, 0);
+
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(7, WEXITSTATUS(status));
+}
+
+TEST_F(UtilsSpawnTest, runAsync_callsBackFromWorkerPool)
+{
+    Core::ProxyType<WorkerPoolImplementation> workerPool(Core::ProxyType<WorkerPoolImplementation>::Create(2, Core::Thread::DefaultStackSize(), 16));
+    Core::IWorkerPool::Assign(&(*workerPool));
+    workerPool->Run();
+
+    std::mutex lock;
+    std::condition_variable done;
+    bool called = false;
+    Utils::Spawn::Result result;
+
+    Utils::Spawn::RunAsync({ scriptDirectory + "/args.sh", "async" }, [&](const Utils::Spawn::Result& completed) {
+        std::lock_guard<std::mutex> guard(lock);
+        result = completed;
+        called = true;
+        done.notify_all();
+    });
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        EXPECT_TRUE(done.wait_for(guard, std::chrono::seconds(5), [&called]() { return called; }));
+    }
+    EXPECT_EQ(3, result.exitCode);
+    EXPECT_EQ("count: 1\narg: async\n", result.output);
+
+    workerPool->Stop();
+    Core::IWorkerPool::Assign(nullptr);
+    workerPool.Release();
+}
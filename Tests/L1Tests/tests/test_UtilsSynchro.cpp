@@ -0,0 +1,179 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsSynchro.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+class TestApi {
+public:
+    TestApi()
+        : inside(0)
+        , maxInside(0)
+        , release(false)
+    {
+    }
+
+    uint32_t slowCall(const JsonObject&, JsonObject&)
+    {
+        const int now = ++inside;
+        int max = maxInside;
+        while ((now > max) && (maxInside.compare_exchange_weak(max, now) == false)) {
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while ((release == false) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        inside--;
+        return 0;
+    }
+
+    uint32_t nestedLock(const JsonObject&, JsonObject&)
+    {
+        Utils::Synchro::LockApiGuard<TestApi> lock;
+        return 0;
+    }
+
+    uint32_t unlockedWait(const JsonObject& in, JsonObject& out)
+    {
+        Utils::Synchro::UnlockApiGuard<TestApi> unlock;
+        return slowCall(in, out);
+    }
+
+    std::atomic<int> inside;
+    std::atomic<int> maxInside;
+    std::atomic<bool> release;
+};
+
+using Call = std::function<uint32_t(TestApi*, const JsonObject&, JsonObject&)>;
+
+Call Wrap(uint32_t (TestApi::*method)(const JsonObject&, JsonObject&), Utils::Synchro::ApiLockMode mode)
+{
+    return Utils::Synchro::getFunctionToCall("test", method, static_cast<TestApi*>(nullptr), mode);
+}
+
+void RunConcurrently(TestApi& api, const Call& first, const Call& second, std::atomic<bool>& secondDone)
+{
+    std::thread one([&]() { JsonObject in, out; first(&api, in, out); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::thread two([&]() { JsonObject in, out; second(&api, in, out); secondDone = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    api.release = true;
+    one.join();
+    two.join();
+}
+}
+
+TEST(UtilsSynchroTest, sharedMethods_runInParallel)
+{
+    TestApi api;
+    std::atomic<bool> done(false);
+    const Call reader = Wrap(&TestApi::slowCall, Utils::Synchro::ApiLockMode::SHARED);
+    RunConcurrently(api, reader, reader, done);
+    EXPECT_EQ(2, api.maxInside);
+}
+
+TEST(UtilsSynchroTest, exclusiveMethod_excludesReaders)
+{
+    TestApi api;
+    std::atomic<bool> done(false);
+    RunConcurrently(api, Wrap(&TestApi::slowCall, Utils::Synchro::ApiLockMode::EXCLUSIVE), Wrap(&TestApi::slowCall, Utils::Synchro::ApiLockMode::SHARED), done);
+    EXPECT_EQ(1, api.maxInside);
+    EXPECT_TRUE(done);
+}
+
+TEST(UtilsSynchroTest, lockApiGuard_isReentrant)
+{
+    TestApi api;
+    JsonObject in, out;
+    EXPECT_EQ(0u, Wrap(&TestApi::nestedLock, Utils::Synchro::ApiLockMode::EXCLUSIVE)(&api, in, out));
+    // from a reader the guard upgrades to exclusive
+    EXPECT_EQ(0u, Wrap(&TestApi::nestedLock, Utils::Synchro::ApiLockMode::SHARED)(&api, in, out));
+
+    // and the lock is free again afterwards
+    std::thread other([]() { Utils::Synchro::LockApiGuard<TestApi> lock; });
+    other.join();
+}
+
+TEST(UtilsSynchroTest, unlockApiGuard_letsWriterIn)
+{
+    for (const auto mode : { Utils::Synchro::ApiLockMode::EXCLUSIVE, Utils::Synchro::ApiLockMode::SHARED }) {
+        TestApi api;
+        std::atomic<bool> done(false);
+        std::thread writer;
+        std::thread one([&]() { JsonObject in, out; Wrap(&TestApi::unlockedWait, mode)(&api, in, out); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        writer = std::thread([&]() { Utils::Synchro::LockApiGuard<TestApi> lock; done = true; });
+        writer.join();
+        EXPECT_TRUE(done);
+        api.release = true;
+        one.join();
+    }
+}
+
+TEST(UtilsSynchroTest, latencyHistogram_percentiles)
+{
+    Utils::Synchro::LatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.Report().count);
+    EXPECT_EQ(0u, histogram.Report().p99Us);
+
+    for (int index = 0; index < 98; index++) {
+        histogram.Record(100);
+    }
+    histogram.Record(5000);
+    histogram.Record(70000);
+
+    const auto summary = histogram.Report();
+    EXPECT_EQ(100u, summary.count);
+    EXPECT_EQ(127u, summary.p50Us); // upper bound of [64, 128)
+    EXPECT_EQ(8191u, summary.p99Us); // upper bound of [4096, 8192)
+    EXPECT_EQ(70000u, summary.maxUs);
+
+    histogram.Reset();
+    EXPECT_EQ(0u, histogram.Report().count);
+    EXPECT_EQ(0u, histogram.Report().maxUs);
+}
+
+TEST(UtilsSynchroTest, apiStats_recordWaitAndExec)
+{
+    TestApi api;
+    std::atomic<bool> done(false);
+    Utils::Synchro::ApiStats<TestApi>::Reset();
+    RunConcurrently(api, Wrap(&TestApi::slowCall, Utils::Synchro::ApiLockMode::EXCLUSIVE), Wrap(&TestApi::nestedLock, Utils::Synchro::ApiLockMode::SHARED), done);
+
+    // Wrap() registers the methods as "test"
+    const auto stats = Utils::Synchro::ApiStats<TestApi>::Snapshot();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ("test", stats[0].method);
+    EXPECT_EQ(2u, stats[0].wait.count);
+    EXPECT_EQ(2u, stats[0].exec.count);
+    // the second call waited for the first to be released
+    EXPECT_GE(stats[0].wait.maxUs, 50000u);
+    EXPECT_GE(stats[0].exec.maxUs, stats[0].wait.maxUs);
+
+    Utils::Synchro::ApiStats<TestApi>::Reset();
+    EXPECT_EQ(0u, Utils::Synchro::ApiStats<TestApi>::Snapshot()[0].exec.count);
+}
@@ -0,0 +1,137 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsTelemetry.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+class UtilsTelemetryTest : public ::testing::Test {
+protected:
+    UtilsTelemetryTest()
+        : sink(std::make_shared<Utils::Telemetry::LocalSink>())
+    {
+        Utils::Telemetry::Queue::instance().sink(sink);
+    }
+    ~UtilsTelemetryTest() override
+    {
+        Utils::Telemetry::flush();
+        Utils::Telemetry::Queue::instance().sink(nullptr);
+        Utils::Telemetry::Queue::instance().configure(TELEMETRY_FLUSH_INTERVAL_IN_MS, TELEMETRY_BATCH_SIZE, TELEMETRY_QUEUE_CAPACITY);
+    }
+
+    bool WaitForEvents(size_t count, uint32_t timeoutInMs)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMs);
+        while ((sink->events().size() < count) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return (sink->events().size() >= count);
+    }
+
+    std::shared_ptr<Utils::Telemetry::LocalSink> sink;
+};
+}
+
+TEST_F(UtilsTelemetryTest, identicalEvents_areCoalesced)
+{
+    Utils::Telemetry::Queue::instance().configure(60000, 64, 1024);
+
+    for (int index = 0; index < 100; index++) {
+        Utils::Telemetry::sendMessage((char*)"MARKER_A", (char*)"same");
+    }
+    Utils::Telemetry::sendMessage((char*)"MARKER_A", (char*)"other");
+    Utils::Telemetry::sendMessage((char*)"same");
+    Utils::Telemetry::flush();
+
+    const auto events = sink->events();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_EQ("MARKER_A", events[0].marker);
+    EXPECT_EQ("same", events[0].message);
+    EXPECT_EQ(100u, events[0].count);
+    EXPECT_EQ("other", events[1].message);
+    EXPECT_EQ(1u, events[1].count);
+    EXPECT_EQ("THUNDER_MESSAGE", events[2].marker);
+}
+
+TEST_F(UtilsTelemetryTest, batchSize_flushesBeforeInterval)
+{
+    Utils::Telemetry::Queue::instance().configure(60000, 8, 1024);
+
+    for (int index = 0; index < 8; index++) {
+        std::string message = "event " + std::to_string(index);
+        Utils::Telemetry::sendMessage((char*)"MARKER_B", &message[0]);
+    }
+    EXPECT_TRUE(WaitForEvents(8, 2000));
+}
+
+TEST_F(UtilsTelemetryTest, interval_flushesPartialBatch)
+{
+    Utils::Telemetry::Queue::instance().configure(50, 64, 1024);
+
+    Utils::Telemetry::sendError("error %d", 42);
+    ASSERT_TRUE(WaitForEvents(1, 2000));
+    EXPECT_EQ("THUNDER_ERROR", sink->events()[0].marker);
+    EXPECT_EQ("error 42", sink->events()[0].message);
+}
+
+TEST_F(UtilsTelemetryTest, capacity_dropsAndReports)
+{
+    Utils::Telemetry::Queue::instance().configure(60000, 64, 4);
+
+    for (int index = 0; index < 6; index++) {
+        std::string message = "event " + std::to_string(index);
+        Utils::Telemetry::sendMessage((char*)"MARKER_C", &message[0]);
+    }
+    Utils::Telemetry::flush();
+
+    EXPECT_EQ(4u, sink->total("MARKER_C"));
+    const auto events = sink->events();
+    ASSERT_EQ(5u, events.size());
+    EXPECT_EQ("THUNDER_TELEMETRY_DROPPED", events[4].marker);
+    EXPECT_EQ("2", events[4].message);
+}
+
+TEST_F(UtilsTelemetryTest, concurrentSenders_noEventLost)
+{
+    Utils::Telemetry::Queue::instance().configure(10, 16, 1024);
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+        threads.emplace_back([]() {
+            for (int index = 0; index < 25000; index++) {
+                std::string message = "event " + std::to_string(index % 16);
+                Utils::Telemetry::sendMessage((char*)"MARKER_D", &message[0]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Utils::Telemetry::flush();
+
+    EXPECT_EQ(100000u, sink->total("MARKER_D"));
+    EXPECT_LT(sink->events().size(), 100000u);
+}
@@ -0,0 +1,112 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsgetFileContent.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+const char* propertiesFile = "/tmp/UtilsgetFileContentTest.properties";
+
+class UtilsgetFileContentTest : public ::testing::Test {
+protected:
+    UtilsgetFileContentTest()
+    {
+        ::unlink(propertiesFile);
+        Utils::PropertyFileCache::Instance().Clear();
+    }
+    ~UtilsgetFileContentTest() override
+    {
+        ::unlink(propertiesFile);
+    }
+
+    static void Write(const char* path, const std::string& content)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+};
+}
+
+TEST_F(UtilsgetFileContentTest, readProperty_expandsReferences)
+{
+    Write(propertiesFile,
+        "# MODEL_NUM=commented\n"
+        "MODEL_NUM=AX061AEI\r\n"
+        "PRODUCT=$MODEL_NUM\n"
+        "ALIAS=$PRODUCT\n"
+        "BROKEN=$UNDEFINED\n"
+        "LOOP=$LOOP\n"
+        "SPACED =value\n"
+        "EMPTY=\n");
+
+    std::string value;
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "MODEL_NUM", value));
+    EXPECT_EQ("AX061AEI", value);
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "ALIAS", value));
+    EXPECT_EQ("AX061AEI", value);
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "SPACED", value));
+    EXPECT_EQ("value", value);
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "EMPTY", value));
+    EXPECT_EQ("", value);
+
+    EXPECT_FALSE(Utils::readPropertyFromFile(propertiesFile, "BROKEN", value));
+    EXPECT_FALSE(Utils::readPropertyFromFile(propertiesFile, "LOOP", value));
+    EXPECT_FALSE(Utils::readPropertyFromFile(propertiesFile, "MODEL", value));
+    EXPECT_EQ("", value);
+}
+
+TEST_F(UtilsgetFileContentTest, readProperty_seesRewrittenFile)
+{
+    std::string value;
+    EXPECT_FALSE(Utils::readPropertyFromFile(propertiesFile, "BUILD_TYPE", value));
+
+    Write(propertiesFile, "BUILD_TYPE=dev\n");
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "BUILD_TYPE", value));
+    EXPECT_EQ("dev", value);
+
+    // rewritten in place
+    Write(propertiesFile, "BUILD_TYPE=prod\n");
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "BUILD_TYPE", value));
+    EXPECT_EQ("prod", value);
+
+    // replaced by rename
+    const std::string temp = std::string(propertiesFile) + ".new";
+    Write(temp.c_str(), "BUILD_TYPE=vbn\n");
+    ASSERT_EQ(0, std::rename(temp.c_str(), propertiesFile));
+    EXPECT_TRUE(Utils::readPropertyFromFile(propertiesFile, "BUILD_TYPE", value));
+    EXPECT_EQ("vbn", value);
+
+    ::unlink(propertiesFile);
+    EXPECT_FALSE(Utils::readPropertyFromFile(propertiesFile, "BUILD_TYPE", value));
+}
+
+TEST_F(UtilsgetFileContentTest, expandPropertiesInString_usesCache)
+{
+    Write(propertiesFile, "PERSISTENT_PATH=/opt/persistent\n");
+
+    std::string expanded;
+    EXPECT_TRUE(Utils::ExpandPropertiesInString("$PERSISTENT_PATH/logs", propertiesFile, expanded));
+    EXPECT_EQ("/opt/persistent/logs", expanded);
+}
@@ -33,6 +33,7 @@
 #include "ThunderPortability.h"
 #include "WorkerPoolImplementation.h"
 #include "COMLinkMock.h"
+#include "SpawnMock.h"
 #include <fstream>
 
 using namespace WPEFramework;
@@ -77,6 +78,7 @@ protected:
     WrapsImplMock     *p_wrapsImplMock   = nullptr;
     WarehouseMock     *p_warehouseMock   = nullptr;
     ServiceMock       *p_serviceMock     = nullptr;
+    SpawnImplMock     *p_spawnImplMock   = nullptr;
 
     WarehouseInitializedTest()
         : WarehouseTest()
@@ -94,6 +96,9 @@ protected:
         p_wrapsImplMock = new NiceMock<WrapsImplMock>;
         Wraps::setImpl(p_wrapsImplMock);
 
+        p_spawnImplMock = new NiceMock<SpawnImplMock>;
+        Utils::Spawn::setImpl(p_spawnImplMock);
+
         ON_CALL(comLinkMock, Instantiate(::testing::_, ::testing::_, ::testing::_))
             .WillByDefault(::testing::Invoke(
                 [&](const RPC::Object& object, const uint32_t waitTime, uint32_t& connectionId) {
@@ -141,6 +146,12 @@ protected:
             delete p_wrapsImplMock;
             p_wrapsImplMock = nullptr;
         }
+
+        Utils::Spawn::setImpl(nullptr);
+        if (p_spawnImplMock != nullptr) {
+            delete p_spawnImplMock;
+            p_spawnImplMock = nullptr;
+        }
     }
 };
 
@@ -157,14 +168,13 @@ TEST_F(WarehouseInitializedTest, registeredMethods)
 
 TEST_F(WarehouseInitializedTest, ColdFactoryResetDevice)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
-        .Times(2)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh coldfactory"));
-                return Core::ERROR_NONE;
-            }))
-        .WillRepeatedly(::testing::Return(Core::ERROR_NONE));
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "coldfactory"), ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Return(SpawnResult(0)));
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("/rebootNow.sh", "-s", "PowerMgr_coldFactoryReset", "-o", ::testing::_), ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // reset: suppress reboot: true, type: COLD
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true,\"resetType\":\"COLD\"}"), response));
@@ -173,14 +183,9 @@ TEST_F(WarehouseInitializedTest, ColdFactoryResetDevice)
 
 TEST_F(WarehouseInitializedTest, FactoryResetDevice)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "factory"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh factory"));
-                return Core::ERROR_NONE;
-            }))
-        .WillRepeatedly(::testing::Return(Core::ERROR_NONE));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // reset: suppress reboot: true, type: FACTORY
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true,\"resetType\":\"FACTORY\"}"), response));
@@ -189,13 +194,9 @@ TEST_F(WarehouseInitializedTest, FactoryResetDevice)
 
 TEST_F(WarehouseInitializedTest, UserFactoryResetDevice)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "userfactory"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh userfactory"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // reset: suppress reboot: true, type: USERFACTORY
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true,\"resetType\":\"USERFACTORY\"}"), response));
@@ -204,13 +205,9 @@ TEST_F(WarehouseInitializedTest, UserFactoryResetDevice)
 
 TEST_F(WarehouseInitializedTest, WarehouseClearResetDevice)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "WAREHOUSE_CLEAR"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh WAREHOUSE_CLEAR"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // reset: suppress reboot: false, type: WAREHOUSE_CLEAR
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":false,\"resetType\":\"WAREHOUSE_CLEAR\"}"), response));
@@ -236,13 +233,9 @@ TEST_F(WarehouseInitializedTest, WarehouseClearResetDeviceNoResponse)
                 return Core::ERROR_NONE;
             }));
     
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "WAREHOUSE_CLEAR", "--suppressReboot"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [&](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh WAREHOUSE_CLEAR --suppressReboot"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true,\"resetType\":\"WAREHOUSE_CLEAR\"}"), response));
     EXPECT_EQ(response, _T("{\"success\":true,\"error\":\"\"}"));
@@ -253,13 +246,9 @@ TEST_F(WarehouseInitializedTest, WarehouseClearResetDeviceNoResponse)
 TEST_F(WarehouseInitializedTest, GenericResetDevice)
 {
 
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "warehouse"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh warehouse"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // reset: suppress reboot: false
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":false}"), response));
@@ -285,13 +274,9 @@ TEST_F(WarehouseInitializedTest, GenericResetDeviceNoResponse)
                 return Core::ERROR_NONE;
             }));
 
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "warehouse", "--suppressReboot"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [&](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh warehouse --suppressReboot &"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true}"), response));
     EXPECT_EQ(response, _T("{\"success\":true,\"error\":\"\"}"));
@@ -302,13 +287,9 @@ TEST_F(WarehouseInitializedTest, GenericResetDeviceNoResponse)
 TEST_F(WarehouseInitializedTest, UserFactoryResetDeviceFailure)
 {
 
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "/lib/rdk/deviceReset.sh", "warehouse", "--suppressReboot"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh /lib/rdk/deviceReset.sh warehouse --suppressReboot &"));
-                return Core::ERROR_GENERAL;
-            }));
+        .WillOnce(::testing::Return(Utils::Spawn::Result()));
 
     // reset: suppress reboot: true - This doesn't generate any event (Expect no response)
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("resetDevice"), _T("{\"suppressReboot\":true}"), response));
@@ -326,12 +307,9 @@ TEST_F(WarehouseInitializedTest, internalResetFailPassPhrase)
 
 TEST_F(WarehouseInitializedTest, internalResetScriptFail)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
-        .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                return Core::ERROR_NONE;
-            }));
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::_, ::testing::_))
+        .Times(2)
+        .WillRepeatedly(::testing::Return(SpawnResult(0)));
 
     // Invoke internalReset - Correct pass phrase - Return error
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("internalReset"), _T("{\"passPhrase\":\"FOR TEST PURPOSES ONLY\"}"), response));
@@ -340,13 +318,13 @@ TEST_F(WarehouseInitializedTest, internalResetScriptFail)
 
 TEST_F(WarehouseInitializedTest, internalReset)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("rm", "-rf", "/opt/drm", "/opt/www/whitebox", "/opt/www/authService"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("rm -rf /opt/drm /opt/www/whitebox /opt/www/authService && /rebootNow.sh -s WarehouseService &"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("/rebootNow.sh", "-s", "WarehouseService"), ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // Invoke internalReset - Correct pass phrase - Return success
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("internalReset"), _T("{\"passPhrase\":\"FOR TEST PURPOSES ONLY\"}"), response));
@@ -355,12 +333,9 @@ TEST_F(WarehouseInitializedTest, internalReset)
 
 TEST_F(WarehouseInitializedTest, lightResetScriptFail)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::_, ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // Invoke lightReset - returns error
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("lightReset"), _T("{}"), response));
@@ -369,13 +344,9 @@ TEST_F(WarehouseInitializedTest, lightResetScriptFail)
 
 TEST_F(WarehouseInitializedTest, lightReset)
 {
-    EXPECT_CALL(*p_wrapsImplMock, v_secure_system(::testing::_, ::testing::_))
+    EXPECT_CALL(*p_spawnImplMock, Run(::testing::ElementsAre("sh", "-c", "rm -rf /opt/netflix/* SD_CARD_MOUNT_PATH/netflix/* XDG_DATA_HOME/* XDG_CACHE_HOME/* XDG_CACHE_HOME/../.sparkStorage/ /opt/QT/home/data/* /opt/hn_service_settings.conf /opt/apps/common/proxies.conf /opt/lib/bluetooth /opt/persistent/rdkservicestore"), ::testing::_))
         .Times(1)
-        .WillOnce(::testing::Invoke(
-            [](const char* command, va_list args) {
-                EXPECT_EQ(string(command), string("sh -c 'rm -rf /opt/netflix/* SD_CARD_MOUNT_PATH/netflix/* XDG_DATA_HOME/* XDG_CACHE_HOME/* XDG_CACHE_HOME/../.sparkStorage/ /opt/QT/home/data/* /opt/hn_service_settings.conf /opt/apps/common/proxies.conf /opt/lib/bluetooth /opt/persistent/rdkservicestore'"));
-                return Core::ERROR_NONE;
-            }));
+        .WillOnce(::testing::Return(SpawnResult(0)));
 
     // Invoke lightReset
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("lightReset"), _T("{}"), response));
@@ -0,0 +1,155 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "cSettings.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+const char* settingsFile = "/tmp/cSettingsTest.conf";
+
+class cSettingsTest : public ::testing::Test {
+protected:
+    cSettingsTest()
+    {
+        ::unlink(settingsFile);
+        ::unlink((std::string(settingsFile) + ".tmp").c_str());
+    }
+    ~cSettingsTest() override
+    {
+        ::unlink(settingsFile);
+    }
+
+    static std::string Content()
+    {
+        std::ifstream file(settingsFile);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    static bool WaitForContent(const std::string& expected, uint32_t timeoutInMs)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMs);
+        while ((Content().find(expected) == std::string::npos) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return (Content().find(expected) != std::string::npos);
+    }
+};
+}
+
+TEST_F(cSettingsTest, setValue_replacesFileAtomically)
+{
+    cSettings settings(settingsFile);
+    ASSERT_EQ(0, ::chmod(settingsFile, 0600));
+
+    EXPECT_TRUE(settings.setValue("mode", std::string("EAS")));
+    EXPECT_TRUE(settings.setValue("mode_duration", 10));
+    EXPECT_EQ("mode=EAS\nmode_duration=10\n", Content());
+
+    EXPECT_TRUE(settings.remove("mode"));
+    EXPECT_EQ("mode_duration=10\n", Content());
+
+    struct stat fileStat;
+    ASSERT_EQ(0, ::stat(settingsFile, &fileStat));
+    EXPECT_EQ(0600u, fileStat.st_mode & 07777);
+    EXPECT_FALSE(Utils::fileExists((std::string(settingsFile) + ".tmp").c_str()));
+
+    cSettings reread(settingsFile);
+    EXPECT_TRUE(reread.contains("mode_duration"));
+    EXPECT_FALSE(reread.contains("mode"));
+}
+
+TEST_F(cSettingsTest, transaction_writesOnCommit)
+{
+    cSettings settings(settingsFile);
+
+    settings.beginTransaction();
+    EXPECT_TRUE(settings.setValue("mode", std::string("WAREHOUSE")));
+    settings.beginTransaction();
+    EXPECT_TRUE(settings.setValue("mode_duration", 20));
+    EXPECT_TRUE(settings.commit());
+
+    // reads see the uncommitted state, the file does not
+    EXPECT_EQ("WAREHOUSE", settings.getValue("mode").String());
+    EXPECT_EQ("", Content());
+
+    EXPECT_TRUE(settings.commit());
+    EXPECT_EQ("mode=WAREHOUSE\nmode_duration=20\n", Content());
+    EXPECT_FALSE(settings.commit());
+}
+
+TEST_F(cSettingsTest, writeBehind_writesAfterQuietPeriod)
+{
+    cSettings settings(settingsFile);
+    ASSERT_TRUE(settings.enableWriteBehind(50, 1000));
+
+    EXPECT_TRUE(settings.setValue("mode_duration", 30));
+    EXPECT_EQ("30", settings.getValue("mode_duration").String());
+    EXPECT_EQ("", Content());
+    EXPECT_TRUE(WaitForContent("mode_duration=30", 2000));
+}
+
+TEST_F(cSettingsTest, writeBehind_maxDelayBoundsContinuousChanges)
+{
+    cSettings settings(settingsFile);
+    ASSERT_TRUE(settings.enableWriteBehind(100, 200));
+
+    // a change every 20ms never leaves a quiet period
+    bool written = false;
+    for (int index = 0; (index < 50) && (written == false); index++) {
+        settings.setValue("mode_duration", index);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        written = (Content().empty() == false);
+    }
+    EXPECT_TRUE(written);
+}
+
+TEST_F(cSettingsTest, failedWrite_staysPending)
+{
+    {
+        cSettings settings(settingsFile);
+        ASSERT_TRUE(settings.enableWriteBehind(60000, 60000));
+        settings.setValue("mode", std::string("EAS"));
+        ASSERT_EQ(0, ::unlink(settingsFile));
+        EXPECT_FALSE(settings.flush());
+
+        std::ofstream(settingsFile).close();
+    }
+    EXPECT_EQ("mode=EAS\n", Content());
+}
+
+TEST_F(cSettingsTest, destructor_writesPendingChanges)
+{
+    {
+        cSettings settings(settingsFile);
+        ASSERT_TRUE(settings.enableWriteBehind(60000, 60000));
+        settings.setValue("mode", std::string("NORMAL"));
+        EXPECT_EQ("", Content());
+    }
+    EXPECT_EQ("mode=NORMAL\n", Content());
+}
@@ -0,0 +1,135 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+/*
+ * Local producer for the FrameRate shared-memory sample ring, needs no Thunder
+ * runtime.
+ *
+ *   FrameRateSampleRingTest selftest [samples]
+ *       Creates a private ring, runs a producer and a consumer thread and
+ *       validates ordering and loss, then prints the throughput.
+ *
+ *   FrameRateSampleRingTest produce <name> [fps] [seconds]
+ *       Attaches to the ring created by FrameRateImplementation (the
+ *       "samplering" configuration) and pushes frame-present timestamps at
+ *       the given cadence, like a compositor would.
+ */
+
+#include "FpsSampleRing.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+using namespace WPEFramework::Plugin;
+
+static uint64_t MonotonicMicroseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000);
+}
+
+static int SelfTest(uint64_t samples)
+{
+    const std::string name = "/framerate-ringtest-" + std::to_string(getpid());
+    FpsSampleRing consumer;
+    if (!consumer.Create(name, 4096)) {
+        std::cerr << "Failure Create: " << name << std::endl;
+        return 1;
+    }
+
+    FpsSampleRing producer;
+    if (!producer.Open(name)) {
+        std::cerr << "Failure Open: " << name << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producerThread([&producer, samples]() {
+        for (uint64_t value = 1; value <= samples; value++) {
+            while (!producer.Push(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 1;
+    uint64_t buffer[256];
+    bool ordered = true;
+    while (expected <= samples) {
+        const uint32_t count = consumer.Pop(buffer, 256);
+        for (uint32_t index = 0; index < count; index++) {
+            ordered = ordered && (buffer[index] == expected);
+            expected++;
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producerThread.join();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << (ordered ? "Success" : "Failure") << " selftest: samples - " << samples
+              << " full-ring retries - " << consumer.Dropped()
+              << " elapsed - " << elapsed << "us"
+              << " rate - " << ((elapsed > 0) ? ((samples * 1000000) / elapsed) : 0) << " samples/s" << std::endl;
+    return ordered ? 0 : 1;
+}
+
+static int Produce(const std::string& name, uint32_t fps, uint32_t seconds)
+{
+    FpsSampleRing producer;
+    if (!producer.Open(name)) {
+        std::cerr << "Failure Open: " << name << " (is FrameRate configured with this samplering?)" << std::endl;
+        return 1;
+    }
+
+    const auto period = std::chrono::microseconds(1000000 / fps);
+    auto next = std::chrono::steady_clock::now();
+    uint64_t pushed = 0;
+    for (uint64_t frame = 0; frame < (static_cast<uint64_t>(fps) * seconds); frame++) {
+        pushed += producer.Push(MonotonicMicroseconds()) ? 1 : 0;
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    std::cout << "Success produce: pushed - " << pushed << " dropped - " << producer.Dropped() << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string mode = (argc > 1) ? argv[1] : "selftest";
+
+    if (mode == "selftest") {
+        return SelfTest((argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if ((mode == "produce") && (argc > 2)) {
+        const uint32_t fps = (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 60;
+        const uint32_t seconds = (argc > 4) ? static_cast<uint32_t>(std::atoi(argv[4])) : 10;
+        return Produce(argv[2], (fps > 0) ? fps : 60, seconds);
+    }
+
+    std::cerr << "Usage: " << argv[0] << " selftest [samples] | produce <name> [fps] [seconds]" << std::endl;
+    return 1;
+}
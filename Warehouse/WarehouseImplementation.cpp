@@ -21,7 +21,6 @@
 
 #include <algorithm>
 #include <fstream>
-#include "secure_wrapper.h"
 #include <regex.h>
 #include <regex>
 #include <time.h>
@@ -37,6 +36,7 @@
 #include "UtilsString.h"
 #include "UtilsfileExists.h"
 #include "UtilsgetFileContent.h"
+#include "UtilsSpawn.h"
 
 #include "rfcapi.h"
 
@@ -55,7 +55,6 @@
 #define CUSTOM_DATA_FILE "/lib/rdk/wh_api_5.conf"
 
 #define LIGHT_RESET_SCRIPT "/opt/netflix/* SD_CARD_MOUNT_PATH/netflix/* XDG_DATA_HOME/* XDG_CACHE_HOME/* XDG_CACHE_HOME/../.sparkStorage/ /opt/QT/home/data/* /opt/hn_service_settings.conf /opt/apps/common/proxies.conf /opt/lib/bluetooth /opt/persistent/rdkservicestore"
-#define INTERNAL_RESET_SCRIPT "rm -rf /opt/drm /opt/www/whitebox /opt/www/authService && /rebootNow.sh -s WarehouseService &"
 
 #define FRONT_PANEL_NONE -1
 #define FRONT_PANEL_INPROGRESS 1
@@ -107,7 +106,7 @@ namespace WPEFramework
         WarehouseImplementation* WarehouseImplementation::_instance = nullptr;
     
         WarehouseImplementation::WarehouseImplementation() : 
-        _adminLock() 
+        _warehouseNotification()
         {
             LOGINFO("Create WarehouseImplementation Instance");
 
@@ -130,21 +129,12 @@ namespace WPEFramework
         {
             ASSERT (nullptr != notification);
 
-            _adminLock.Lock();
-
             // Make sure we can't register the same notification callback multiple times
-            if (std::find(_warehouseNotification.begin(), _warehouseNotification.end(), notification) == _warehouseNotification.end())
-            {
-                _warehouseNotification.push_back(notification);
-                notification->AddRef();
-            }
-            else
+            if (!_warehouseNotification.Register(notification))
             {
                 LOGERR("same notification is registered already");
             }
 
-            _adminLock.Unlock();
-
             return Core::ERROR_NONE;
         }
 
@@ -154,14 +144,9 @@ namespace WPEFramework
 
             ASSERT (nullptr != notification);
 
-            _adminLock.Lock();
-
             // we just unregister one notification once
-            auto itr = std::find(_warehouseNotification.begin(), _warehouseNotification.end(), notification);
-            if (itr != _warehouseNotification.end())
+            if (_warehouseNotification.Unregister(notification))
             {
-                (*itr)->Release();
-                _warehouseNotification.erase(itr);
                 status = Core::ERROR_NONE;
             }
             else
@@ -169,8 +154,6 @@ namespace WPEFramework
                 LOGERR("notification not found");
             }
 
-            _adminLock.Unlock();
-
             return status;
         }
 
@@ -377,8 +360,8 @@ namespace WPEFramework
             {
 #if defined(USE_IARMBUS) || defined(USE_IARM_BUS)
                 std::string error = "";
-                int return_value = v_secure_system("rm -rf /opt/drm /opt/www/whitebox /opt/www/authService && /rebootNow.sh -s WarehouseService &");
-                bool ok = return_value == 0;
+                bool ok = Utils::Spawn::Run({ "rm", "-rf", "/opt/drm", "/opt/www/whitebox", "/opt/www/authService" }).Succeeded()
+                    && Utils::Spawn::Detach({ "/rebootNow.sh", "-s", "WarehouseService" });
                 successErr.success = ok;
                 if (!ok)
                     successErr.error = error;
@@ -650,8 +633,8 @@ namespace WPEFramework
             LOGWARN("lightReset: %s", script.c_str());
 
             std::string error = "";
-            int return_value = v_secure_system("sh -c 'rm -rf " LIGHT_RESET_SCRIPT "'");
-            bool ok = return_value == 0;
+            // the script relies on the shell to expand its wildcards
+            bool ok = Utils::Spawn::Run({ "sh", "-c", "rm -rf " LIGHT_RESET_SCRIPT }).Succeeded();
 
             (void)remove("/opt/secure/persistent/rdkservicestore");
 
@@ -719,19 +702,15 @@ namespace WPEFramework
 
         void WarehouseImplementation::Dispatch(Event event, const JsonObject &params)
         {
-            _adminLock.Lock();
-        
-            std::list<Exchange::IWarehouse::INotification*>::const_iterator index(_warehouseNotification.begin());
-        
             switch(event)
             {
                 case WAREHOUSE_EVT_RESET_DONE:
-                    while (index != _warehouseNotification.end()) 
                     {
                         bool success = params["success"].Boolean();
                         string error = params["error"].String();
-                        (*index)->ResetDone(success,error);
-                        ++index;
+                        _warehouseNotification.Notify([success, &error](Exchange::IWarehouse::INotification* notification) {
+                            notification->ResetDone(success, error);
+                        });
                     }
                     break;
  
@@ -739,7 +718,6 @@ namespace WPEFramework
                     LOGWARN("Event[%u] not handled", event);
                     break;
             }
-            _adminLock.Unlock();
         }
 
         uint32_t WarehouseImplementation::processColdFactoryReset()
@@ -750,10 +728,10 @@ namespace WPEFramework
             LOGINFO(" Reset: ...Clearing data from your box before reseting \n");
             fflush(stdout);
             /*Execute the script for Cold Factory Reset*/
-            v_secure_system("sh /lib/rdk/deviceReset.sh coldfactory");
+            Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "coldfactory" });
             resetWarehouseRebootFlag();
             sleep(5);
-            v_secure_system(" /rebootNow.sh -s PowerMgr_coldFactoryReset -o 'Rebooting the box due to Cold Factory Reset process ...'");
+            Utils::Spawn::Run({ "/rebootNow.sh", "-s", "PowerMgr_coldFactoryReset", "-o", "Rebooting the box due to Cold Factory Reset process ..." });
             return Core::ERROR_NONE;
         }
 
@@ -765,7 +743,7 @@ namespace WPEFramework
             LOGINFO("Reset: ...Clearing data from your box before reseting \n");
             fflush(stdout);
             /*Execute the script for Factory Reset*/
-            v_secure_system("sh /lib/rdk/deviceReset.sh factory");
+            Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "factory" });
             resetWarehouseRebootFlag();
             return Core::ERROR_NONE;
         }
@@ -777,7 +755,7 @@ namespace WPEFramework
             /*Execute the script for Ware House Reset*/
             resetWarehouseRebootFlag();
             std::ofstream { "/tmp/.warehouse-reset" };
-            return v_secure_system("sh /lib/rdk/deviceReset.sh warehouse");
+            return Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "warehouse" }).Succeeded() ? Core::ERROR_NONE : Core::ERROR_GENERAL;
         }
 
         uint32_t WarehouseImplementation::processWHClear()
@@ -787,7 +765,7 @@ namespace WPEFramework
             fflush(stdout);
             resetWarehouseRebootFlag();
             std::ofstream { "/tmp/.warehouse-clear" };
-            v_secure_system("sh /lib/rdk/deviceReset.sh WAREHOUSE_CLEAR");
+            Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "WAREHOUSE_CLEAR" });
             return Core::ERROR_NONE;
         }
 
@@ -796,7 +774,7 @@ namespace WPEFramework
             LOGINFO("\n Clear: Invoking Ware House Clear Request from APP\n");
             fflush(stdout);
             std::ofstream { "/tmp/.warehouse-clear" };
-            return v_secure_system("sh /lib/rdk/deviceReset.sh WAREHOUSE_CLEAR --suppressReboot");
+            return Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "WAREHOUSE_CLEAR", "--suppressReboot" }).Succeeded() ? Core::ERROR_NONE : Core::ERROR_GENERAL;
         }
 
         uint32_t WarehouseImplementation::processWHResetNoReboot()
@@ -805,7 +783,7 @@ namespace WPEFramework
             fflush(stdout);
             /*Execute the script for Ware House Reset*/
             std::ofstream { "/tmp/.warehouse-reset" };
-            return v_secure_system("sh /lib/rdk/deviceReset.sh warehouse --suppressReboot &");
+            return Utils::Spawn::Detach({ "sh", "/lib/rdk/deviceReset.sh", "warehouse", "--suppressReboot" }) ? Core::ERROR_NONE : Core::ERROR_GENERAL;
         }
 
         uint32_t WarehouseImplementation::processUserFactoryReset()
@@ -814,7 +792,7 @@ namespace WPEFramework
             fflush(stdout);
             /*Execute the script for User Factory Reset*/
             resetWarehouseRebootFlag();
-            v_secure_system("sh /lib/rdk/deviceReset.sh userfactory");
+            Utils::Spawn::Run({ "sh", "/lib/rdk/deviceReset.sh", "userfactory" });
             return Core::ERROR_NONE;
         }
 
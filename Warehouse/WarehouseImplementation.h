@@ -28,6 +28,7 @@
 
 #include <thread>
 
+#include "UtilsNotificationRegistry.h"
 #include "UtilsThreadRAII.h"
 #include "libIARM.h"
 
@@ -107,8 +108,7 @@ namespace WPEFramework
             Core::hresult ResetDevice(const bool suppressReboot, const string& resetType, WarehouseSuccessErr& successErr) override;
 
         private:
-            mutable Core::CriticalSection _adminLock;
-            std::list<Exchange::IWarehouse::INotification*> _warehouseNotification;
+            Utils::NotificationRegistry<Exchange::IWarehouse::INotification> _warehouseNotification;
             Utils::ThreadRAII m_resetThread;
             
             void dispatchEvent(Event, const JsonObject &params);
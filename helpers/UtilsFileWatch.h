@@ -0,0 +1,445 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2025 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "UtilsLogging.h"
+
+// changes of a file within this time after its first change are reported with one callback
+#define FILE_WATCH_COALESCE_IN_MS 100
+
+namespace Utils {
+
+/**
+ * One inotify fd and one thread watching files for all subscribers.
+ *
+ * The directory of a file is watched rather than the file itself, so a file
+ * that does not exist yet, is deleted, or is replaced by a rename (e.g.
+ * cSettings) keeps being reported. All the changes of a file within the
+ * coalesce period after its first change are reported with one call of each
+ * of its callbacks, on the watch thread, after that period.
+ *
+ * A callback must not block; it may Subscribe() and Unsubscribe().
+ */
+class FileWatch {
+public:
+    using Callback = std::function<void(const std::string& path)>;
+
+    static FileWatch& Instance()
+    {
+        // never destroyed, plugins may still unsubscribe during static destruction
+        static FileWatch* watch = new FileWatch();
+        return *watch;
+    }
+
+    explicit FileWatch(uint32_t coalesceInMs = FILE_WATCH_COALESCE_IN_MS)
+        : _lock()
+        , _idle()
+        , _subscriptions()
+        , _directories()
+        , _pending()
+        , _nextId(1)
+        , _running(0)
+        , _coalesceInMs(coalesceInMs)
+        , _inotify(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+        , _wakeup(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , _stopping(false)
+        , _thread()
+    {
+        if ((_inotify < 0) || (_wakeup < 0)) {
+            LOGERR("inotify unavailable (%d), files can't be watched", errno);
+        } else {
+            _thread = std::thread(&FileWatch::Loop, this);
+        }
+    }
+
+    ~FileWatch()
+    {
+        if (_thread.joinable()) {
+            _stopping = true;
+            Wakeup();
+            _thread.join();
+        }
+        if (_wakeup >= 0) {
+            close(_wakeup);
+        }
+        if (_inotify >= 0) {
+            close(_inotify);
+        }
+    }
+
+    FileWatch(const FileWatch&) = delete;
+    FileWatch& operator=(const FileWatch&) = delete;
+
+    /**
+     * @brief Call callback when path is created, modified, deleted or replaced.
+     *        The directory of path must exist.
+     * @return id for Unsubscribe(), 0 if path can't be watched.
+     */
+    uint32_t Subscribe(const std::string& path, const Callback& callback)
+    {
+        if ((_inotify < 0) || (_wakeup < 0) || !callback) {
+            return 0;
+        }
+        const size_t slash = path.find_last_of('/');
+        const std::string directory = (slash == std::string::npos) ? "." : ((slash == 0) ? "/" : path.substr(0, slash));
+        const std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+        if (name.empty()) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(_lock);
+        const int watch = inotify_add_watch(_inotify, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+        if (watch < 0) {
+            LOGERR("Can't watch %s: %s", directory.c_str(), strerror(errno));
+            return 0;
+        }
+        Directory& entry = _directories[watch];
+        entry.path = directory;
+        entry.references++;
+
+        const uint32_t id = _nextId++;
+        Subscription& subscription = _subscriptions[id];
+        subscription.path = path;
+        subscription.name = name;
+        subscription.watch = watch;
+        subscription.callback = callback;
+        return id;
+    }
+
+    /**
+     * @brief Stop calling the callback of id. When called from another thread than
+     *        the callback's, the callback has returned when this returns.
+     */
+    void Unsubscribe(uint32_t id)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        auto subscription = _subscriptions.find(id);
+        if (subscription == _subscriptions.end()) {
+            return;
+        }
+        auto directory = _directories.find(subscription->second.watch);
+        if ((directory != _directories.end()) && (--directory->second.references == 0)) {
+            inotify_rm_watch(_inotify, directory->first);
+            _directories.erase(directory);
+        }
+        _subscriptions.erase(subscription);
+        _pending.erase(id);
+
+        if (std::this_thread::get_id() != _thread.get_id()) {
+            _idle.wait(lock, [this, id]() { return (_running != id); });
+        }
+    }
+
+    /**
+     * @brief Whether the file of id changed and its callback has not returned yet.
+     *        Reads the queued inotify events first, so a change made before this
+     *        call is seen even if the watch thread has not got to it.
+     */
+    bool IsPending(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if ((_inotify >= 0) && DrainLocked()) {
+            // to dispatch what was drained here
+            Wakeup();
+        }
+        return ((_pending.find(id) != _pending.end()) || (_running == id));
+    }
+
+    /**
+     * @brief Whether the directory of id is still watched. Once it is removed the
+     *        subscription stays silent; subscribe again to watch the new directory.
+     */
+    bool IsWatched(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto subscription = _subscriptions.find(id);
+        return ((subscription != _subscriptions.end()) && (subscription->second.watch >= 0));
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Subscription {
+        Subscription()
+            : path()
+            , name()
+            , watch(-1)
+            , callback()
+        {
+        }
+
+        std::string path;
+        std::string name; // in the directory
+        int watch; // of the directory
+        Callback callback;
+    };
+
+    struct Directory {
+        Directory()
+            : path()
+            , references(0)
+        {
+        }
+
+        std::string path;
+        uint32_t references; // subscriptions
+    };
+
+    void Wakeup()
+    {
+        const uint64_t one = 1;
+        if (write(_wakeup, &one, sizeof(one)) < 0) {
+            LOGERR("Failed to wake up the file watch: %s", strerror(errno));
+        }
+    }
+
+    void Loop()
+    {
+        struct pollfd descriptors[2] = { { _inotify, POLLIN, 0 }, { _wakeup, POLLIN, 0 } };
+        while (!_stopping) {
+            int timeoutInMs = -1;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (!_pending.empty()) {
+                    Clock::time_point first = Clock::time_point::max();
+                    for (const auto& pending : _pending) {
+                        first = std::min(first, pending.second);
+                    }
+                    const int64_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(first - Clock::now()).count() + 1;
+                    timeoutInMs = (remaining > 0) ? static_cast<int>(remaining) : 0;
+                }
+            }
+
+            descriptors[0].revents = 0;
+            descriptors[1].revents = 0;
+            if ((poll(descriptors, 2, timeoutInMs) < 0) && (errno != EINTR)) {
+                LOGERR("File watch poll failed: %s", strerror(errno));
+                break;
+            }
+            if ((descriptors[1].revents & POLLIN) != 0) {
+                uint64_t count;
+                const ssize_t length = read(_wakeup, &count, sizeof(count));
+                (void)length;
+            }
+            if ((descriptors[0].revents & POLLIN) != 0) {
+                Drain();
+            }
+            Dispatch();
+        }
+    }
+
+    // Marks the subscriptions of changed files as pending.
+    void Drain()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        DrainLocked();
+    }
+
+    // @return true if there were any events
+    bool DrainLocked()
+    {
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        bool drained = false;
+        const Clock::time_point due = Clock::now() + std::chrono::milliseconds(_coalesceInMs);
+
+        while ((length = read(_inotify, buffer, sizeof(buffer))) > 0) {
+            drained = true;
+            for (char* position = buffer; position < (buffer + length);) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(position);
+                position += sizeof(struct inotify_event) + event->len;
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                    LOGWARN("File watch queue overflow, reporting all files as changed");
+                    for (const auto& subscription : _subscriptions) {
+                        _pending.emplace(subscription.first, due);
+                    }
+                    continue;
+                }
+                if ((event->mask & IN_IGNORED) != 0) {
+                    // directory is gone, its subscriptions are reported once more and then stay silent (IsWatched())
+                    auto directory = _directories.find(event->wd);
+                    if (directory != _directories.end()) {
+                        LOGWARN("%s is no longer watched", directory->second.path.c_str());
+                        _directories.erase(directory);
+                    }
+                    for (auto& subscription : _subscriptions) {
+                        if (subscription.second.watch == event->wd) {
+                            subscription.second.watch = -1;
+                            _pending.emplace(subscription.first, due);
+                        }
+                    }
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+                for (const auto& subscription : _subscriptions) {
+                    if ((subscription.second.watch == event->wd) && (subscription.second.name == event->name)) {
+                        // keeps the due time of an earlier change
+                        _pending.emplace(subscription.first, due);
+                    }
+                }
+            }
+        }
+        return drained;
+    }
+
+    // Calls the callbacks whose coalesce period is over.
+    void Dispatch()
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        const Clock::time_point now = Clock::now();
+        auto pending = _pending.begin();
+        while (pending != _pending.end()) {
+            if (pending->second > now) {
+                ++pending;
+                continue;
+            }
+            const uint32_t id = pending->first;
+            pending = _pending.erase(pending);
+            auto subscription = _subscriptions.find(id);
+            if (subscription == _subscriptions.end()) {
+                continue;
+            }
+            const Callback callback = subscription->second.callback;
+            const std::string path = subscription->second.path;
+            _running = id;
+            lock.unlock();
+
+            callback(path);
+
+            lock.lock();
+            _running = 0;
+            _idle.notify_all();
+            // the callback may have changed _pending
+            pending = _pending.begin();
+        }
+    }
+
+private:
+    std::mutex _lock;
+    std::condition_variable _idle; // no callback running
+    std::unordered_map<uint32_t, Subscription> _subscriptions;
+    std::unordered_map<int, Directory> _directories; // inotify watch -> watched directory
+    std::map<uint32_t, Clock::time_point> _pending; // subscription -> when to call it
+    uint32_t _nextId;
+    uint32_t _running; // subscription whose callback is running, 0 if none
+    const uint32_t _coalesceInMs;
+    const int _inotify;
+    const int _wakeup;
+    std::atomic<bool> _stopping;
+    std::thread _thread;
+};
+
+/**
+ * Content of a file that is read again only after FileWatch reported a change.
+ *
+ * Read() also reloads while the change is still pending in FileWatch, so the
+ * first Read() after a write sees it, on any thread. If the file can't be
+ * watched (no inotify, no directory yet) every Read() reads the file and
+ * tries to watch it again, also after its directory was removed.
+ */
+class WatchedFile {
+public:
+    explicit WatchedFile(const std::string& path, FileWatch& watch = FileWatch::Instance())
+        : _path(path)
+        , _watch(watch)
+        , _lock()
+        , _id(0)
+        , _stale(true)
+        , _exists(false)
+        , _content()
+    {
+    }
+
+    ~WatchedFile()
+    {
+        if (_id != 0) {
+            _watch.Unsubscribe(_id);
+        }
+    }
+
+    WatchedFile(const WatchedFile&) = delete;
+    WatchedFile& operator=(const WatchedFile&) = delete;
+
+    /**
+     * @brief Content of the file, from the cache unless it changed.
+     * @return false if the file can't be read.
+     */
+    bool Read(std::string& content)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_id == 0) {
+            // before reading, so a change in between is not missed
+            _id = _watch.Subscribe(_path, [this](const std::string&) { _stale = true; });
+        }
+        bool reload = ((_id == 0) || _stale.exchange(false) || _watch.IsPending(_id));
+        if ((_id != 0) && !_watch.IsWatched(_id)) {
+            // the directory was removed, watch the one that replaces it
+            _watch.Unsubscribe(_id);
+            _id = _watch.Subscribe(_path, [this](const std::string&) { _stale = true; });
+            if (_id == 0) {
+                // the directory is not back yet, reload once it is watched again
+                _stale = true;
+            }
+            reload = true;
+        }
+        if (reload) {
+            std::ifstream file(_path);
+            _exists = file.is_open();
+            _content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        content = _content;
+        return _exists;
+    }
+
+private:
+    const std::string _path;
+    FileWatch& _watch;
+    std::mutex _lock;
+    uint32_t _id;
+    std::atomic<bool> _stale;
+    bool _exists;
+    std::string _content;
+};
+
+} // namespace Utils
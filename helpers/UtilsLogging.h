@@ -21,10 +21,456 @@
 
 #include <syscall.h>
 
-#define LOGINFO(fmt, ...) do { fprintf(stderr, "[%d] INFO [%s:%d] %s: " fmt "\n", (int)syscall(SYS_gettid), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__); fflush(stderr); } while (0)
-#define LOGWARN(fmt, ...) do { fprintf(stderr, "[%d] WARN [%s:%d] %s: " fmt "\n", (int)syscall(SYS_gettid), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__); fflush(stderr); } while (0)
-#define LOGERR(fmt, ...) do { fprintf(stderr, "[%d] ERROR [%s:%d] %s: " fmt "\n", (int)syscall(SYS_gettid), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__); fflush(stderr); } while (0)
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define LOGINFO(fmt, ...) Utils::Logging::Write("[%d] INFO [%s:%d] %s: " fmt "\n", Utils::Logging::ThreadId(), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__)
+#define LOGWARN(fmt, ...) Utils::Logging::Write("[%d] WARN [%s:%d] %s: " fmt "\n", Utils::Logging::ThreadId(), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__)
+#define LOGERR(fmt, ...) Utils::Logging::Write("[%d] ERROR [%s:%d] %s: " fmt "\n", Utils::Logging::ThreadId(), WPEFramework::Core::FileNameOnly(__FILE__), __LINE__, __FUNCTION__, ##__VA_ARGS__)
 
 #define LOG_DEVICE_EXCEPTION0() LOGWARN("Exception caught: code=%d message=%s", err.getCode(), err.what());
 #define LOG_DEVICE_EXCEPTION1(param1) LOGWARN("Exception caught" #param1 "=%s code=%d message=%s", param1.c_str(), err.getCode(), err.what());
 #define LOG_DEVICE_EXCEPTION2(param1, param2) LOGWARN("Exception caught " #param1 "=%s " #param2 "=%s code=%d message=%s", param1.c_str(), param2.c_str(), err.getCode(), err.what());
+
+namespace Utils {
+namespace Logging {
+
+    enum class Overflow {
+        DROP, // count the message and continue (default)
+        BLOCK // wait for the writer thread to make room
+    };
+
+    /**
+     * Kernel thread id of the caller, cached per thread. The fork generation
+     * makes the forking thread look it up again in the child.
+     */
+    inline std::atomic<uint32_t>& ForkGeneration()
+    {
+        static std::atomic<uint32_t> generation(0);
+        return (generation);
+    }
+
+    inline int ThreadId()
+    {
+        static thread_local int tid = -1;
+        static thread_local uint32_t generation = 0;
+        const uint32_t current = ForkGeneration().load(std::memory_order_relaxed);
+        if ((tid < 0) || (generation != current)) {
+            tid = static_cast<int>(syscall(SYS_gettid));
+            generation = current;
+        }
+        return (tid);
+    }
+
+    /**
+     * Asynchronous stderr backend of LOGINFO/LOGWARN/LOGERR.
+     *
+     * Callers format into a slot of a bounded multi-producer ring (no lock, no
+     * system call) and a single writer thread drains it to stderr, flushing
+     * once per batch. After a batch the writer polls the ring again after
+     * LOG_WRITER_POLL_IN_MS and only goes to sleep once a poll found it empty,
+     * so while messages keep coming nobody has to wake it; the first message
+     * after that wakes it. When the ring is full the Overflow policy applies;
+     * dropped messages are reported by the writer.
+     *
+     * Messages longer than LOG_MESSAGE_SIZE, messages written after exit()
+     * started and messages in a forked child are written synchronously.
+     * UTILS_LOG_ASYNC=0 in the environment disables the backend,
+     * UTILS_LOG_OVERFLOW=block selects the blocking policy.
+     * Call Flush() before anything that ends the process (reboot, abort).
+     * Fatal signals (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) and
+     * std::terminate drain the queue with write(2) before the previous
+     * handler runs, so a crash does not take the last messages with it.
+     */
+    class AsyncWriter {
+    public:
+        static constexpr uint32_t LOG_SLOTS = 512; // power of two
+        static constexpr uint32_t LOG_MESSAGE_SIZE = 512;
+        static constexpr uint32_t LOG_WRITER_POLL_IN_MS = 5;
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence;
+            uint32_t length;
+            char message[LOG_MESSAGE_SIZE];
+        };
+
+    public:
+        static AsyncWriter& Instance()
+        {
+            // never destroyed, static destructors may still log during exit
+            static AsyncWriter* writer = new AsyncWriter();
+            return (*writer);
+        }
+
+        AsyncWriter(const AsyncWriter&) = delete;
+        AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+        void Write(const char* format, va_list arguments)
+        {
+            char line[LOG_MESSAGE_SIZE];
+            va_list copy;
+            va_copy(copy, arguments);
+            const int length = vsnprintf(line, sizeof(line), format, arguments);
+
+            if (length < 0) {
+                va_end(copy);
+                return;
+            }
+            if ((_synchronous.load(std::memory_order_relaxed) == true) || (static_cast<uint32_t>(length) >= LOG_MESSAGE_SIZE)) {
+                std::string message(static_cast<size_t>(length) + 1, '\0');
+                vsnprintf(&message[0], message.size(), format, copy);
+                va_end(copy);
+                Flush();
+                WriteDirect(message.c_str(), static_cast<size_t>(length));
+                return;
+            }
+            va_end(copy);
+
+            if (Push(line, static_cast<uint32_t>(length)) == false) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Returns once everything logged before the call is written to stderr.
+        void Flush()
+        {
+            if ((_started == false) || (_synchronous.load(std::memory_order_relaxed) == true)) {
+                return;
+            }
+            const uint64_t target = _head.load();
+            const uint64_t dropped = _dropped.load();
+            std::unique_lock<std::mutex> lock(_adminLock);
+            _flushTarget = std::max(_flushTarget, target);
+            _signal.notify_one();
+            while ((_written < target) || (_writtenDropped < dropped)) {
+                _flushed.wait(lock);
+            }
+        }
+
+        void Policy(Overflow policy)
+        {
+            _policy.store(policy, std::memory_order_relaxed);
+        }
+
+        Overflow Policy() const
+        {
+            return (_policy.load(std::memory_order_relaxed));
+        }
+
+        uint64_t Dropped() const
+        {
+            return (_dropped.load(std::memory_order_relaxed));
+        }
+
+    private:
+        AsyncWriter()
+            : _head(0)
+            , _tail(0)
+            , _written(0)
+            , _flushTarget(0)
+            , _dropped(0)
+            , _reportedDropped(0)
+            , _writtenDropped(0)
+            , _policy(Overflow::DROP)
+            , _synchronous(false)
+            , _sleeping(false)
+            , _draining(false)
+            , _started(false)
+            , _adminLock()
+            , _signal()
+            , _flushed()
+        {
+            for (uint32_t index = 0; index < LOG_SLOTS; index++) {
+                _slots[index].sequence.store(index, std::memory_order_relaxed);
+            }
+
+            const char* async = ::getenv("UTILS_LOG_ASYNC");
+            const char* overflow = ::getenv("UTILS_LOG_OVERFLOW");
+            if ((overflow != nullptr) && (::strcmp(overflow, "block") == 0)) {
+                _policy = Overflow::BLOCK;
+            }
+
+            if ((async != nullptr) && (::strcmp(async, "0") == 0)) {
+                _synchronous = true;
+            } else {
+                try {
+                    std::thread(&AsyncWriter::Process, this).detach();
+                    _started = true;
+                    ::atexit(&AsyncWriter::AtExit);
+                    ::pthread_atfork(nullptr, nullptr, &AsyncWriter::AtForkChild);
+                    InstallFatalHandlers();
+                } catch (const std::system_error&) {
+                    _synchronous = true;
+                }
+            }
+        }
+
+        static void AtExit()
+        {
+            AsyncWriter& writer = Instance();
+            writer.Flush();
+            writer._synchronous = true;
+        }
+
+        static void AtForkChild()
+        {
+            // the writer thread does not exist in the child
+            Instance()._synchronous = true;
+            ForkGeneration()++;
+        }
+
+        static constexpr uint32_t FATAL_SIGNAL_COUNT = 5;
+
+        static const int* FatalSignals()
+        {
+            static const int signals[FATAL_SIGNAL_COUNT] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+            return (signals);
+        }
+
+        static struct sigaction* PreviousActions()
+        {
+            static struct sigaction actions[FATAL_SIGNAL_COUNT];
+            return (actions);
+        }
+
+        static std::terminate_handler& PreviousTerminate()
+        {
+            static std::terminate_handler handler = nullptr;
+            return (handler);
+        }
+
+        static void InstallFatalHandlers()
+        {
+            struct sigaction action;
+            ::memset(&action, 0, sizeof(action));
+            action.sa_handler = &AsyncWriter::OnFatalSignal;
+            action.sa_flags = SA_NODEFER;
+            sigemptyset(&action.sa_mask);
+            for (uint32_t index = 0; index < FATAL_SIGNAL_COUNT; index++) {
+                ::sigaction(FatalSignals()[index], &action, &PreviousActions()[index]);
+            }
+            PreviousTerminate() = std::set_terminate(&AsyncWriter::OnTerminate);
+        }
+
+        // Drains the queue, then hands the signal to the handler that was installed before.
+        static void OnFatalSignal(int signal)
+        {
+            const int error = errno;
+            Instance().Drain();
+            for (uint32_t index = 0; index < FATAL_SIGNAL_COUNT; index++) {
+                if (FatalSignals()[index] == signal) {
+                    ::sigaction(signal, &PreviousActions()[index], nullptr);
+                    break;
+                }
+            }
+            errno = error;
+            // a fault re-executes the instruction on return, a raised signal has to be raised again
+            ::raise(signal);
+        }
+
+        static void OnTerminate()
+        {
+            Instance().Drain();
+            std::terminate_handler previous = PreviousTerminate();
+            if (previous != nullptr) {
+                previous();
+            }
+            ::abort();
+        }
+
+        // Writes out the queued messages with write(2) only, safe in a signal handler and on the
+        // writer thread itself. A message the writer thread is writing at the same time may be
+        // written twice. Everything logged afterwards is written synchronously.
+        void Drain()
+        {
+            if (_draining.exchange(true) == true) {
+                return;
+            }
+            _synchronous = true;
+            uint64_t position = _tail.load(std::memory_order_acquire);
+            while (true) {
+                const Slot& slot = _slots[position & (LOG_SLOTS - 1)];
+                const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence == (position + 1)) {
+                    const char* message = slot.message;
+                    size_t length = slot.length;
+                    while (length > 0) {
+                        const ssize_t written = ::write(STDERR_FILENO, message, length);
+                        if (written > 0) {
+                            message += written;
+                            length -= static_cast<size_t>(written);
+                        } else if ((written < 0) && (errno == EINTR)) {
+                            continue;
+                        } else {
+                            break;
+                        }
+                    }
+                    position++;
+                } else if (sequence > (position + 1)) {
+                    // the writer thread got there first
+                    position++;
+                } else {
+                    // empty, or claimed but not filled yet
+                    break;
+                }
+            }
+        }
+
+        static void WriteDirect(const char* message, size_t length)
+        {
+            fwrite(message, 1, length, stderr);
+            fflush(stderr);
+        }
+
+        bool Push(const char line[], uint32_t length)
+        {
+            uint64_t position = _head.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            while (true) {
+                slot = &_slots[position & (LOG_SLOTS - 1)];
+                const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+                if (difference == 0) {
+                    if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    // full
+                    if (_policy.load(std::memory_order_relaxed) == Overflow::DROP) {
+                        return false;
+                    }
+                    Wake();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    position = _head.load(std::memory_order_relaxed);
+                } else {
+                    position = _head.load(std::memory_order_relaxed);
+                }
+            }
+
+            ::memcpy(slot->message, line, length);
+            slot->length = length;
+            slot->sequence.store(position + 1, std::memory_order_release);
+            Wake();
+            return true;
+        }
+
+        void Wake()
+        {
+            // pairs with the fence in Process(): either the writer sees the slot or we see it sleeping,
+            // only the producer that takes it out of the sleeping state signals
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((_sleeping.load(std::memory_order_relaxed) == true) && (_sleeping.exchange(false, std::memory_order_relaxed) == true)) {
+                std::lock_guard<std::mutex> lock(_adminLock);
+                _signal.notify_one();
+            }
+        }
+
+        bool Pending() const
+        {
+            const uint64_t tail = _tail.load(std::memory_order_relaxed);
+            return (_slots[tail & (LOG_SLOTS - 1)].sequence.load(std::memory_order_acquire) == (tail + 1));
+        }
+
+        void Process()
+        {
+            pthread_setname_np(pthread_self(), "UtilsLogWriter");
+            while (true) {
+                bool wrote = false;
+                while (Pending() == true) {
+                    const uint64_t tail = _tail.load(std::memory_order_relaxed);
+                    Slot& slot = _slots[tail & (LOG_SLOTS - 1)];
+                    fwrite(slot.message, 1, slot.length, stderr);
+                    slot.sequence.store(tail + LOG_SLOTS, std::memory_order_release);
+                    _tail.store(tail + 1, std::memory_order_release);
+                    wrote = true;
+                }
+
+                const uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+                if (dropped != _reportedDropped) {
+                    fprintf(stderr, "[%d] WARN [UtilsLogging.h] AsyncWriter: %llu log messages dropped\n",
+                        ThreadId(), static_cast<unsigned long long>(dropped - _reportedDropped));
+                    _reportedDropped = dropped;
+                    wrote = true;
+                }
+                if (wrote == true) {
+                    fflush(stderr);
+                }
+
+                std::unique_lock<std::mutex> lock(_adminLock);
+                _written = _tail.load(std::memory_order_relaxed);
+                _writtenDropped = _reportedDropped;
+                if (_flushTarget != 0) {
+                    _flushed.notify_all();
+                }
+
+                if (wrote == true) {
+                    // poll while messages keep coming instead of having every producer wake us
+                    lock.unlock();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<uint32_t>(LOG_WRITER_POLL_IN_MS)));
+                    continue;
+                }
+
+                _sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (Pending() == false) {
+                    // a flush may be waiting for a slot that is claimed but not yet filled
+                    _signal.wait_for(lock, ((_flushTarget > _written) || (_dropped.load() != _writtenDropped)) ? std::chrono::milliseconds(1) : std::chrono::milliseconds(1000));
+                }
+                _sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::atomic<uint64_t> _head;
+        char _padding[64 - sizeof(std::atomic<uint64_t>)]; // keep producers off the writer's cache line
+        std::atomic<uint64_t> _tail; // written by the writer thread only
+        uint64_t _written;
+        uint64_t _flushTarget;
+        std::atomic<uint64_t> _dropped;
+        uint64_t _reportedDropped; // writer thread only
+        uint64_t _writtenDropped;
+        std::atomic<Overflow> _policy;
+        std::atomic<bool> _synchronous;
+        std::atomic<bool> _sleeping;
+        std::atomic<bool> _draining;
+        bool _started;
+        std::mutex _adminLock;
+        std::condition_variable _signal;
+        std::condition_variable _flushed;
+        Slot _slots[LOG_SLOTS];
+    };
+
+    inline void Write(const char* format, ...) __attribute__((format(printf, 1, 2)));
+    inline void Write(const char* format, ...)
+    {
+        va_list arguments;
+        va_start(arguments, format);
+        AsyncWriter::Instance().Write(format, arguments);
+        va_end(arguments);
+    }
+
+    // Writes out everything logged so far, for fatal paths.
+    inline void Flush()
+    {
+        AsyncWriter::Instance().Flush();
+    }
+
+} // namespace Logging
+} // namespace Utils
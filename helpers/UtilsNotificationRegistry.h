@@ -0,0 +1,592 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2025 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <plugins/plugins.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "UtilsLogging.h"
+
+#define NOTIFICATION_SLOW_SINK_IN_MS 500
+// consecutive overruns after which a sink is served on the degraded lane
+#define NOTIFICATION_DEGRADE_AFTER 3
+// consecutive in-time deliveries after which a degraded sink is served in parallel again
+#define NOTIFICATION_RECOVER_AFTER 3
+// deliveries queued for one sink beyond this drop the oldest (a client that hangs), counted as missed
+#define NOTIFICATION_MAX_QUEUED 32
+
+namespace Utils {
+
+    /**
+     * Registered notification sinks of one interface.
+     *
+     * Sinks are kept in an immutable snapshot that Register/Unregister replace
+     * (copy-on-write), so Notify() iterates without holding a lock and a sink
+     * may (un)register from its own callback. The registry's reference on a
+     * sink is dropped once no snapshot refers to it any more, so an Unregister
+     * racing with a dispatch never releases a sink that is still being called.
+     *
+     * NotifyParallel() runs the callback for each sink as its own worker pool
+     * job and waits at most deadlineInMs for all of them, so a slow
+     * out-of-process client only delays itself. Deliveries to one sink stay in
+     * order: each sink has a queue that at most one job drains at a time. A
+     * sink that overruns NOTIFICATION_DEGRADE_AFTER times in a row is degraded:
+     * its deliveries go to a single degraded lane (one worker pool job for all
+     * degraded sinks) and are not waited for, until it is in time again
+     * NOTIFICATION_RECOVER_AFTER times in a row. With Core::infinite every
+     * sink, degraded or not, is waited for without a deadline. Every callback
+     * is timed per sink, see Latencies(). An unregistered sink is not called
+     * any more, even for deliveries already queued.
+     */
+    template <typename INTERFACE>
+    class NotificationRegistry {
+    public:
+        using Callback = std::function<void(INTERFACE*)>;
+
+        struct Latency {
+            const INTERFACE* sink;
+            uint64_t calls;
+            uint64_t late; // callbacks that overran the deadline or NOTIFICATION_SLOW_SINK_IN_MS
+            uint64_t missed; // deliveries dropped as more than NOTIFICATION_MAX_QUEUED were queued
+            uint64_t averageUs;
+            uint64_t maxUs;
+            uint64_t lastUs;
+            uint64_t averageDeliveryUs; // NotifyParallel() to callback return, including the queueing
+            uint64_t maxDeliveryUs;
+            uint32_t queued; // deliveries not yet called
+            bool degraded;
+        };
+
+    private:
+        // Shared by the jobs of one NotifyParallel() round, they may outlive the call.
+        struct Round {
+            Round(uint32_t count)
+                : lock()
+                , done()
+                , pending(count)
+                , missed(0)
+            {
+            }
+
+            std::mutex lock;
+            std::condition_variable done;
+            uint32_t pending;
+            uint32_t missed; // completed without calling the sink
+        };
+
+        // One NotifyParallel() call for one sink.
+        struct Delivery {
+            std::shared_ptr<const Callback> call;
+            std::shared_ptr<Round> round; // nullptr if not waited for
+            uint32_t deadlineInMs;
+            const char* event;
+            std::chrono::steady_clock::time_point queuedAt;
+        };
+
+        class Entry {
+        public:
+            Entry() = delete;
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            explicit Entry(INTERFACE* sink)
+                : _sink(sink)
+                , _calls(0)
+                , _late(0)
+                , _missed(0)
+                , _totalUs(0)
+                , _maxUs(0)
+                , _lastUs(0)
+                , _deliveries(0)
+                , _totalDeliveryUs(0)
+                , _maxDeliveryUs(0)
+                , _queueLock()
+                , _queue()
+                , _draining(false)
+                , _streak(0)
+                , _degraded(false)
+                , _revoked(false)
+            {
+                _sink->AddRef();
+            }
+            ~Entry()
+            {
+                _sink->Release();
+            }
+
+            INTERFACE* Sink() const
+            {
+                return (_sink);
+            }
+
+            // Runs the callback and returns how long it took in microseconds.
+            template <typename CALL>
+            uint64_t Call(const CALL& call, uint64_t lateAfterUs)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                call(_sink);
+                const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+                _calls++;
+                _totalUs += elapsed;
+                _lastUs = elapsed;
+                uint64_t max = _maxUs.load();
+                while ((elapsed > max) && (_maxUs.compare_exchange_weak(max, elapsed) == false)) {
+                }
+                if (elapsed > lateAfterUs) {
+                    _late++;
+                }
+                return (elapsed);
+            }
+
+            Latency Report()
+            {
+                const uint64_t calls = _calls.load();
+                const uint64_t deliveries = _deliveries.load();
+                uint32_t queued;
+                {
+                    std::lock_guard<std::mutex> guard(_queueLock);
+                    queued = static_cast<uint32_t>(_queue.size());
+                }
+                return { _sink, calls, _late.load(), _missed.load(), (calls > 0) ? (_totalUs.load() / calls) : 0, _maxUs.load(), _lastUs.load(),
+                    (deliveries > 0) ? (_totalDeliveryUs.load() / deliveries) : 0, _maxDeliveryUs.load(), queued, _degraded.load() };
+            }
+
+            bool Degraded() const
+            {
+                return (_degraded);
+            }
+
+            bool Revoked() const
+            {
+                return (_revoked);
+            }
+
+            // The sink is unregistered: nothing queued or queued later is delivered.
+            void Revoke()
+            {
+                std::lock_guard<std::mutex> guard(_queueLock);
+                _revoked = true;
+                Skip();
+            }
+
+            // Queues a delivery; returns true if the caller has to schedule Drain().
+            bool Enqueue(const Delivery& delivery)
+            {
+                std::lock_guard<std::mutex> guard(_queueLock);
+                if (_revoked) {
+                    Complete(delivery, false);
+                    return (false);
+                }
+                if (_queue.size() >= NOTIFICATION_MAX_QUEUED) {
+                    LOGERR("client %p has %u notifications queued, dropping the oldest", _sink, static_cast<uint32_t>(_queue.size()));
+                    _missed++;
+                    Complete(_queue.front(), false);
+                    _queue.pop_front();
+                }
+                _queue.push_back(delivery);
+                if (_draining) {
+                    return (false);
+                }
+                _draining = true;
+                return (true);
+            }
+
+            // Delivers until the queue is empty; only one thread drains a sink at a time.
+            void Drain()
+            {
+                Delivery delivery;
+                while (Next(delivery)) {
+                    Deliver(delivery);
+                }
+            }
+
+        private:
+            bool Next(Delivery& delivery)
+            {
+                std::lock_guard<std::mutex> guard(_queueLock);
+                if (_revoked || _queue.empty()) {
+                    Skip();
+                    _draining = false;
+                    return (false);
+                }
+                delivery = _queue.front();
+                _queue.pop_front();
+                return (true);
+            }
+
+            void Deliver(const Delivery& delivery)
+            {
+                const bool deadline = ((delivery.deadlineInMs > 0) && (delivery.deadlineInMs != WPEFramework::Core::infinite));
+                const uint64_t lateAfterUs = static_cast<uint64_t>(deadline ? delivery.deadlineInMs : NOTIFICATION_SLOW_SINK_IN_MS) * 1000;
+                const uint64_t elapsed = Call(*delivery.call, lateAfterUs);
+                const uint64_t deliveryUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - delivery.queuedAt).count());
+
+                _deliveries++;
+                _totalDeliveryUs += deliveryUs;
+                uint64_t max = _maxDeliveryUs.load();
+                while ((deliveryUs > max) && (_maxDeliveryUs.compare_exchange_weak(max, deliveryUs) == false)) {
+                }
+
+                if (delivery.event != nullptr) {
+                    LOGINFO("client %p took %" PRIu64 "ms to process %s event", _sink, elapsed / 1000, delivery.event);
+                } else if (elapsed > lateAfterUs) {
+                    LOGWARN("client %p took %" PRIu64 "ms, deadline %" PRIu64 " ms", _sink, elapsed / 1000, lateAfterUs / 1000);
+                }
+
+                // streak of overruns while healthy, or of in-time deliveries while degraded
+                const bool late = (elapsed > lateAfterUs);
+                if (late == _degraded) {
+                    _streak = 0;
+                } else if (++_streak >= (late ? NOTIFICATION_DEGRADE_AFTER : NOTIFICATION_RECOVER_AFTER)) {
+                    _streak = 0;
+                    _degraded = late;
+                    LOGWARN("client %p %s", _sink, late ? "is degraded, served on the degraded lane" : "recovered");
+                }
+
+                Complete(delivery, true);
+            }
+
+            // Completes the queued deliveries without calling the sink; _queueLock is held.
+            void Skip()
+            {
+                for (const Delivery& delivery : _queue) {
+                    Complete(delivery, false);
+                }
+                _queue.clear();
+            }
+
+            static void Complete(const Delivery& delivery, bool delivered)
+            {
+                if (delivery.round) {
+                    std::lock_guard<std::mutex> guard(delivery.round->lock);
+                    if (delivered == false) {
+                        delivery.round->missed++;
+                    }
+                    if (--delivery.round->pending == 0) {
+                        delivery.round->done.notify_all();
+                    }
+                }
+            }
+
+        private:
+            INTERFACE* const _sink;
+            std::atomic<uint64_t> _calls;
+            std::atomic<uint64_t> _late;
+            std::atomic<uint64_t> _missed;
+            std::atomic<uint64_t> _totalUs;
+            std::atomic<uint64_t> _maxUs;
+            std::atomic<uint64_t> _lastUs;
+            std::atomic<uint64_t> _deliveries;
+            std::atomic<uint64_t> _totalDeliveryUs;
+            std::atomic<uint64_t> _maxDeliveryUs;
+            std::mutex _queueLock;
+            std::deque<Delivery> _queue;
+            bool _draining; // a job owns the queue
+            uint32_t _streak;
+            std::atomic<bool> _degraded;
+            bool _revoked; // guarded by _queueLock
+        };
+
+        using Entries = std::vector<std::shared_ptr<Entry>>;
+
+        // Sinks on the degraded lane that have deliveries queued, drained one after the other.
+        struct Lane {
+            Lane()
+                : lock()
+                , entries()
+                , draining(false)
+            {
+            }
+
+            std::mutex lock;
+            std::deque<std::shared_ptr<Entry>> entries;
+            bool draining;
+        };
+
+        // Drains the queue of one sink.
+        class Job : public WPEFramework::Core::IDispatch {
+        protected:
+            Job(const std::shared_ptr<Entry>& entry)
+                : _entry(entry)
+            {
+            }
+
+        public:
+            Job() = delete;
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+            ~Job() = default;
+
+            static WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> Create(const std::shared_ptr<Entry>& entry)
+            {
+                return (WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch>(WPEFramework::Core::ProxyType<Job>::Create(entry)));
+            }
+
+            void Dispatch() override
+            {
+                _entry->Drain();
+            }
+
+        private:
+            const std::shared_ptr<Entry> _entry;
+        };
+
+        // Drains the queues of the sinks on the degraded lane.
+        class LaneJob : public WPEFramework::Core::IDispatch {
+        protected:
+            LaneJob(const std::shared_ptr<Lane>& lane)
+                : _lane(lane)
+            {
+            }
+
+        public:
+            LaneJob() = delete;
+            LaneJob(const LaneJob&) = delete;
+            LaneJob& operator=(const LaneJob&) = delete;
+            ~LaneJob() = default;
+
+            static WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> Create(const std::shared_ptr<Lane>& lane)
+            {
+                return (WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch>(WPEFramework::Core::ProxyType<LaneJob>::Create(lane)));
+            }
+
+            void Dispatch() override
+            {
+                std::shared_ptr<Entry> entry;
+                while (true) {
+                    {
+                        std::lock_guard<std::mutex> guard(_lane->lock);
+                        if (_lane->entries.empty()) {
+                            _lane->draining = false;
+                            return;
+                        }
+                        entry = _lane->entries.front();
+                        _lane->entries.pop_front();
+                    }
+                    entry->Drain();
+                }
+            }
+
+        private:
+            const std::shared_ptr<Lane> _lane;
+        };
+
+    public:
+        NotificationRegistry(const NotificationRegistry&) = delete;
+        NotificationRegistry& operator=(const NotificationRegistry&) = delete;
+
+        NotificationRegistry()
+            : _writeLock()
+            , _entries(std::shared_ptr<const Entries>(std::make_shared<Entries>()))
+            , _lane(std::make_shared<Lane>())
+        {
+        }
+        ~NotificationRegistry()
+        {
+            Clear();
+        }
+
+        // Returns false if the sink is registered already.
+        bool Register(INTERFACE* sink)
+        {
+            ASSERT(nullptr != sink);
+            std::lock_guard<std::mutex> guard(_writeLock);
+
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            if (Find(*current, sink) != current->end()) {
+                return (false);
+            }
+
+            std::shared_ptr<Entries> next(std::make_shared<Entries>(*current));
+            next->push_back(std::make_shared<Entry>(sink));
+            std::atomic_store(&_entries, std::shared_ptr<const Entries>(next));
+            return (true);
+        }
+
+        // Returns false if the sink is not registered.
+        bool Unregister(const INTERFACE* sink)
+        {
+            ASSERT(nullptr != sink);
+            std::lock_guard<std::mutex> guard(_writeLock);
+
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            typename Entries::const_iterator index(Find(*current, sink));
+            if (index == current->end()) {
+                return (false);
+            }
+
+            (*index)->Revoke();
+            std::shared_ptr<Entries> next(std::make_shared<Entries>(*current));
+            next->erase(next->begin() + (index - current->begin()));
+            std::atomic_store(&_entries, std::shared_ptr<const Entries>(next));
+            return (true);
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> guard(_writeLock);
+            for (const std::shared_ptr<Entry>& entry : *std::atomic_load(&_entries)) {
+                entry->Revoke();
+            }
+            std::atomic_store(&_entries, std::shared_ptr<const Entries>(std::make_shared<Entries>()));
+        }
+
+        uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(std::atomic_load(&_entries)->size()));
+        }
+
+        bool Contains(const INTERFACE* sink) const
+        {
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            return (Find(*current, sink) != current->end());
+        }
+
+        // Calls every sink in registration order on the calling thread.
+        template <typename CALL>
+        void Notify(const CALL& call) const
+        {
+            Notify(call, nullptr);
+        }
+
+        // As Notify(), logging the time each sink took to process `event`.
+        template <typename CALL>
+        void Notify(const CALL& call, const char* event) const
+        {
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            const uint64_t lateAfterUs = static_cast<uint64_t>(NOTIFICATION_SLOW_SINK_IN_MS) * 1000;
+
+            for (const std::shared_ptr<Entry>& entry : *current) {
+                if (entry->Revoked()) {
+                    // unregistered by an earlier sink's callback
+                    continue;
+                }
+                const uint64_t elapsed = entry->Call(call, lateAfterUs);
+                if (event != nullptr) {
+                    LOGINFO("client %p took %" PRIu64 "ms to process %s event", entry->Sink(), elapsed / 1000, event);
+                } else if (elapsed > lateAfterUs) {
+                    LOGWARN("client %p took %" PRIu64 "ms to process a notification", entry->Sink(), elapsed / 1000);
+                }
+            }
+        }
+
+        /**
+         * Calls every sink from its own worker pool job and waits up to
+         * deadlineInMs for all of them except the degraded ones; 0 does not
+         * wait, Core::infinite waits for every sink including the degraded
+         * ones. Returns the number of sinks waited for that were called in
+         * time; deliveries dropped on overflow or to a sink unregistered in the
+         * meantime do not count. Jobs still running at the deadline complete in
+         * the background. When
+         * called from a worker pool thread, the jobs compete with the caller
+         * for the pool's threads. If event is set, each sink's time is logged.
+         */
+        uint32_t NotifyParallel(const Callback& call, uint32_t deadlineInMs, const char* event = nullptr) const
+        {
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            if (current->empty()) {
+                return (0);
+            }
+
+            // read once, a sink may change lanes while the round is set up
+            const bool all = (deadlineInMs == WPEFramework::Core::infinite);
+            std::vector<bool> degraded;
+            degraded.reserve(current->size());
+            uint32_t count = 0;
+            for (const std::shared_ptr<Entry>& entry : *current) {
+                degraded.push_back(entry->Degraded());
+                count += ((all || (degraded.back() == false)) ? 1 : 0);
+            }
+
+            const std::shared_ptr<const Callback> shared(std::make_shared<Callback>(call));
+            const std::shared_ptr<Round> round(std::make_shared<Round>(count));
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            for (size_t index = 0; index < current->size(); index++) {
+                const std::shared_ptr<Entry>& entry = (*current)[index];
+                const bool waited = (all || (degraded[index] == false));
+                if (entry->Enqueue({ shared, (waited ? round : nullptr), deadlineInMs, event, now }) == false) {
+                    // already being drained, delivered in order after the earlier notifications
+                    continue;
+                }
+                if (degraded[index] == false) {
+                    WPEFramework::Core::IWorkerPool::Instance().Submit(Job::Create(entry));
+                    continue;
+                }
+                std::lock_guard<std::mutex> guard(_lane->lock);
+                _lane->entries.push_back(entry);
+                if (_lane->draining == false) {
+                    _lane->draining = true;
+                    WPEFramework::Core::IWorkerPool::Instance().Submit(LaneJob::Create(_lane));
+                }
+            }
+            if ((deadlineInMs == 0) || (count == 0)) {
+                return (0);
+            }
+
+            std::unique_lock<std::mutex> lock(round->lock);
+            if (all) {
+                round->done.wait(lock, [&round]() { return (round->pending == 0); });
+            } else {
+                round->done.wait_for(lock, std::chrono::milliseconds(deadlineInMs), [&round]() { return (round->pending == 0); });
+            }
+            if (round->pending != 0) {
+                LOGWARN("%u of %u clients missed the %u ms deadline", round->pending, count, deadlineInMs);
+            }
+            if (round->missed != 0) {
+                LOGWARN("%u of %u clients were not called", round->missed, count);
+            }
+            return (count - round->pending - round->missed);
+        }
+
+        std::vector<Latency> Latencies() const
+        {
+            const std::shared_ptr<const Entries> current(std::atomic_load(&_entries));
+            std::vector<Latency> result;
+            result.reserve(current->size());
+            for (const std::shared_ptr<Entry>& entry : *current) {
+                result.push_back(entry->Report());
+            }
+            return (result);
+        }
+
+    private:
+        static typename Entries::const_iterator Find(const Entries& entries, const INTERFACE* sink)
+        {
+            return (std::find_if(entries.begin(), entries.end(), [sink](const std::shared_ptr<Entry>& entry) { return (entry->Sink() == sink); }));
+        }
+
+    private:
+        std::mutex _writeLock;
+        std::shared_ptr<const Entries> _entries;
+        const std::shared_ptr<Lane> _lane; // shared with its job, which may outlive the registry
+    };
+
+} // namespace Utils
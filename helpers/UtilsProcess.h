@@ -20,73 +20,314 @@
 #pragma once
 
 #include <iostream>
+#include <cerrno>
 #include <cstring>
 #include <string>
 #include <cstdlib>
-#include <proc/readproc.h>
+#include <functional>
 #include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <UtilsLogging.h>
 
+// pidfd_open(2) and pidfd_send_signal(2) use the same number on all architectures with the
+// unified syscall table, but older kernel headers do not define them
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
 using namespace std;
 
 namespace Utils
 {
+/*
+* The lookups below read only the /proc files they need (no openproc()/readproc() walk that
+* fills memory, stat and status for every process), and signal through a pidfd where the
+* kernel supports it, so a pid that exits and is reused between lookup and kill is not hit.
+* killProcess() and getChildProcessIDs() at the end are kept for existing callers.
+*/
+
 /**
-* @brief Kill all the processes with the given process name
-* @param[in] input_pname - The given process name
-* @return true if any process with the given name was killed, otherwise false is returned
+* @brief Read a file under /proc into content
+* @return true if anything was read
+*/
+inline bool readProcFile(const string& path, string& content)
+{
+    content.clear();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    char buffer[512];
+    ssize_t length;
+    while (((length = read(fd, buffer, sizeof(buffer))) > 0) || ((length < 0) && (errno == EINTR)))
+    {
+        if (length > 0)
+        {
+            content.append(buffer, length);
+        }
+    }
+    close(fd);
+    return !content.empty();
+}
+
+/**
+* @brief Get the name of a process (/proc/<pid>/comm, the same name readproc() reports in cmd)
+* @return false if there is no such process
+*/
+inline bool getProcessName(int pid, string& name)
+{
+    if (!readProcFile("/proc/" + std::to_string(pid) + "/comm", name))
+    {
+        return false;
+    }
+    if (!name.empty() && (name.back() == '\n'))
+    {
+        name.pop_back();
+    }
+    return true;
+}
+
+/**
+* @brief Get the parent process ID of a process (/proc/<pid>/stat)
+* @return false if there is no such process
+*/
+inline bool getParentProcessID(int pid, int& ppid)
+{
+    string stat;
+    if (!readProcFile("/proc/" + std::to_string(pid) + "/stat", stat))
+    {
+        return false;
+    }
+    // "pid (comm) state ppid ...", comm may contain spaces and parentheses
+    const size_t end = stat.rfind(')');
+    char state;
+    return ((end != string::npos) && (sscanf(stat.c_str() + end + 1, " %c %d", &state, &ppid) == 2));
+}
+
+/**
+* @brief Open a pidfd for a process
+* @return the pidfd, or -1 with errno set (ESRCH if there is no such process, ENOSYS if the kernel
+*         has no pidfd support, EPERM if a seccomp filter refuses the call)
 */
-bool killProcess(string& input_pname)
+inline int openProcessFd(int pid)
 {
-    PROCTAB* proc = openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS);
-    proc_t proc_info = {0};
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+}
+
+/**
+* @brief Send a signal to a process, through a pidfd where the kernel supports it
+* @param[in] pid - The process ID
+* @param[in] signal - The signal to send
+* @param[in] isExpected - If set, checked after the pidfd is opened; the signal is only sent if it returns true.
+*                         A pidfd keeps referring to the process it was opened for, so this closes the
+*                         window in which the pid could be reused by another process.
+* @return true if the signal was sent
+*/
+inline bool signalProcess(int pid, int signal, const std::function<bool(int)>& isExpected = nullptr)
+{
+    const int pidfd = openProcessFd(pid);
+    if (pidfd < 0)
+    {
+        if (errno == ESRCH)
+        {
+            // the process is gone
+            return false;
+        }
+        // no usable pidfd support (ENOSYS, EPERM from a seccomp filter, out of descriptors, ...)
+        return ((!isExpected || isExpected(pid)) && (0 == kill(pid, signal)));
+    }
+
+    bool result = false;
+    if (!isExpected || isExpected(pid))
+    {
+        result = (0 == syscall(SYS_pidfd_send_signal, pidfd, signal, nullptr, 0));
+    }
+    close(pidfd);
+    return result;
+}
+
+/**
+* @brief Get the list of processes with the given name, reading only /proc/<pid>/comm
+* @param[in] input_pname - The given process name (as in /proc/<pid>/comm, i.e. at most 15 characters)
+* @param[out] processIds - The list of process IDs
+* @return true if there are any processes with the given name, otherwise false is returned
+*/
+inline bool findProcessIDsByName(const string& input_pname, vector<int>& processIds)
+{
+    DIR* proc = opendir("/proc");
     bool ret_value = false;
 
     if (proc != NULL)
     {
-        memset(&proc_info, 0, sizeof(proc_info));
-        while (readproc(proc, &proc_info) != NULL)
+        struct dirent* entry;
+        string name;
+        while ((entry = readdir(proc)) != NULL)
         {
-            if (proc_info.cmd == input_pname)
+            char* end;
+            const long pid = strtol(entry->d_name, &end, 10);
+            if ((*end != '\0') || (pid <= 0))
             {
-                if (0 == kill(proc_info.tid, SIGTERM))
-                {
-                    ret_value = true;
-                    LOGINFO("Killed the process [%d] process name [%s]", proc_info.tid, proc_info.cmd);
-                }
+                continue;
+            }
+            if (getProcessName(static_cast<int>(pid), name) && (name == input_pname))
+            {
+                processIds.push_back(static_cast<int>(pid));
+                ret_value = true;
             }
         }
-        closeproc(proc);
+        closedir(proc);
     }
     return ret_value;
 }
 
 /**
-* @brief Get list of child processes with the given parent process ID, equivalent to "pgrep  -P <PPID>"
+* @brief Get the list of child processes with the given parent process ID from /proc/<ppid>/task/<tid>/children.
+*        Falls back to the ppid in /proc/<pid>/stat of every process if the kernel has no children files.
 * @param[in] input_ppid - The given parent process ID
 * @param[out] processIds - The list of child process IDs
 * @return true if there are any child processes of the given parent process ID, otherwise false is returned
 */
-bool getChildProcessIDs(int input_ppid, vector<int>& processIds)
+inline bool findChildProcessIDs(int input_ppid, vector<int>& processIds)
 {
-    PROCTAB* proc = openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS);
-    proc_t proc_info = {0};
-    bool ret_value = false;
+    const string taskPath = "/proc/" + std::to_string(input_ppid) + "/task";
+    DIR* tasks = opendir(taskPath.c_str());
+    const size_t count = processIds.size();
 
-    if (proc != NULL)
+    if (tasks == NULL)
     {
-        memset(&proc_info, 0, sizeof(proc_info));
-        while (readproc(proc, &proc_info) != NULL)
+        return false;
+    }
+
+    struct dirent* entry;
+    string children;
+    bool supported = false;
+    while ((entry = readdir(tasks)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        const string path = taskPath + "/" + entry->d_name + "/children";
+        if (access(path.c_str(), F_OK) != 0)
+        {
+            continue;
+        }
+        supported = true;
+        readProcFile(path, children);
+        const char* cursor = children.c_str();
+        char* end;
+        long pid;
+        while (((pid = strtol(cursor, &end, 10)) > 0) && (end != cursor))
         {
-            if (proc_info.ppid == input_ppid)
+            processIds.push_back(static_cast<int>(pid));
+            cursor = end;
+        }
+    }
+    closedir(tasks);
+
+    if (!supported)
+    {
+        DIR* proc = opendir("/proc");
+        if (proc != NULL)
+        {
+            int ppid;
+            while ((entry = readdir(proc)) != NULL)
             {
-                processIds.push_back(proc_info.tid);
-                ret_value = true;
+                char* end;
+                const long pid = strtol(entry->d_name, &end, 10);
+                if ((*end == '\0') && (pid > 0) && getParentProcessID(static_cast<int>(pid), ppid) && (ppid == input_ppid))
+                {
+                    processIds.push_back(static_cast<int>(pid));
+                }
             }
+            closedir(proc);
+        }
+    }
+    return (processIds.size() > count);
+}
+
+/**
+* @brief Kill all the processes with the given process name, like killProcess() without walking all of readproc()
+* @param[in] input_pname - The given process name
+* @param[in] signal - The signal to send
+* @return true if any process with the given name was signalled, otherwise false is returned
+*/
+inline bool killProcessByName(const string& input_pname, int signal = SIGTERM)
+{
+    vector<int> processIds;
+    bool ret_value = false;
+
+    findProcessIDsByName(input_pname, processIds);
+    for (const int pid : processIds)
+    {
+        const bool killed = signalProcess(pid, signal, [&input_pname](int candidate) {
+            string name;
+            return (getProcessName(candidate, name) && (name == input_pname));
+        });
+        if (killed)
+        {
+            ret_value = true;
+            LOGINFO("Killed the process [%d] process name [%s]", pid, input_pname.c_str());
         }
-        closeproc(proc);
     }
     return ret_value;
 }
 
+/**
+* @brief Send a signal to all the child processes of the given parent process ID
+* @param[in] input_ppid - The given parent process ID
+* @param[in] signal - The signal to send
+* @return true if any child process was signalled, otherwise false is returned
+*/
+inline bool killChildProcesses(int input_ppid, int signal = SIGKILL)
+{
+    vector<int> processIds;
+    bool ret_value = false;
+
+    findChildProcessIDs(input_ppid, processIds);
+    for (const int pid : processIds)
+    {
+        if ((pid <= 1) || (pid == input_ppid))
+        {
+            LOGERR("Bad pid: %d", pid);
+            continue;
+        }
+        const bool killed = signalProcess(pid, signal, [input_ppid](int candidate) {
+            int ppid;
+            return (getParentProcessID(candidate, ppid) && (ppid == input_ppid));
+        });
+        ret_value = ret_value || killed;
+    }
+    return ret_value;
+}
+
+/**
+* @brief Kill all the processes with the given process name
+* @param[in] input_pname - The given process name
+* @return true if any process with the given name was killed, otherwise false is returned
+*/
+inline bool killProcess(string& input_pname)
+{
+    return killProcessByName(input_pname, SIGTERM);
+}
+
+/**
+* @brief Get list of child processes with the given parent process ID, equivalent to "pgrep  -P <PPID>"
+* @param[in] input_ppid - The given parent process ID
+* @param[out] processIds - The list of child process IDs
+* @return true if there are any child processes of the given parent process ID, otherwise false is returned
+*/
+inline bool getChildProcessIDs(int input_ppid, vector<int>& processIds)
+{
+    return findChildProcessIDs(input_ppid, processIds);
+}
+
 }
@@ -0,0 +1,383 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2025 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <plugins/plugins.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "UtilsLogging.h"
+
+extern char** environ;
+
+// time a timed out process group gets between SIGTERM and SIGKILL
+#define SPAWN_KILL_GRACE_IN_MS 1000
+// captured output beyond this is read and dropped
+#define SPAWN_MAX_OUTPUT_SIZE (64 * 1024)
+
+namespace Utils {
+
+/**
+ * Runs programs with posix_spawn instead of system()/popen()/fork().
+ *
+ * posix_spawn starts the child with vfork semantics, so its cost does not
+ * grow with the size of the (large) host process, and the arguments are
+ * passed as an argv vector to the program itself, without "sh -c". Use
+ * {"sh", "script.sh", ...} to run a script that is not executable.
+ *
+ * The child gets /dev/null as stdin, an empty signal mask and default
+ * signal handlers.
+ *
+ * Tests replace Run() and Detach() with setImpl().
+ */
+namespace Spawn {
+
+    struct Options {
+        Options()
+            : timeoutInMs(0)
+            , captureOutput(true)
+            , captureErrors(false)
+            , maxOutputSize(SPAWN_MAX_OUTPUT_SIZE)
+            , outputFile()
+        {
+        }
+
+        uint32_t timeoutInMs; // 0 waits for the exit; else the process group is killed at the timeout
+        bool captureOutput; // stdout into Result::output, otherwise inherited
+        bool captureErrors; // stderr into Result::output (or outputFile) as well
+        size_t maxOutputSize;
+        std::string outputFile; // if set, stdout is appended to this file instead of captured ("cmd >> file")
+    };
+
+    struct Result {
+        Result()
+            : started(false)
+            , error(0)
+            , exitCode(-1)
+            , signal(0)
+            , timedOut(false)
+            , output()
+        {
+        }
+
+        bool Succeeded() const
+        {
+            return (started && !timedOut && (exitCode == 0));
+        }
+
+        bool started;
+        int error; // errno when not started
+        int exitCode; // -1 unless exited normally
+        int signal; // that terminated the process, 0 if none
+        bool timedOut;
+        std::string output;
+    };
+
+    using Callback = std::function<void(const Result&)>;
+
+    struct IImplementation {
+        virtual ~IImplementation() = default;
+        // called instead of Run(), and by Detach() which only looks at Result::started
+        virtual Result Run(const std::vector<std::string>& argv, const Options& options) = 0;
+    };
+
+    inline IImplementation*& Implementation()
+    {
+        static IImplementation* implementation = nullptr;
+        return implementation;
+    }
+
+    inline void setImpl(IImplementation* implementation)
+    {
+        Implementation() = implementation;
+    }
+
+    // Starts argv; outputFd (if >= 0) or outputFile (appended) becomes stdout and optionally stderr. Returns 0 or an errno.
+    inline int Launch(const std::vector<std::string>& argv, int outputFd, bool errorsToOutput, bool newProcessGroup, pid_t& pid,
+        const std::string& outputFile = std::string())
+    {
+        if (argv.empty() || argv[0].empty()) {
+            return EINVAL;
+        }
+
+        std::vector<char*> arguments;
+        arguments.reserve(argv.size() + 1);
+        for (const std::string& argument : argv) {
+            arguments.push_back(const_cast<char*>(argument.c_str()));
+        }
+        arguments.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        if (outputFd >= 0) {
+            posix_spawn_file_actions_adddup2(&actions, outputFd, STDOUT_FILENO);
+            if (errorsToOutput) {
+                posix_spawn_file_actions_adddup2(&actions, outputFd, STDERR_FILENO);
+            }
+        } else if (!outputFile.empty()) {
+            posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, outputFile.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+            if (errorsToOutput) {
+                posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+            }
+        }
+
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init(&attributes);
+        sigset_t signals;
+        sigemptyset(&signals);
+        posix_spawnattr_setsigmask(&attributes, &signals);
+        // e.g. an ignored SIGPIPE would otherwise be inherited
+        sigfillset(&signals);
+        sigdelset(&signals, SIGKILL);
+        sigdelset(&signals, SIGSTOP);
+        posix_spawnattr_setsigdefault(&attributes, &signals);
+        short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+        if (newProcessGroup) {
+            flags |= POSIX_SPAWN_SETPGROUP;
+            posix_spawnattr_setpgroup(&attributes, 0);
+        }
+        posix_spawnattr_setflags(&attributes, flags);
+
+        const int error = posix_spawnp(&pid, arguments[0], &actions, &attributes, arguments.data(), environ);
+
+        posix_spawnattr_destroy(&attributes);
+        posix_spawn_file_actions_destroy(&actions);
+        return error;
+    }
+
+    /**
+     * @brief Start argv without waiting for it; the caller must reap the process (waitpid).
+     * @return pid of the process, -1 if it could not be started.
+     */
+    inline pid_t Start(const std::vector<std::string>& argv)
+    {
+        pid_t pid = -1;
+        const int error = Launch(argv, -1, false, false, pid);
+        if (error != 0) {
+            LOGERR("Failed to start %s: %s", argv.empty() ? "" : argv[0].c_str(), strerror(error));
+            return -1;
+        }
+        return pid;
+    }
+
+    /**
+     * @brief Run argv to completion (or its timeout) on the calling thread.
+     */
+    inline Result Run(const std::vector<std::string>& argv, const Options& options = Options())
+    {
+        if (Implementation() != nullptr) {
+            return Implementation()->Run(argv, options);
+        }
+
+        typedef std::chrono::steady_clock Clock;
+        Result result;
+
+        int pipes[2] = { -1, -1 };
+        if (options.captureOutput && options.outputFile.empty() && (pipe2(pipes, O_CLOEXEC) != 0)) {
+            result.error = errno;
+            LOGERR("Failed to create a pipe for %s: %s", argv.empty() ? "" : argv[0].c_str(), strerror(result.error));
+            return result;
+        }
+
+        pid_t pid = -1;
+        result.error = Launch(argv, pipes[1], options.captureErrors, (options.timeoutInMs > 0), pid, options.outputFile);
+        if (pipes[1] >= 0) {
+            close(pipes[1]);
+        }
+        if (result.error != 0) {
+            LOGERR("Failed to start %s: %s", argv.empty() ? "" : argv[0].c_str(), strerror(result.error));
+            if (pipes[0] >= 0) {
+                close(pipes[0]);
+            }
+            return result;
+        }
+        result.started = true;
+
+        const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(options.timeoutInMs);
+        int output = pipes[0];
+        int status = 0;
+        bool exited = false;
+        char buffer[1024];
+
+        while (!exited) {
+            if ((output < 0) && (options.timeoutInMs == 0)) {
+                exited = (waitpid(pid, &status, 0) == pid) || (errno != EINTR);
+                continue;
+            }
+            const pid_t waited = waitpid(pid, &status, WNOHANG);
+            if ((waited == pid) || ((waited < 0) && (errno != EINTR))) {
+                exited = true;
+                continue;
+            }
+
+            // a background grandchild may keep the pipe open, so check the child at least every 100ms
+            int sliceInMs = (output >= 0) ? 100 : 10;
+            if (options.timeoutInMs > 0) {
+                const int64_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                if (remaining <= 0) {
+                    result.timedOut = true;
+                    break;
+                }
+                if (remaining < sliceInMs) {
+                    sliceInMs = static_cast<int>(remaining);
+                }
+            }
+
+            if (output < 0) {
+                usleep(sliceInMs * 1000);
+                continue;
+            }
+            struct pollfd readable = { output, POLLIN, 0 };
+            if (poll(&readable, 1, sliceInMs) > 0) {
+                const ssize_t length = read(output, buffer, sizeof(buffer));
+                if (length > 0) {
+                    if (result.output.size() < options.maxOutputSize) {
+                        result.output.append(buffer, std::min(static_cast<size_t>(length), options.maxOutputSize - result.output.size()));
+                    }
+                } else if ((length == 0) || (errno != EINTR)) {
+                    close(output);
+                    output = -1;
+                }
+            }
+        }
+
+        if (result.timedOut) {
+            LOGWARN("%s timed out after %u ms, killing it", argv[0].c_str(), options.timeoutInMs);
+            kill(-pid, SIGTERM);
+            const Clock::time_point grace = Clock::now() + std::chrono::milliseconds(SPAWN_KILL_GRACE_IN_MS);
+            bool reaped = false;
+            while (!reaped && (Clock::now() < grace)) {
+                reaped = (waitpid(pid, &status, WNOHANG) == pid);
+                if (!reaped) {
+                    usleep(10 * 1000);
+                }
+            }
+            if (!reaped) {
+                kill(-pid, SIGKILL);
+                while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR)) {
+                }
+            }
+        }
+
+        if (output >= 0) {
+            // what the child wrote before exiting
+            fcntl(output, F_SETFL, O_NONBLOCK);
+            ssize_t length;
+            while ((length = read(output, buffer, sizeof(buffer))) > 0) {
+                if (result.output.size() < options.maxOutputSize) {
+                    result.output.append(buffer, std::min(static_cast<size_t>(length), options.maxOutputSize - result.output.size()));
+                }
+            }
+            close(output);
+        }
+
+        if (WIFEXITED(status)) {
+            result.exitCode = WEXITSTATUS(status);
+        } else if (WIFSIGNALED(status)) {
+            result.signal = WTERMSIG(status);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Start argv and return without waiting for it ("cmd &"); a detached thread reaps it.
+     *        Only Options::outputFile and Options::captureErrors apply, stdout is inherited otherwise.
+     * @return true if the process was started.
+     */
+    inline bool Detach(const std::vector<std::string>& argv, const Options& options = Options())
+    {
+        if (Implementation() != nullptr) {
+            return Implementation()->Run(argv, options).started;
+        }
+
+        pid_t pid = -1;
+        const int error = Launch(argv, -1, options.captureErrors, false, pid, options.outputFile);
+        if (error != 0) {
+            LOGERR("Failed to start %s: %s", argv.empty() ? "" : argv[0].c_str(), strerror(error));
+            return false;
+        }
+        std::thread([pid]() {
+            int status = 0;
+            while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR)) {
+            }
+        }).detach();
+        return true;
+    }
+
+    class Job : public WPEFramework::Core::IDispatch {
+    protected:
+        Job(const std::vector<std::string>& argv, const Callback& callback, const Options& options)
+            : _argv(argv)
+            , _callback(callback)
+            , _options(options)
+        {
+        }
+
+    public:
+        Job() = delete;
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+        ~Job() = default;
+
+        static WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> Create(const std::vector<std::string>& argv, const Callback& callback, const Options& options)
+        {
+            return (WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch>(WPEFramework::Core::ProxyType<Job>::Create(argv, callback, options)));
+        }
+
+        void Dispatch() override
+        {
+            const Result result = Run(_argv, _options);
+            if (_callback) {
+                _callback(result);
+            }
+        }
+
+    private:
+        const std::vector<std::string> _argv;
+        const Callback _callback;
+        const Options _options;
+    };
+
+    /**
+     * @brief Run argv on a worker pool thread and call callback (on that thread) with the result.
+     *        The pool thread is busy until the process exits, so give long running programs a timeout.
+     */
+    inline void RunAsync(const std::vector<std::string>& argv, const Callback& callback, const Options& options = Options())
+    {
+        WPEFramework::Core::IWorkerPool::Instance().Submit(Job::Create(argv, callback, options));
+    }
+
+} // namespace Spawn
+} // namespace Utils
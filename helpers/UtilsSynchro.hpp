@@ -21,7 +21,12 @@
 
 #include <mutex>
 #include <plugins/plugins.h>
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <vector>
+#include <pthread.h>
 #include "UtilsLogging.h"
 
 using namespace WPEFramework;
@@ -29,35 +34,270 @@ using namespace WPEFramework;
 namespace Utils {
     namespace Synchro {
 
+        enum class ApiLockMode : uint8_t {
+            NONE,
+            SHARED, // readers: run concurrently with other readers
+            EXCLUSIVE // writers: run alone (default)
+        };
+
         namespace {
             // set when inside of getFunctionToCall wrapper (or locked IARM handler - see UtilsSynchroIarm.hpp)
             thread_local bool isThreadUsingLockedApi = false;
+            // how the wrapper of the current thread holds the api lock, for UnlockApiGuard
+            thread_local ApiLockMode threadLockedApiMode = ApiLockMode::NONE;
         }
 
+        /*
+            Recursive reader/writer lock. A thread may nest any combination of lock() and
+            lock_shared(); nested calls only count. lock() from a thread holding it shared
+            upgrades by releasing and re-acquiring, so another writer can run in between.
+            Writers are preferred, a stream of readers cannot starve them.
+        */
+        template<class C>
+        class ApiMutex {
+        public:
+            ApiMutex(const ApiMutex&) = delete;
+            ApiMutex& operator=(const ApiMutex&) = delete;
+
+            ApiMutex() {
+                pthread_rwlockattr_t attributes;
+                pthread_rwlockattr_init(&attributes);
+                pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+                pthread_rwlock_init(&_lock, &attributes);
+                pthread_rwlockattr_destroy(&attributes);
+            }
+            ~ApiMutex() {
+                pthread_rwlock_destroy(&_lock);
+            }
+
+            void lock() {
+                if (_exclusiveDepth > 0) {
+                    _exclusiveDepth++;
+                    return;
+                }
+                if (_sharedDepth > 0) {
+                    LOGWARN("upgrading shared api lock %p to exclusive", this);
+                    pthread_rwlock_unlock(&_lock);
+                }
+                pthread_rwlock_wrlock(&_lock);
+                _exclusiveDepth = 1;
+            }
+            void unlock() {
+                if (--_exclusiveDepth == 0) {
+                    pthread_rwlock_unlock(&_lock);
+                    if (_sharedDepth > 0) {
+                        pthread_rwlock_rdlock(&_lock);
+                    }
+                }
+            }
+            void lock_shared() {
+                if ((_exclusiveDepth == 0) && (_sharedDepth == 0)) {
+                    pthread_rwlock_rdlock(&_lock);
+                }
+                _sharedDepth++;
+            }
+            void unlock_shared() {
+                if ((--_sharedDepth == 0) && (_exclusiveDepth == 0)) {
+                    pthread_rwlock_unlock(&_lock);
+                }
+            }
+
+        private:
+            pthread_rwlock_t _lock;
+            static thread_local uint32_t _exclusiveDepth;
+            static thread_local uint32_t _sharedDepth;
+        };
+
+        template <class C> thread_local uint32_t ApiMutex<C>::_exclusiveDepth = 0;
+        template <class C> thread_local uint32_t ApiMutex<C>::_sharedDepth = 0;
+
         // keeps API locks, one per specific class
         template<class C>
         struct ApiLocks {
-            static std::recursive_mutex mtx;
+            static ApiMutex<C> mtx;
         };
 
-        template <class C> std::recursive_mutex ApiLocks<C>::mtx;
+        template <class C> ApiMutex<C> ApiLocks<C>::mtx;
+
+        /*
+            Latency histogram with fixed power-of-two buckets: bucket 0 counts 0us, bucket i
+            counts [2^(i-1), 2^i) us, the last bucket everything above. Percentiles are reported
+            as the upper bound of their bucket (capped at the maximum seen), so they are exact
+            to within a factor of two. Recording is lock free.
+        */
+        class LatencyHistogram {
+        public:
+            static constexpr uint32_t BUCKETS = 32;
+
+            struct Summary {
+                uint64_t count;
+                uint64_t p50Us;
+                uint64_t p99Us;
+                uint64_t maxUs;
+            };
+
+            LatencyHistogram(const LatencyHistogram&) = delete;
+            LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+            LatencyHistogram() {
+                Reset();
+            }
+
+            void Record(uint64_t us) {
+                uint32_t bucket = 0;
+                while ((bucket < (BUCKETS - 1)) && ((us >> bucket) != 0)) {
+                    bucket++;
+                }
+                _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+                uint64_t max = _maxUs.load(std::memory_order_relaxed);
+                while ((us > max) && (_maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed) == false)) {
+                }
+            }
+
+            Summary Report() const {
+                uint64_t counts[BUCKETS];
+                uint64_t count = 0;
+                for (uint32_t index = 0; index < BUCKETS; index++) {
+                    counts[index] = _buckets[index].load(std::memory_order_relaxed);
+                    count += counts[index];
+                }
+                const uint64_t max = _maxUs.load(std::memory_order_relaxed);
+                return { count, Percentile(counts, count, 50, max), Percentile(counts, count, 99, max), max };
+            }
+
+            void Reset() {
+                for (uint32_t index = 0; index < BUCKETS; index++) {
+                    _buckets[index].store(0, std::memory_order_relaxed);
+                }
+                _maxUs.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            static uint64_t Percentile(const uint64_t counts[], uint64_t count, uint32_t percent, uint64_t max) {
+                if (count == 0) {
+                    return 0;
+                }
+                // rank of the sample, 1 based, rounded up
+                const uint64_t rank = ((count * percent) + 99) / 100;
+                uint64_t seen = 0;
+                uint32_t bucket = 0;
+                while ((bucket < (BUCKETS - 1)) && ((seen + counts[bucket]) < rank)) {
+                    seen += counts[bucket];
+                    bucket++;
+                }
+                const uint64_t upper = (bucket == 0) ? 0 : ((static_cast<uint64_t>(1) << bucket) - 1);
+                return (((bucket == (BUCKETS - 1)) || (upper > max)) ? max : upper);
+            }
+
+        private:
+            std::atomic<uint64_t> _buckets[BUCKETS];
+            std::atomic<uint64_t> _maxUs;
+        };
+
+        // time spent waiting for the api lock and running the method, per method
+        struct ApiMethodStats {
+            LatencyHistogram wait;
+            LatencyHistogram exec;
+        };
+
+        // keeps the ApiMethodStats of every locked method of class C, see getFunctionToCall
+        template<class C>
+        class ApiStats {
+        public:
+            struct Entry {
+                std::string method;
+                LatencyHistogram::Summary wait;
+                LatencyHistogram::Summary exec;
+            };
+
+            // the same name registered on several handlers shares one entry
+            static std::shared_ptr<ApiMethodStats> Method(const std::string& name) {
+                std::lock_guard<std::mutex> guard(Lock());
+                std::shared_ptr<ApiMethodStats>& stats = Methods()[name];
+                if (stats == nullptr) {
+                    stats = std::make_shared<ApiMethodStats>();
+                }
+                return stats;
+            }
+
+            static std::vector<Entry> Snapshot() {
+                std::lock_guard<std::mutex> guard(Lock());
+                std::vector<Entry> result;
+                result.reserve(Methods().size());
+                for (const auto& method : Methods()) {
+                    result.push_back({ method.first, method.second->wait.Report(), method.second->exec.Report() });
+                }
+                return result;
+            }
+
+            static void Reset() {
+                std::lock_guard<std::mutex> guard(Lock());
+                for (const auto& method : Methods()) {
+                    method.second->wait.Reset();
+                    method.second->exec.Reset();
+                }
+            }
+
+        private:
+            static std::mutex& Lock() {
+                static std::mutex lock;
+                return lock;
+            }
+            static std::map<std::string, std::shared_ptr<ApiMethodStats>>& Methods() {
+                static std::map<std::string, std::shared_ptr<ApiMethodStats>> methods;
+                return methods;
+            }
+        };
+
+        // holds the api lock of C in the given mode for its lifetime
+        template<class C>
+        struct ScopedApiLock {
+            const ApiLockMode _mode;
+            explicit ScopedApiLock(ApiLockMode mode) : _mode(mode) {
+                if (_mode == ApiLockMode::SHARED) {
+                    ApiLocks<C>::mtx.lock_shared();
+                } else {
+                    ApiLocks<C>::mtx.lock();
+                }
+            }
+            ~ScopedApiLock() {
+                if (_mode == ApiLockMode::SHARED) {
+                    ApiLocks<C>::mtx.unlock_shared();
+                } else {
+                    ApiLocks<C>::mtx.unlock();
+                }
+            }
+        };
 
         template <typename METHOD, typename REALOBJECT>
         std::function<uint32_t(REALOBJECT*, const WPEFramework::Core::JSON::VariantContainer&, WPEFramework::Core::JSON::VariantContainer&)>
-        getFunctionToCall(const std::string& debugname, const METHOD& method, REALOBJECT* objectPtr) {
-            return [debugname, method](REALOBJECT *obj, const WPEFramework::Core::JSON::VariantContainer& in, WPEFramework::Core::JSON::VariantContainer& out) -> uint32_t {
-                isThreadUsingLockedApi = true;
+        getFunctionToCall(const std::string& debugname, const METHOD& method, REALOBJECT* objectPtr, ApiLockMode mode = ApiLockMode::EXCLUSIVE) {
+            const std::shared_ptr<ApiMethodStats> stats = ApiStats<REALOBJECT>::Method(debugname);
+            return [debugname, method, mode, stats](REALOBJECT *obj, const WPEFramework::Core::JSON::VariantContainer& in, WPEFramework::Core::JSON::VariantContainer& out) -> uint32_t {
+                typedef std::chrono::steady_clock Clock;
+                const bool wasUsingLockedApi = isThreadUsingLockedApi;
+                const ApiLockMode previousMode = threadLockedApiMode;
                 // printf("METHOD CALL, GETTING LOCK: REALOBJECT '%s', method: '%s' MUTEX:%p\n",typeid(REALOBJECT).name(), debugname.c_str(), &ApiLocks<REALOBJECT>::mtx); fflush(stdout);
-                std::lock_guard<std::recursive_mutex> lock(ApiLocks<REALOBJECT>::mtx);
-                LOGINFO("calling %s with lock: %p\n", debugname.c_str(), &ApiLocks<REALOBJECT>::mtx);
+                const Clock::time_point requested = Clock::now();
+                ScopedApiLock<REALOBJECT> lock(mode);
+                const Clock::time_point acquired = Clock::now();
+                stats->wait.Record(std::chrono::duration_cast<std::chrono::microseconds>(acquired - requested).count());
+                isThreadUsingLockedApi = true;
+                threadLockedApiMode = mode;
+                LOGINFO("calling %s with %s lock: %p\n", debugname.c_str(), (mode == ApiLockMode::SHARED) ? "shared" : "exclusive", &ApiLocks<REALOBJECT>::mtx);
                 uint32_t ret;
                 try {
                     ret = (obj->*method)(in, out);
                 } catch (...) {
-                    isThreadUsingLockedApi = false;
+                    stats->exec.Record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - acquired).count());
+                    isThreadUsingLockedApi = wasUsingLockedApi;
+                    threadLockedApiMode = previousMode;
                     throw;
                 }
-                isThreadUsingLockedApi = false;
+                // includes time spent inside an UnlockApiGuard
+                stats->exec.Record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - acquired).count());
+                isThreadUsingLockedApi = wasUsingLockedApi;
+                threadLockedApiMode = previousMode;
                 return ret;
             };
         }
@@ -81,6 +321,57 @@ namespace Utils {
             handler->Register<JsonObject, JsonObject>(methodName, getFunctionToCall(methodName, method, objectPtr), objectPtr);
         }
 
+        // For methods that only read plugin state: they run concurrently with each other, but never with a writer.
+        template <typename METHOD, typename REALOBJECT>
+        void RegisterSharedLockedApi(const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
+        {
+            using MethodType = decltype(getFunctionToCall(methodName, method, objectPtr, ApiLockMode::SHARED));
+            objectPtr->PluginHost::JSONRPC::Register<Core::JSON::VariantContainer, Core::JSON::VariantContainer, MethodType, REALOBJECT>(methodName, getFunctionToCall(methodName, method, objectPtr, ApiLockMode::SHARED), objectPtr);
+        }
+
+        template <typename METHOD, typename REALOBJECT>
+        void RegisterSharedLockedApiForHandler(Core::JSONRPC::Handler* handler, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
+        {
+            handler->Register<JsonObject, JsonObject>(methodName, getFunctionToCall(methodName, method, objectPtr, ApiLockMode::SHARED), objectPtr);
+        }
+
+        /*
+            Diagnostics for the locked methods of REALOBJECT, registered without taking the api lock:
+            "getApiLockStats" returns {"methods": [{"method", "wait": {"count", "p50Us", "p99Us", "maxUs"}, "exec": {...}}]},
+            "resetApiLockStats" clears all histograms.
+        */
+        template <typename REALOBJECT>
+        void RegisterApiLockStatsForHandler(Core::JSONRPC::Handler* handler, REALOBJECT* objectPtr)
+        {
+            typedef std::function<uint32_t(REALOBJECT*, const JsonObject&, JsonObject&)> MethodType;
+            handler->Register<JsonObject, JsonObject>("getApiLockStats", MethodType([](REALOBJECT*, const JsonObject&, JsonObject& response) -> uint32_t {
+                const auto toJson = [](const LatencyHistogram::Summary& summary) {
+                    JsonObject result;
+                    result["count"] = summary.count;
+                    result["p50Us"] = summary.p50Us;
+                    result["p99Us"] = summary.p99Us;
+                    result["maxUs"] = summary.maxUs;
+                    return result;
+                };
+                JsonArray methods;
+                for (const auto& entry : ApiStats<REALOBJECT>::Snapshot()) {
+                    JsonObject method;
+                    method["method"] = entry.method;
+                    method["wait"] = toJson(entry.wait);
+                    method["exec"] = toJson(entry.exec);
+                    methods.Add(method);
+                }
+                response["methods"] = methods;
+                response["success"] = true;
+                return Core::ERROR_NONE;
+            }), objectPtr);
+            handler->Register<JsonObject, JsonObject>("resetApiLockStats", MethodType([](REALOBJECT*, const JsonObject&, JsonObject& response) -> uint32_t {
+                ApiStats<REALOBJECT>::Reset();
+                response["success"] = true;
+                return Core::ERROR_NONE;
+            }), objectPtr);
+        }
+
         /*
             This guard can unlock & re-lock api mutex to prevent deadlock possible when calling other plugins via Invoke
             (could deadlock in case when that other plugin called Invoke on this plugin at the same time, or tried to call
@@ -88,21 +379,26 @@ namespace Utils {
         */
         template<class UsingClass>
         struct UnlockApiGuard {
-            UnlockApiGuard() {
-                if (isThreadUsingLockedApi) {
+            const ApiLockMode _mode;
+            UnlockApiGuard() : _mode(isThreadUsingLockedApi ? threadLockedApiMode : ApiLockMode::NONE) {
+                if (_mode == ApiLockMode::EXCLUSIVE) {
                     ApiLocks<UsingClass>::mtx.unlock();
+                } else if (_mode == ApiLockMode::SHARED) {
+                    ApiLocks<UsingClass>::mtx.unlock_shared();
                 }
             }
             ~UnlockApiGuard() {
-                if (isThreadUsingLockedApi) {
+                if (_mode == ApiLockMode::EXCLUSIVE) {
                     ApiLocks<UsingClass>::mtx.lock();
+                } else if (_mode == ApiLockMode::SHARED) {
+                    ApiLocks<UsingClass>::mtx.lock_shared();
                 }
             }
         };
 
         template<class UsingClass>
         struct LockApiGuard {
-            std::unique_lock<std::recursive_mutex> _lock;
+            std::unique_lock<ApiMutex<UsingClass>> _lock;
             LockApiGuard() : _lock(ApiLocks<UsingClass>::mtx) {}
             void unlock() {
                 _lock.unlock();
@@ -49,16 +49,19 @@ namespace Utils {
         template<class UsingClass>
         static void _generic_iarm_handler(const char *owner, IARM_EventId_t eventId, void *data, size_t len) {
             auto& handlers_map = IarmHandlers<UsingClass>::_registered_iarm_handlers;
+            std::lock_guard<ApiMutex<UsingClass>> lock(ApiLocks<UsingClass>::mtx);
             isThreadUsingLockedApi = true;
-            std::lock_guard<std::recursive_mutex> lock(ApiLocks<UsingClass>::mtx);
+            threadLockedApiMode = ApiLockMode::EXCLUSIVE;
             LOGINFO("calling handler %s/%d with lock: %p\n", owner, eventId, &ApiLocks<UsingClass>::mtx);
             try {
                 handlers_map[owner][eventId](owner, eventId, data, len);
             } catch (...) {
                 isThreadUsingLockedApi = false;
+                threadLockedApiMode = ApiLockMode::NONE;
                 throw;
             }
             isThreadUsingLockedApi = false;
+            threadLockedApiMode = ApiLockMode::NONE;
         }
 
         template<class UsingClass>
@@ -66,7 +69,7 @@ namespace Utils {
             auto generic_handler = _generic_iarm_handler<UsingClass>;
             auto& handlers_map = IarmHandlers<UsingClass>::_registered_iarm_handlers;
 
-            std::lock_guard<std::recursive_mutex> lock(ApiLocks<UsingClass>::mtx);
+            std::lock_guard<ApiMutex<UsingClass>> lock(ApiLocks<UsingClass>::mtx);
             handlers_map[ownerName][eventId] = handler;
             return ::IARM_Bus_RegisterEventHandler(ownerName, eventId, generic_handler);
         }
@@ -75,7 +78,7 @@ namespace Utils {
         static IARM_Result_t RemoveLockedEventHandler(const char *ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler) {
             auto& handlers_map = IarmHandlers<UsingClass>::_registered_iarm_handlers;
 
-            std::lock_guard<std::recursive_mutex> lock(ApiLocks<UsingClass>::mtx);
+            std::lock_guard<ApiMutex<UsingClass>> lock(ApiLocks<UsingClass>::mtx);
             if (handler != handlers_map[ownerName][eventId]) {
                 LOGERR("class %s RemoveLockedEventHandler for ownerName: %s, event: %d passed handler: %p different than registered: %p\n", typeid(UsingClass).name(), ownerName, eventId, handler, handlers_map[ownerName][eventId]); fflush(stdout);
             }
@@ -19,53 +19,334 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 // telemetry
 #ifdef ENABLE_TELEMETRY_LOGGING
 #include <telemetry_busmessage_sender.h>
 #endif
 
+#define TELEMETRY_FLUSH_INTERVAL_IN_MS 1000
+#define TELEMETRY_BATCH_SIZE 64
+#define TELEMETRY_QUEUE_CAPACITY 1024
+
 namespace Utils
 {
+    /**
+     * sendMessage/sendError only enqueue: identical marker/message pairs are
+     * coalesced into one entry with a count, and a background thread hands
+     * the entries to the sink every TELEMETRY_FLUSH_INTERVAL_IN_MS or as soon
+     * as TELEMETRY_BATCH_SIZE distinct entries are pending. Beyond
+     * TELEMETRY_QUEUE_CAPACITY distinct entries new ones are dropped and
+     * reported as THUNDER_TELEMETRY_DROPPED with the next batch.
+     *
+     * The T2 sink replays a coalesced entry as count unchanged events, T2
+     * profiles may treat a marker as a counter or grep its value, so neither
+     * the message nor the number of events may change.
+     *
+     * The T2 sink is installed by default when ENABLE_TELEMETRY_LOGGING is
+     * set, otherwise there is no sink and sending is a no-op. LocalSink
+     * stands in for the T2 daemon in tests.
+     */
     struct Telemetry
     {
-        static void init()
+        struct Sink
         {
+            virtual ~Sink() = default;
+
+            // Called on the flusher thread, must not call flush().
+            virtual void emit(const std::string& marker, const std::string& message, uint32_t count) = 0;
+        };
+
 #ifdef ENABLE_TELEMETRY_LOGGING
-            t2_init((char *) "Thunder_Plugins");
+        struct T2Sink : public Sink
+        {
+            void emit(const std::string& marker, const std::string& message, uint32_t count) override
+            {
+                for (uint32_t index = 0; index < count; index++) {
+                    // get rid of const for t2_event_s
+                    t2_event_s(const_cast<char*>(marker.c_str()), const_cast<char*>(message.c_str()));
+                }
+            }
+        };
 #endif
+
+        struct LocalSink : public Sink
+        {
+            struct Event
+            {
+                std::string marker;
+                std::string message;
+                uint32_t count;
+            };
+
+            void emit(const std::string& marker, const std::string& message, uint32_t count) override
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _events.push_back({ marker, message, count });
+            }
+
+            std::vector<Event> events() const
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                return _events;
+            }
+
+            // Number of sendMessage/sendError calls represented by the emitted events.
+            uint64_t total(const std::string& marker) const
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                uint64_t result = 0;
+                for (const auto& event : _events) {
+                    if (event.marker == marker) {
+                        result += event.count;
+                    }
+                }
+                return result;
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _events.clear();
+            }
+
+        private:
+            mutable std::mutex _lock;
+            std::vector<Event> _events;
         };
 
-        static void sendMessage(char* message)
+        class Queue
         {
+        private:
+            struct Entry
+            {
+                std::string marker;
+                std::string message;
+                uint32_t count;
+            };
+
+        public:
+            static Queue& instance()
+            {
+                // never destroyed, plugins may still send during static destruction
+                static Queue* queue = new Queue();
+                return *queue;
+            }
+
+            Queue(const Queue&) = delete;
+            Queue& operator=(const Queue&) = delete;
+
+            bool enabled() const
+            {
+                return _enabled.load(std::memory_order_relaxed);
+            }
+
+            void push(const char* marker, std::string&& message)
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                if (_sink == nullptr) {
+                    return;
+                }
+
+                std::string key(marker);
+                key.push_back('\0');
+                key.append(message);
+
+                auto index = _index.find(key);
+                if (index != _index.end()) {
+                    _pending[index->second].count++;
+                    return;
+                }
+                if (_pending.size() >= _capacity) {
+                    _dropped++;
+                    return;
+                }
+
+                _index.emplace(std::move(key), _pending.size());
+                _pending.push_back({ marker, std::move(message), 1 });
+                if ((_pending.size() == 1) || (_pending.size() == _batchSize)) {
+                    if (_started == false) {
+                        start();
+                    }
+                    _signal.notify_one();
+                }
+            }
+
+            // Returns once everything queued before the call has been emitted.
+            void flush()
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                if (_started == false) {
+                    return;
+                }
+                const uint64_t request = ++_flushRequested;
+                _signal.notify_one();
+                while (_flushCompleted < request) {
+                    _flushed.wait(lock);
+                }
+            }
+
+            // Replaces the sink, nullptr disables telemetry. Pending entries go to the new sink.
+            void sink(const std::shared_ptr<Sink>& sink)
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _sink = sink;
+                _enabled = (sink != nullptr);
+            }
+
+            void configure(uint32_t intervalInMs, uint32_t batchSize, uint32_t capacity)
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _intervalInMs = intervalInMs;
+                _batchSize = (batchSize > 0) ? batchSize : 1;
+                _capacity = (capacity > 0) ? capacity : 1;
+                _signal.notify_one();
+            }
+
+        private:
+            Queue()
+                : _lock()
+                , _signal()
+                , _flushed()
+                , _index()
+                , _pending()
+                , _dropped(0)
+                , _sink()
+                , _enabled(false)
+                , _intervalInMs(TELEMETRY_FLUSH_INTERVAL_IN_MS)
+                , _batchSize(TELEMETRY_BATCH_SIZE)
+                , _capacity(TELEMETRY_QUEUE_CAPACITY)
+                , _flushRequested(0)
+                , _flushCompleted(0)
+                , _started(false)
+            {
 #ifdef ENABLE_TELEMETRY_LOGGING
-            t2_event_s((char *)"THUNDER_MESSAGE", message);
+                _sink = std::make_shared<T2Sink>();
+                _enabled = true;
 #endif
+            }
+
+            // Must be called with _lock held.
+            void start()
+            {
+                try {
+                    std::thread(&Queue::process, this).detach();
+                    _started = true;
+                    ::atexit(&Queue::atExit);
+                } catch (const std::system_error&) {
+                    // retried with the next batch
+                }
+            }
+
+            static void atExit()
+            {
+                instance().flush();
+            }
+
+            bool flushRequested() const
+            {
+                return (_flushRequested != _flushCompleted);
+            }
+
+            void process()
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                while (true) {
+                    _signal.wait(lock, [this]() { return ((_pending.empty() == false) || (_dropped != 0) || (flushRequested() == true)); });
+                    _signal.wait_for(lock, std::chrono::milliseconds(_intervalInMs),
+                        [this]() { return ((_pending.size() >= _batchSize) || (flushRequested() == true)); });
+
+                    std::vector<Entry> batch;
+                    batch.swap(_pending);
+                    _index.clear();
+                    const uint64_t dropped = _dropped;
+                    _dropped = 0;
+                    const uint64_t request = _flushRequested;
+                    std::shared_ptr<Sink> sink = _sink;
+                    lock.unlock();
+
+                    if (sink != nullptr) {
+                        for (const Entry& entry : batch) {
+                            sink->emit(entry.marker, entry.message, entry.count);
+                        }
+                        if (dropped != 0) {
+                            sink->emit("THUNDER_TELEMETRY_DROPPED", std::to_string(dropped), 1);
+                        }
+                    }
+
+                    lock.lock();
+                    _flushCompleted = request;
+                    _flushed.notify_all();
+                }
+            }
+
+        private:
+            std::mutex _lock;
+            std::condition_variable _signal;
+            std::condition_variable _flushed;
+            std::unordered_map<std::string, size_t> _index; // marker '\0' message -> _pending
+            std::vector<Entry> _pending;
+            uint64_t _dropped;
+            std::shared_ptr<Sink> _sink;
+            std::atomic<bool> _enabled;
+            uint32_t _intervalInMs;
+            uint32_t _batchSize;
+            uint32_t _capacity;
+            uint64_t _flushRequested;
+            uint64_t _flushCompleted;
+            bool _started;
         };
 
-        static void sendMessage(char *marker, char* message)
+        static void init()
         {
 #ifdef ENABLE_TELEMETRY_LOGGING
-            t2_event_s(marker, message);
+            t2_init((char *) "Thunder_Plugins");
 #endif
         };
 
+        static void sendMessage(char* message)
+        {
+            sendMessage((char *)"THUNDER_MESSAGE", message);
+        };
+
+        static void sendMessage(char *marker, char* message)
+        {
+            Queue& queue = Queue::instance();
+            if (queue.enabled() == true) {
+                queue.push(marker, std::string(message));
+            }
+        };
+
         static void sendError(const char* format, ...)
         {
-#ifdef ENABLE_TELEMETRY_LOGGING
-            va_list parameters;
-            va_start(parameters, format);
-            std::string message;
-            WPEFramework::Trace::Format(message, format, parameters);
-            va_end(parameters);
+            Queue& queue = Queue::instance();
+            if (queue.enabled() == true) {
+                va_list parameters;
+                va_start(parameters, format);
+                std::string message;
+                WPEFramework::Trace::Format(message, format, parameters);
+                va_end(parameters);
 
-            // get rid of const for t2_event_s
-            char* error = strdup(message.c_str());
-            t2_event_s((char *)"THUNDER_ERROR", error);
-            if (error)
-            {
-                free(error);
+                queue.push("THUNDER_ERROR", std::move(message));
             }
-#endif
+        };
+
+        // Emits everything queued so far, e.g. before the process exits.
+        static void flush()
+        {
+            Queue::instance().flush();
         };
     };
 }
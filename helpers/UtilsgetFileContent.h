@@ -19,84 +19,296 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cerrno>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "UtilsString.h"
 #define READ_BUFFER_SIZE 1024
+// longest chain of "$NAME" references followed in a properties file
+#define PROPERTY_EXPANSION_DEPTH 8
 namespace Utils {
 
 /**
- * @brief Read the property value from the given file based on the provided property name.
- * @param[in] filename - The name of the file from which to read the properties.
- * @param[in] property -  The name of the property to search for in the file.
- * @param[out] propertyValue - The value of the property will be stored in this string.
- * @return          bool  True if the property is found and successfully read, false otherwise.
+ * Properties files ("NAME=value" lines, '#' comments) parsed once per process.
+ *
+ * Each file is parsed into a hash map with "$OTHER" references already
+ * expanded. The directory of every cached file is watched with inotify, and
+ * a lookup only drains the (usually empty) non blocking inotify queue before
+ * reading the map, so changes written before the lookup are always seen.
+ * Without inotify a lookup compares the file's stat() instead.
  */
-inline bool readPropertyFromFile(const char* filename, const string& property, string& propertyValue)
-{
-    string line = "";
-    bool found = false;
-    std::ifstream file(filename);
-    propertyValue = "";
-    if (file.is_open())
+class PropertyFileCache {
+public:
+    enum class Lookup {
+        FOUND,
+        MISSING, // no such property, or its reference can't be expanded
+        NO_FILE
+    };
+
+    static PropertyFileCache& Instance()
     {
-        while (std::getline(file, line))
+        // never destroyed, plugins may still look up during static destruction
+        static PropertyFileCache* cache = new PropertyFileCache();
+        return *cache;
+    }
+
+    PropertyFileCache(const PropertyFileCache&) = delete;
+    PropertyFileCache& operator=(const PropertyFileCache&) = delete;
+
+    Lookup Get(const string& filename, const string& property, string& value)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        Drain();
+
+        File& file = _files[filename];
+        if (file.watch < 0) {
+            Watch(filename, file);
+            if ((file.watch < 0) && (file.stale == false) && (Changed(filename, file) == true)) {
+                file.stale = true;
+            }
+        }
+        if (file.stale == true) {
+            Load(filename, file);
+        }
+
+        if (file.exists == false) {
+            return Lookup::NO_FILE;
+        }
+        auto index = file.values.find(property);
+        if (index == file.values.end()) {
+            return Lookup::MISSING;
+        }
+        value = index->second;
+        return Lookup::FOUND;
+    }
+
+    // Forgets all files, the next lookups read them again.
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (auto& directory : _directories) {
+            inotify_rm_watch(_inotify, directory.first);
+        }
+        _directories.clear();
+        _files.clear();
+    }
+
+private:
+    struct File {
+        File()
+            : stale(true)
+            , exists(false)
+            , watch(-1)
+            , info()
+            , values()
         {
+        }
+
+        bool stale;
+        bool exists;
+        int watch; // of the directory, -1 if not watched
+        struct stat info; // compared when not watched
+        std::unordered_map<string, string> values;
+    };
+
+    struct Directory {
+        string path;
+        std::vector<string> files;
+    };
+
+    PropertyFileCache()
+        : _lock()
+        , _files()
+        , _directories()
+        , _inotify(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    {
+        if (_inotify < 0) {
+            LOGWARN("inotify unavailable (%d), property files are checked with stat", errno);
+        }
+    }
+
+    void Watch(const string& filename, File& file)
+    {
+        if (_inotify < 0) {
+            return;
+        }
+        const size_t slash = filename.find_last_of('/');
+        const string directory = (slash == string::npos) ? "." : ((slash == 0) ? "/" : filename.substr(0, slash));
+        const int watch = inotify_add_watch(_inotify, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+        if (watch < 0) {
+            return;
+        }
+        Directory& entry = _directories[watch];
+        entry.path = directory;
+        if (std::find(entry.files.begin(), entry.files.end(), filename) == entry.files.end()) {
+            entry.files.push_back(filename);
+        }
+        file.watch = watch;
+        // whatever was read before is not covered by the watch
+        file.stale = true;
+    }
+
+    // Marks the files changed since the last lookup as stale.
+    void Drain()
+    {
+        if (_inotify < 0) {
+            return;
+        }
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(_inotify, buffer, sizeof(buffer))) > 0) {
+            for (char* position = buffer; position < (buffer + length);) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(position);
+                position += sizeof(struct inotify_event) + event->len;
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                    for (auto& file : _files) {
+                        file.second.stale = true;
+                    }
+                    continue;
+                }
+                auto directory = _directories.find(event->wd);
+                if (directory == _directories.end()) {
+                    continue;
+                }
+                if ((event->mask & IN_IGNORED) != 0) {
+                    // directory is gone, watch it again with the next lookup
+                    for (const string& name : directory->second.files) {
+                        File& file = _files[name];
+                        file.watch = -1;
+                        file.stale = true;
+                    }
+                    _directories.erase(directory);
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+                const string name = ((directory->second.path == "/") ? "/" : (directory->second.path + "/")) + event->name;
+                auto file = _files.find(name);
+                if (file != _files.end()) {
+                    file->second.stale = true;
+                }
+            }
+        }
+    }
+
+    static bool Changed(const string& filename, const File& file)
+    {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) {
+            return (file.exists == true);
+        }
+        return ((file.exists == false) || (info.st_ino != file.info.st_ino) || (info.st_size != file.info.st_size)
+            || (info.st_mtim.tv_sec != file.info.st_mtim.tv_sec) || (info.st_mtim.tv_nsec != file.info.st_mtim.tv_nsec));
+    }
+
+    static void Load(const string& filename, File& file)
+    {
+        file.stale = false;
+        file.values.clear();
+        file.exists = (stat(filename.c_str(), &file.info) == 0);
+
+        std::ifstream stream(filename);
+        if (stream.is_open() == false) {
+            file.exists = false;
+            return;
+        }
+
+        // every definition of a name in file order, the first one that can be expanded wins
+        std::unordered_map<string, std::vector<string>> raw;
+        string line;
+        while (std::getline(stream, line)) {
             // Skip lines that start with '#' (single-line comments)
-            if (!line.empty() && line[0] == '#')
-            {
+            if (line.empty() || (line[0] == '#')) {
                 continue;
             }
-            if (line.find(property + " ") == 0 || line.find(property + "=") == 0)
-            {
-                string propertyContent = line.substr(line.find("=") + 1);
+            const size_t equals = line.find('=');
+            if (equals == string::npos) {
+                continue;
+            }
+            const string content = line.substr(equals + 1);
+            raw[line.substr(0, equals)].push_back(content);
+            // "NAME = value" is found as NAME too
+            const size_t space = line.find(' ');
+            if (space < equals) {
+                raw[line.substr(0, space)].push_back(content);
+            }
+        }
 
-                // If the property value starts with '$',recursively expand it
-                if (!propertyContent.empty() && propertyContent[0] == '$')
-                {
-                    string expandedProperty = propertyContent.substr(1);
-                    if (readPropertyFromFile(filename, expandedProperty, propertyValue))
-                    {
-                        found = true;
-                        break;
-                    }
-                    else
-                    {
-                        LOGERR("Failed to find expanded property: %s", expandedProperty.c_str());
-                    }
+        for (const auto& entry : raw) {
+            string value;
+            if (Expand(raw, entry.first, 0, value) == true) {
+                file.values.emplace(entry.first, value);
+            }
+        }
+    }
+
+    static bool Expand(const std::unordered_map<string, std::vector<string>>& raw, const string& property, uint32_t depth, string& value)
+    {
+        auto index = raw.find(property);
+        if ((index == raw.end()) || (depth > PROPERTY_EXPANSION_DEPTH)) {
+            return false;
+        }
+        for (const string& content : index->second) {
+            // If the property value starts with '$', expand it
+            if (!content.empty() && (content[0] == '$')) {
+                if (Expand(raw, content.substr(1), depth + 1, value) == true) {
+                    return true;
                 }
-                else
-                {
-                    // If it does not start with '$', set propertyValue directly
-                    propertyValue = propertyContent;
-                    if (!propertyValue.empty())
-                    {
-                        // Remove new line character from end of the string if it exists
-                        if ((propertyValue.back() == '\r') || (propertyValue.back() == '\n'))
-                        {
-                            propertyValue.pop_back();
-                        }
-                    }
-                    found = true;
-                    break;
+                LOGERR("Failed to find expanded property: %s", content.substr(1).c_str());
+            } else {
+                value = content;
+                // Remove new line character from end of the string if it exists
+                if (!value.empty() && ((value.back() == '\r') || (value.back() == '\n'))) {
+                    value.pop_back();
                 }
+                return true;
             }
         }
+        return false;
     }
-    else
+
+private:
+    std::mutex _lock;
+    std::unordered_map<string, File> _files;
+    std::unordered_map<int, Directory> _directories; // inotify watch -> cached files in that directory
+    const int _inotify;
+};
+
+/**
+ * @brief Read the property value from the given file based on the provided property name.
+ * @param[in] filename - The name of the file from which to read the properties.
+ * @param[in] property -  The name of the property to search for in the file.
+ * @param[out] propertyValue - The value of the property will be stored in this string.
+ * @return          bool  True if the property is found and successfully read, false otherwise.
+ */
+inline bool readPropertyFromFile(const char* filename, const string& property, string& propertyValue)
+{
+    propertyValue = "";
+    const PropertyFileCache::Lookup result = PropertyFileCache::Instance().Get(filename, property, propertyValue);
+    if (result == PropertyFileCache::Lookup::NO_FILE)
     {
         LOGERR("File is not open");
     }
 
     // If the property was not found, set the propertyValue to an empty string
-    if (!found)
+    if (result != PropertyFileCache::Lookup::FOUND)
     {
        LOGERR("Variable value is empty");
     }
 
-    return found;
+    return (result == PropertyFileCache::Lookup::FOUND);
 }
 
 /**
@@ -19,20 +19,57 @@
 
 #pragma once
 
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <plugins/plugins.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "UtilsfileExists.h"
 
+#define CSETTINGS_QUIET_PERIOD_IN_MS 500
+#define CSETTINGS_MAX_DELAY_IN_MS 5000
+
 using namespace std;
 
+/*
+ * key=value settings file, kept in memory and written back on every change.
+ *
+ * The file is replaced atomically: the content goes to "<file>.tmp", which is
+ * fsync'ed and renamed over the file, so a crash leaves either the old or the
+ * new version. beginTransaction()/commit() batch several changes into one
+ * write. With enableWriteBehind() changes are written from a background
+ * thread once no change happened for the quiet period (and at most
+ * maxDelayInMs after the first unwritten change). Reads always see the
+ * in-memory state.
+ */
 class cSettings {
     std::string filename;
     JsonObject data;
 
+    std::mutex dataLock; // data and the write state below
+    std::mutex fileLock; // serialises writes of filename, taken before dataLock
+    std::condition_variable changed;
+    bool dirty;
+    uint64_t generation;
+    uint32_t transactionDepth;
+    bool writeBehind;
+    uint32_t quietPeriodInMs;
+    uint32_t maxDelayInMs;
+    bool stopping;
+    std::thread flusher;
+
 public:
     /***
      * @brief    : Constructor.
@@ -42,6 +79,13 @@ public:
     // Reason: Passing std::string by value causes unnecessary copy
     // Impact: No API signature changes (compatible). More efficient parameter passing.
     cSettings(const std::string& file)
+        : dirty(false)
+        , generation(0)
+        , transactionDepth(0)
+        , writeBehind(false)
+        , quietPeriodInMs(CSETTINGS_QUIET_PERIOD_IN_MS)
+        , maxDelayInMs(CSETTINGS_MAX_DELAY_IN_MS)
+        , stopping(false)
     {
         filename = file;
         if (!readFromFile()) {
@@ -51,17 +95,107 @@ public:
             if (!fs.is_open()) {
                 std::cout << "Error:[ctor cSettings] unable to open configuration file." << std::endl;
             } else {
-                fs << flush;
+                fs << std::flush;
                 fs.close();
             }
         }
     }
 
     /***
-     * @brief    : Destructor.
+     * @brief    : Destructor, writes pending changes.
      * @return   : nil.
      */
-    ~cSettings() = default;
+    ~cSettings()
+    {
+        {
+            std::lock_guard<std::mutex> lock(dataLock);
+            stopping = true;
+        }
+        changed.notify_all();
+        if (flusher.joinable()) {
+            flusher.join();
+        }
+        flush();
+    }
+
+    cSettings(const cSettings&) = delete;
+    cSettings& operator=(const cSettings&) = delete;
+
+    /***
+     * @brief        : Write changes from a background thread once they settle.
+     * @param1[in]   : <uint32_t> time without changes before writing
+     * @param2[in]   : <uint32_t> longest time a change stays unwritten
+     * @return       : <bool> False if the thread couldn't be started; changes are then written synchronously.
+     */
+    bool enableWriteBehind(uint32_t quietPeriod = CSETTINGS_QUIET_PERIOD_IN_MS, uint32_t maxDelay = CSETTINGS_MAX_DELAY_IN_MS)
+    {
+        std::lock_guard<std::mutex> lock(dataLock);
+        quietPeriodInMs = quietPeriod;
+        maxDelayInMs = (maxDelay > quietPeriod) ? maxDelay : quietPeriod;
+        if (!flusher.joinable()) {
+            try {
+                flusher = std::thread(&cSettings::flushLoop, this);
+            } catch (const std::system_error&) {
+                std::cout << "Error:[cSettings] unable to start write-behind thread." << std::endl;
+                return false;
+            }
+        }
+        writeBehind = true;
+        changed.notify_all();
+        return true;
+    }
+
+    /***
+     * @brief    : Defer writes until the matching commit(); transactions nest.
+     * @return   : nil.
+     */
+    void beginTransaction()
+    {
+        std::lock_guard<std::mutex> lock(dataLock);
+        transactionDepth++;
+    }
+
+    /***
+     * @brief    : End a transaction; the outermost commit writes all its changes at once.
+     * @return   : <bool> False if there was no transaction or the write failed.
+     */
+    bool commit()
+    {
+        std::unique_lock<std::mutex> lock(dataLock);
+        if (transactionDepth == 0) {
+            return false;
+        }
+        if (--transactionDepth > 0) {
+            return true;
+        }
+        lock.unlock();
+        return flush();
+    }
+
+    /***
+     * @brief    : Write pending changes now.
+     * @return   : <bool> False if the write failed.
+     */
+    bool flush()
+    {
+        std::lock_guard<std::mutex> file(fileLock);
+        std::string content;
+        {
+            std::lock_guard<std::mutex> lock(dataLock);
+            if (!dirty) {
+                return true;
+            }
+            dirty = false;
+            content = serialize();
+        }
+        if (!replaceFile(content)) {
+            // still unwritten: retried by the flusher, the next change or the destructor
+            std::lock_guard<std::mutex> lock(dataLock);
+            dirty = true;
+            return false;
+        }
+        return true;
+    }
 
     /***
      * @brief        : Get value of given key.
@@ -70,6 +204,7 @@ public:
      */
     JsonValue getValue(std::string key)
     {
+        std::lock_guard<std::mutex> lock(dataLock);
         return data.Get(key.c_str());
     }
 
@@ -81,8 +216,9 @@ public:
      */
     bool setValue(std::string key, std::string value)
     {
+        std::unique_lock<std::mutex> lock(dataLock);
         data[key.c_str()] = value;
-        return writeToFile();
+        return modified(lock);
     }
 
     /***
@@ -93,8 +229,9 @@ public:
      */
     bool setValue(std::string key, int value)
     {
+        std::unique_lock<std::mutex> lock(dataLock);
         data[key.c_str()] = value;
-        return writeToFile();
+        return modified(lock);
     }
 
     /***
@@ -105,8 +242,9 @@ public:
      */
     bool setValue(std::string key, bool value)
     {
+        std::unique_lock<std::mutex> lock(dataLock);
         data[key.c_str()] = value;
-        return writeToFile();
+        return modified(lock);
     }
 
     /***
@@ -116,17 +254,8 @@ public:
      */
     bool contains(std::string key)
     {
-        bool resp = false;
-        if (data.HasLabel(key.c_str())) {
-            if (data[key.c_str()].String().empty()) {
-                resp = false;
-            } else {
-                resp = true;
-            }
-        } else {
-            resp = false;
-        }
-        return resp;
+        std::lock_guard<std::mutex> lock(dataLock);
+        return containsLocked(key);
     }
 
     /***
@@ -137,6 +266,7 @@ public:
     bool remove(std::string key)
     {
         bool status = false;
+        std::unique_lock<std::mutex> lock(dataLock);
         /*
          * Noticed that there is an error with the Remove function.
          * work around is to assign a null value to the key and handle it
@@ -144,8 +274,8 @@ public:
          */
         data[key.c_str()] = "";
         data.Remove(key.c_str());
-        if (!contains(key)) {
-            if (writeToFile()) {
+        if (!containsLocked(key)) {
+            if (modified(lock)) {
                 status = true;
             } else {
                 status = false;
@@ -157,34 +287,154 @@ public:
     }
 
     /***
-     * @brief    : Update new inserts into the json object onto file.
-     * @return   : <bool> False if timer thread couldn't be started.
+     * @brief    : Write the json object onto file now, also if nothing changed.
+     * @return   : <bool> False if the file couldn't be written.
      */
     bool writeToFile()
     {
-        bool status = false;
+        {
+            std::lock_guard<std::mutex> lock(dataLock);
+            dirty = true;
+        }
+        return flush();
+    }
 
-        if (Utils::fileExists(filename.c_str())) {
-            ofstream ofile;
-            ofile.open(filename.c_str(), ios::out);
-            if (ofile) {
-                JsonObject::Iterator iterator = data.Variants();
-                while (iterator.Next()) {
-                    if (!data[iterator.Label()].String().empty()) {
-                        ofile << iterator.Label() << "=" << data[iterator.Label()].String() << endl;
-                    } else {
-                        continue;
-                    }
-                }
-                status = true;
-                ofile.close();
+private:
+    // Must be called with dataLock held.
+    bool containsLocked(const std::string& key)
+    {
+        bool resp = false;
+        if (data.HasLabel(key.c_str())) {
+            if (data[key.c_str()].String().empty()) {
+                resp = false;
             } else {
+                resp = true;
+            }
+        } else {
+            resp = false;
+        }
+        return resp;
+    }
+
+    /***
+     * @brief    : Record a change made with dataLock held; writes it unless deferred.
+     * @return   : <bool> False if the synchronous write failed.
+     */
+    bool modified(std::unique_lock<std::mutex>& lock)
+    {
+        dirty = true;
+        generation++;
+        if ((transactionDepth > 0) || writeBehind) {
+            changed.notify_all();
+            return true;
+        }
+        lock.unlock();
+        return flush();
+    }
+
+    // Must be called with dataLock held.
+    std::string serialize()
+    {
+        std::string content;
+        JsonObject::Iterator iterator = data.Variants();
+        while (iterator.Next()) {
+            if (!data[iterator.Label()].String().empty()) {
+                content += iterator.Label();
+                content += "=";
+                content += data[iterator.Label()].String();
+                content += "\n";
+            }
+        }
+        return content;
+    }
+
+    /***
+     * @brief    : Replace the file by a temp file holding content: write, fsync, rename.
+     * @return   : <bool> False if the file is gone or couldn't be written.
+     */
+    bool replaceFile(const std::string& content)
+    {
+        struct stat fileStat;
+        if (0 != stat(filename.c_str(), &fileStat)) {
+            return false;
+        }
+
+        const std::string temp = filename + ".tmp";
+        int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, fileStat.st_mode & 07777);
+        if (fd < 0) {
+            std::cout << "Error:[cSettings] unable to open " << temp << std::endl;
+            return false;
+        }
+        bool status = (0 == fchmod(fd, fileStat.st_mode & 07777));
+        size_t written = 0;
+        while (status && (written < content.size())) {
+            ssize_t result = write(fd, content.data() + written, content.size() - written);
+            if (result > 0) {
+                written += static_cast<size_t>(result);
+            } else if ((result < 0) && (errno != EINTR)) {
                 status = false;
             }
         }
-        return status;
+        status = status && (0 == fsync(fd));
+        status = (0 == close(fd)) && status;
+        status = status && (0 == rename(temp.c_str(), filename.c_str()));
+        if (!status) {
+            std::cout << "Error:[cSettings] unable to write " << filename << std::endl;
+            unlink(temp.c_str());
+            return false;
+        }
+
+        // make the rename itself durable
+        const size_t slash = filename.find_last_of('/');
+        const std::string directory = (slash == std::string::npos) ? "." : ((slash == 0) ? "/" : filename.substr(0, slash));
+        int dir = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir >= 0) {
+            fsync(dir);
+            close(dir);
+        }
+        return true;
     }
 
+    void flushLoop()
+    {
+        typedef std::chrono::steady_clock Clock;
+        std::unique_lock<std::mutex> lock(dataLock);
+        while (true) {
+            changed.wait(lock, [this]() { return (stopping || (dirty && (transactionDepth == 0))); });
+            if (stopping) {
+                break;
+            }
+
+            // wait until changes settle, but not beyond the max delay
+            const Clock::time_point latest = Clock::now() + std::chrono::milliseconds(maxDelayInMs);
+            uint64_t seen;
+            do {
+                seen = generation;
+                Clock::time_point until = Clock::now() + std::chrono::milliseconds(quietPeriodInMs);
+                if (until > latest) {
+                    until = latest;
+                }
+                changed.wait_until(lock, until, [this, seen]() { return (stopping || (generation != seen)); });
+            } while (!stopping && (generation != seen) && (Clock::now() < latest));
+            if (stopping) {
+                break;
+            }
+            if (transactionDepth > 0) {
+                // commit() writes
+                continue;
+            }
+
+            lock.unlock();
+            const bool written = flush();
+            lock.lock();
+            if (!written) {
+                // don't hammer a failing file, try again after the max delay
+                changed.wait_for(lock, std::chrono::milliseconds(maxDelayInMs), [this]() { return stopping; });
+            }
+        }
+    }
+
+public:
     /***
      * @brief    : Initialise the jsonobject from a given conf file.
      * @return   : <bool> False if file couldn't be accessed, else True.
@@ -196,6 +446,7 @@ public:
         if (!Utils::fileExists(filename.c_str())) {
             return retStatus;
         }
+        std::lock_guard<std::mutex> lock(dataLock);
         fstream ifile(filename, ios::in);
         if (ifile) {
             while (!ifile.eof()) {
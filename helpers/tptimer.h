@@ -23,12 +23,311 @@
 //#include <core/Timer.h>
 #include <plugins/plugins.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
+
+#define TP_TIMER_WHEEL_TICK_IN_MS 10
+#define TP_TIMER_WHEEL_STACK_SIZE (64 * 1024)
+
 namespace WPEFramework {
 
 namespace Plugin {
+    /**
+     * Process-wide hierarchical timer wheel serving every TpTimer from one thread.
+     *
+     * Level 0 has 256 slots of TP_TIMER_WHEEL_TICK_IN_MS, levels 1..3 have 64
+     * slots each covering the whole lower level, so timers up to ~7.7 days are
+     * inserted and removed in O(1); longer ones are re-cascaded. The thread
+     * sleeps until the next occupied level 0 slot or cascade, not every tick.
+     *
+     * Callbacks run on the wheel thread one at a time and must not block for
+     * long, a slow callback delays every other timer in the process.
+     * Instance() is a function-local static in an inline function, which GCC
+     * emits as a unique symbol, so all plugin libraries share one wheel.
+     */
+    class TpTimerWheel {
+    public:
+        class Entry {
+        public:
+            Entry()
+                : _previous(this)
+                , _next(this)
+                , _expiry(0)
+            {
+            }
+            virtual ~Entry() = default;
+
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            virtual void Expired() = 0;
+
+        private:
+            friend class TpTimerWheel;
+
+            bool IsLinked() const
+            {
+                return (_next != this);
+            }
+            void Unlink()
+            {
+                _previous->_next = _next;
+                _next->_previous = _previous;
+                _previous = this;
+                _next = this;
+            }
+            void Append(Entry& head)
+            {
+                _previous = head._previous;
+                _next = &head;
+                head._previous->_next = this;
+                head._previous = this;
+            }
+
+            Entry* _previous;
+            Entry* _next;
+            uint64_t _expiry; // in ticks
+        };
+
+    private:
+        static constexpr uint32_t LEVEL0_BITS = 8;
+        static constexpr uint32_t LEVELN_BITS = 6;
+        static constexpr uint32_t LEVELS = 4;
+        static constexpr uint32_t LEVEL0_SLOTS = (1 << LEVEL0_BITS);
+        static constexpr uint32_t LEVELN_SLOTS = (1 << LEVELN_BITS);
+
+        class Head : public Entry {
+        public:
+            void Expired() override {}
+        };
+
+    public:
+        static TpTimerWheel& Instance()
+        {
+            static TpTimerWheel wheel;
+            return (wheel);
+        }
+
+        TpTimerWheel(const TpTimerWheel&) = delete;
+        TpTimerWheel& operator=(const TpTimerWheel&) = delete;
+
+        ~TpTimerWheel()
+        {
+            std::unique_lock<std::mutex> lock(_adminLock);
+            if (_running == true) {
+                _exit = true;
+                _signal.notify_all();
+                lock.unlock();
+                pthread_join(_thread, nullptr);
+            }
+        }
+
+        // (Re)schedules the entry to expire after delayInMs.
+        void Schedule(Entry& entry, int delayInMs)
+        {
+            std::unique_lock<std::mutex> lock(_adminLock);
+            if (entry.IsLinked()) {
+                entry.Unlink();
+                _scheduled--;
+            }
+            // round up, plus the part of the current tick that has already passed, so it never fires early
+            const uint64_t delayInTicks = (delayInMs > 0) ? (((static_cast<uint64_t>(delayInMs) + TP_TIMER_WHEEL_TICK_IN_MS - 1) / TP_TIMER_WHEEL_TICK_IN_MS) + 1) : 0;
+            entry._expiry = NowInTicks() + delayInTicks;
+            Insert(entry);
+            _scheduled++;
+
+            if (_running == false) {
+                Start();
+            } else if (entry._expiry < _wakeTick) {
+                _signal.notify_one();
+            }
+        }
+
+        // Cancels the entry. With `wait`, also waits for a running Expired() of this entry,
+        // unless called from that Expired() itself.
+        void Revoke(Entry& entry, bool wait)
+        {
+            std::unique_lock<std::mutex> lock(_adminLock);
+            if (entry.IsLinked()) {
+                entry.Unlink();
+                _scheduled--;
+            }
+            if (wait == true) {
+                while ((_executing == &entry) && (pthread_equal(_thread, pthread_self()) == 0)) {
+                    _completed.wait(lock);
+                }
+            }
+        }
+
+    private:
+        TpTimerWheel()
+            : _adminLock()
+            , _signal()
+            , _completed()
+            , _epoch(std::chrono::steady_clock::now())
+            , _current(0)
+            , _wakeTick(0)
+            , _scheduled(0)
+            , _executing(nullptr)
+            , _running(false)
+            , _exit(false)
+            , _thread()
+        {
+        }
+
+        uint64_t NowInTicks() const
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _epoch).count()) / TP_TIMER_WHEEL_TICK_IN_MS;
+        }
+
+        // Must be called with _adminLock held.
+        void Start()
+        {
+            pthread_attr_t attributes;
+            pthread_attr_init(&attributes);
+            pthread_attr_setstacksize(&attributes, TP_TIMER_WHEEL_STACK_SIZE);
+            // on failure the next Schedule() tries again
+            _running = (pthread_create(&_thread, &attributes, &TpTimerWheel::Worker, this) == 0);
+            pthread_attr_destroy(&attributes);
+        }
+
+        // Must be called with _adminLock held.
+        void Insert(Entry& entry)
+        {
+            const uint64_t expiry = entry._expiry;
+            const uint64_t delta = (expiry > _current) ? (expiry - _current) : 0;
+
+            if (delta == 0) {
+                entry.Append(_due);
+            } else if (delta < (1ULL << LEVEL0_BITS)) {
+                entry.Append(_level0[expiry & (LEVEL0_SLOTS - 1)]);
+            } else {
+                uint32_t level = 1;
+                uint32_t shift = LEVEL0_BITS;
+                while ((level < (LEVELS - 1)) && (delta >= (1ULL << (shift + LEVELN_BITS)))) {
+                    level++;
+                    shift += LEVELN_BITS;
+                }
+                // beyond the top level: park in the furthest slot, it is re-cascaded from there
+                const uint64_t placement = (delta < (1ULL << (shift + LEVELN_BITS))) ? expiry : (_current + (1ULL << (shift + LEVELN_BITS)) - 1);
+                entry.Append(_levelN[level - 1][(placement >> shift) & (LEVELN_SLOTS - 1)]);
+            }
+        }
+
+        // Must be called with _adminLock held.
+        void Cascade(Head& slot)
+        {
+            while (slot.IsLinked()) {
+                Entry* entry = slot._next;
+                entry->Unlink();
+                Insert(*entry);
+            }
+        }
+
+        // Moves the wheel to _current + 1. Must be called with _adminLock held.
+        void Advance()
+        {
+            const uint64_t tick = ++_current;
+            if ((tick & (LEVEL0_SLOTS - 1)) == 0) {
+                uint32_t shift = LEVEL0_BITS;
+                uint32_t level = 1;
+                // find the highest level that wraps at this tick, then cascade top-down
+                while ((level < (LEVELS - 1)) && (((tick >> shift) & (LEVELN_SLOTS - 1)) == 0)) {
+                    level++;
+                    shift += LEVELN_BITS;
+                }
+                while (level >= 1) {
+                    Cascade(_levelN[level - 1][(tick >> shift) & (LEVELN_SLOTS - 1)]);
+                    level--;
+                    shift -= LEVELN_BITS;
+                }
+            }
+
+            Head& slot = _level0[tick & (LEVEL0_SLOTS - 1)];
+            while (slot.IsLinked()) {
+                Entry* entry = slot._next;
+                entry->Unlink();
+                entry->Append(_due);
+            }
+        }
+
+        // The next tick at which the wheel has work. Must be called with _adminLock held.
+        uint64_t NextTick() const
+        {
+            const uint64_t boundary = ((_current >> LEVEL0_BITS) + 1) << LEVEL0_BITS;
+            for (uint64_t tick = _current + 1; tick < boundary; tick++) {
+                if (_level0[tick & (LEVEL0_SLOTS - 1)].IsLinked()) {
+                    return (tick);
+                }
+            }
+            return (boundary);
+        }
+
+        static void* Worker(void* data)
+        {
+            pthread_setname_np(pthread_self(), "TpTimerWheel");
+            static_cast<TpTimerWheel*>(data)->Process();
+            return (nullptr);
+        }
+
+        void Process()
+        {
+            std::unique_lock<std::mutex> lock(_adminLock);
+            while (_exit == false) {
+                const uint64_t now = NowInTicks();
+                while (_current < now) {
+                    Advance();
+                }
+
+                while (_due.IsLinked()) {
+                    Entry* entry = _due._next;
+                    entry->Unlink();
+                    _scheduled--;
+                    _executing = entry;
+                    lock.unlock();
+                    entry->Expired();
+                    lock.lock();
+                    _executing = nullptr;
+                    _completed.notify_all();
+                }
+
+                if (NowInTicks() > _current) {
+                    continue;
+                }
+                if (_scheduled == 0) {
+                    _wakeTick = UINT64_MAX;
+                    _signal.wait(lock);
+                } else {
+                    _wakeTick = NextTick();
+                    _signal.wait_until(lock, _epoch + std::chrono::milliseconds(_wakeTick * TP_TIMER_WHEEL_TICK_IN_MS));
+                }
+            }
+        }
+
+    private:
+        std::mutex _adminLock;
+        std::condition_variable _signal;
+        std::condition_variable _completed;
+        const std::chrono::steady_clock::time_point _epoch;
+        uint64_t _current;
+        uint64_t _wakeTick;
+        uint32_t _scheduled;
+        Entry* _executing;
+        bool _running;
+        bool _exit;
+        pthread_t _thread;
+        Head _due;
+        Head _level0[LEVEL0_SLOTS];
+        Head _levelN[LEVELS - 1][LEVELN_SLOTS];
+    };
+
     class TpTimer {
     private:
-        class TpTimerJob {
+        class TpTimerJob : public TpTimerWheel::Entry {
         private:
             TpTimerJob() = delete;
             TpTimerJob& operator=(const TpTimerJob& RHS) = delete;
@@ -38,24 +337,14 @@ namespace Plugin {
                 : m_tptimer(tpt)
             {
             }
-            TpTimerJob(const TpTimerJob& copy)
-                : m_tptimer(copy.m_tptimer)
-            {
-            }
             ~TpTimerJob() {}
 
-            inline bool operator==(const TpTimerJob& RHS) const
-            {
-                return (m_tptimer == RHS.m_tptimer);
-            }
-
         public:
-            uint64_t Timed(const uint64_t scheduledTime)
+            void Expired() override
             {
                 if (m_tptimer) {
                     m_tptimer->Timed();
                 }
-                return 0;
             }
 
         private:
@@ -64,7 +353,7 @@ namespace Plugin {
 
     public:
         TpTimer()
-            : baseTimer(64 * 1024, "ThunderPluginBaseTimer")
+            : baseTimer(TpTimerWheel::Instance())
             , m_timerJob(this)
             , m_isActive(false)
             , m_isSingleShot(false)
@@ -73,7 +362,8 @@ namespace Plugin {
         }
         ~TpTimer()
         {
-            stop();
+            m_isActive = false;
+            baseTimer.Revoke(m_timerJob, true);
             onTimeoutCallback = nullptr;
         }
 
@@ -83,14 +373,13 @@ namespace Plugin {
         }
         void stop()
         {
-            baseTimer.Revoke(m_timerJob);
+            baseTimer.Revoke(m_timerJob, false);
             m_isActive = false;
         }
         void start()
         {
-            baseTimer.Revoke(m_timerJob);
-            baseTimer.Schedule(Core::Time::Now().Add(m_intervalInMs), m_timerJob);
             m_isActive = true;
+            baseTimer.Schedule(m_timerJob, m_intervalInMs);
         }
         void start(int msec)
         {
@@ -127,9 +416,9 @@ namespace Plugin {
             }
         }
 
-        WPEFramework::Core::TimerType<TpTimerJob> baseTimer;
+        TpTimerWheel& baseTimer;
         TpTimerJob m_timerJob;
-        bool m_isActive;
+        std::atomic<bool> m_isActive;
         bool m_isSingleShot;
         int m_intervalInMs;
 